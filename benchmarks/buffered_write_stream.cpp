@@ -0,0 +1,98 @@
+// Compares writing responses to pipelined requests straight to a socket against writing them through buffered_write_stream.
+
+#include <httplib/asio/buffered_write_stream.hpp>
+#include <httplib/asio/write_response.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+
+constexpr std::size_t responses_count = 1000 * 1000;
+
+const httplib::http_response_t response{200, "OK", {1, 1}, {{"Content-Length", {"2"}}}};
+const std::string body = "OK";
+
+
+std::size_t response_size() {
+    std::ostringstream stream;
+    stream << response;
+    return stream.str().size() + body.size();
+}
+
+
+// Writes responses_count responses one after another, as a server answering a long pipeline would,
+// while another thread reads them, and reports how long it takes.
+template<class Stream>
+void measure(const char *name, boost::asio::io_service &io_service, Stream &stream, socket_t &reader) {
+    const std::size_t total = responses_count * response_size();
+
+    std::thread receiver([&reader, total] {
+        std::array<char, 64 * 1024> buffer;
+
+        for (std::size_t received = 0; received < total;) {
+            received += reader.read_some(boost::asio::buffer(buffer));
+        }
+    });
+
+    std::size_t written = 0;
+
+    std::function<void(boost::system::error_code, std::size_t)> write_next =
+        [&](boost::system::error_code ec, std::size_t) {
+            if (!ec && written++ < responses_count) {
+                httplib::async_write_response(stream, response, boost::asio::buffer(body), write_next);
+            }
+        };
+
+    auto start = std::chrono::steady_clock::now();
+
+    write_next(boost::system::error_code(), 0);
+    io_service.run();
+    receiver.join();
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+    std::cout << name << ": " << ms << " ms, "
+              << static_cast<double>(responses_count) / (static_cast<double>(ms) / 1000) << " responses/s" << std::endl;
+}
+
+} // namespace
+
+
+int main() {
+    {
+        boost::asio::io_service io_service;
+        socket_t writer(io_service);
+        socket_t reader(io_service);
+        boost::asio::local::connect_pair(writer, reader);
+
+        measure("socket", io_service, writer, reader);
+    }
+
+    {
+        boost::asio::io_service io_service;
+        socket_t writer(io_service);
+        socket_t reader(io_service);
+        boost::asio::local::connect_pair(writer, reader);
+
+        httplib::buffered_write_stream<socket_t &> stream(writer);
+        measure("buffered_write_stream", io_service, stream, reader);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+// Measures http_client_t against an in-process server_t: new connections per request, a keep-alive pool and pipelining.
+
+#include <httplib/asio/client.hpp>
+#include <httplib/asio/server.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+
+namespace {
+
+constexpr std::size_t requests_count = 20 * 1000;
+constexpr std::size_t concurrency = 64;
+
+
+// Keeps concurrency requests in progress until requests_count are done.
+class load_t {
+public:
+    load_t(httplib::http_client_t &client, boost::asio::ip::tcp::endpoint endpoint, bool keep_alive) :
+        m_client(client),
+        m_endpoint(endpoint),
+        m_keep_alive(keep_alive),
+        m_started(0),
+        m_failed(0)
+    { }
+
+    void start() {
+        for (std::size_t i = 0; i < concurrency; ++i) {
+            next();
+        }
+    }
+
+    std::size_t failed() const {
+        return m_failed;
+    }
+
+private:
+    void next() {
+        if (m_started == requests_count) {
+            return;
+        }
+
+        ++m_started;
+
+        httplib::http_request_t request;
+        request.method = "GET";
+        request.target = "/api/v1/objects/0123456789abcdef";
+        request.version = {1, 1};
+
+        if (!m_keep_alive) {
+            request.headers.set_header("Connection", {"close"});
+        }
+
+        m_client.async_request(m_endpoint, std::move(request), [this](auto ec, const auto &) {
+            if (ec) {
+                ++m_failed;
+            }
+
+            this->next();
+        });
+    }
+
+private:
+    httplib::http_client_t &m_client;
+    boost::asio::ip::tcp::endpoint m_endpoint;
+    bool m_keep_alive;
+    std::size_t m_started;
+    std::size_t m_failed;
+};
+
+
+void measure(const char *name,
+             const boost::asio::ip::tcp::endpoint &endpoint,
+             bool keep_alive,
+             httplib::http_client_options_t options)
+{
+    boost::asio::io_service io_service;
+    httplib::http_client_t client(io_service, options);
+    load_t load(client, endpoint, keep_alive);
+
+    auto start = std::chrono::steady_clock::now();
+
+    load.start();
+
+    while (client.metrics().responses + client.metrics().errors < requests_count) {
+        io_service.run_one();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    auto metrics = client.metrics();
+
+    std::cout << name << ": " << requests_count << " requests, "
+              << static_cast<double>(requests_count) * 1000 * 1000 / us << " requests per second, "
+              << metrics.connections_opened << " connections, "
+              << metrics.pipelined << " pipelined, "
+              << load.failed() << " failed" << std::endl;
+}
+
+} // namespace
+
+
+int main() {
+    httplib::server_options_t server_options;
+    server_options.threads = 2;
+
+    httplib::server_t server([](const httplib::http_request_t &, const std::string &, httplib::server_response_t &response) {
+        response.body = "{\"id\": \"0123456789abcdef\"}";
+    }, server_options);
+
+    server.start(boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+
+    httplib::http_client_options_t options;
+    options.max_connections_per_host = 8;
+
+    measure("connection per request", server.local_endpoint(), false, options);
+    measure("keep-alive pool", server.local_endpoint(), true, options);
+
+    options.max_pipelined_requests = 8;
+    measure("keep-alive pool with pipelining", server.local_endpoint(), true, options);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,145 @@
+// Counts heap allocations per async_read_some() through a reader made by make_unique_reader().
+
+#include <httplib/asio/abstract_reader.hpp>
+#include <httplib/asio/bound_body_reader.hpp>
+#include <httplib/asio/buffered_read_stream.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+
+
+namespace {
+
+std::atomic<std::size_t> allocations(0);
+
+} // namespace
+
+
+// GCC sees the malloc() inside this operator new and the free() inside operator delete
+// and takes them for a mismatched pair.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void *operator new(std::size_t size) {
+    ++allocations;
+
+    if (void *pointer = std::malloc(size)) {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+using stream_t = httplib::buffered_read_stream<socket_t &, boost::asio::streambuf &>;
+
+constexpr std::size_t body_size = 64 * 1024;
+constexpr std::size_t read_size = 256;
+
+
+class body_consumer_t {
+public:
+    body_consumer_t(httplib::abstract_reader_t &reader) :
+        m_reader(reader),
+        m_self(std::make_shared<int>(0)),
+        m_reads(0),
+        m_received(0)
+    { }
+
+    void start() {
+        // A typical handler: a lambda holding a shared_ptr and a pointer.
+        m_reader.async_read_some(boost::asio::buffer(m_buffer), [this, self = m_self](boost::system::error_code ec, std::size_t transferred) {
+            handle_read(ec, transferred);
+        });
+    }
+
+    std::size_t reads() const {
+        return m_reads;
+    }
+
+    std::size_t received() const {
+        return m_received;
+    }
+
+private:
+    void handle_read(boost::system::error_code ec, std::size_t transferred) {
+        ++m_reads;
+        m_received += transferred;
+
+        if (!ec) {
+            start();
+        }
+    }
+
+private:
+    httplib::abstract_reader_t &m_reader;
+    std::shared_ptr<int> m_self;
+    std::array<char, read_size> m_buffer;
+    std::size_t m_reads;
+    std::size_t m_received;
+};
+
+} // namespace
+
+
+int main() {
+    boost::asio::io_service io_service;
+    socket_t writer(io_service);
+    socket_t reader_socket(io_service);
+    boost::asio::local::connect_pair(writer, reader_socket);
+
+    const std::string body(body_size, 'x');
+    boost::asio::write(writer, boost::asio::buffer(body));
+
+    boost::asio::streambuf buffer;
+    stream_t stream(reader_socket, buffer);
+
+    auto reader = httplib::make_unique_reader<httplib::bound_body_reader<stream_t>>(stream, body_size);
+    body_consumer_t consumer(*reader);
+
+    std::size_t allocations_before = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    consumer.start();
+    io_service.run();
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    std::size_t allocations_count = allocations - allocations_before;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+
+    std::cout << "reads: " << consumer.reads() << ", bytes: " << consumer.received() << std::endl
+              << "allocations per async_read_some: "
+              << static_cast<double>(allocations_count) / consumer.reads() << std::endl
+              << "time per async_read_some: " << static_cast<double>(ns) / consumer.reads() << " ns" << std::endl;
+
+    return consumer.received() == body_size ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,194 @@
+// Counts heap allocations per request on a keep-alive connection with plain handlers and with bind_handler_memory().
+
+#include <httplib/asio/bound_body_reader.hpp>
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/handler_memory.hpp>
+#include <httplib/asio/read_request.hpp>
+#include <httplib/asio/ring_buffer.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/optional.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+
+namespace {
+
+std::atomic<std::size_t> allocations(0);
+
+} // namespace
+
+
+// GCC sees the malloc() inside this operator new and the free() inside operator delete
+// and takes them for a mismatched pair.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void *operator new(std::size_t size) {
+    ++allocations;
+
+    if (void *pointer = std::malloc(size)) {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+using stream_t = httplib::buffered_read_stream<socket_t &, httplib::ring_buffer_t &>;
+
+constexpr std::size_t requests_count = 100 * 1000;
+
+const std::string request = "PUT /upload HTTP/1.1\r\nHost: localhost\r\nContent-Length: 16\r\n\r\n0123456789abcdef";
+
+
+// Reads the requests and their bodies one after another, as a server does on a keep-alive connection.
+template<bool UseMemory>
+class connection_t {
+public:
+    explicit connection_t(socket_t &socket) :
+        m_stream(socket, m_buffer),
+        m_self(std::make_shared<int>(0)),
+        m_requests(0)
+    { }
+
+    void start() {
+        // A typical handler: a lambda holding a shared_ptr and a pointer.
+        httplib::async_read_request(m_stream, m_parser, {}, wrap([this, self = m_self](auto ec, const auto &) {
+            this->handle_request(ec);
+        }));
+    }
+
+    std::size_t requests() const {
+        return m_requests;
+    }
+
+private:
+    template<class Handler>
+    auto wrap(Handler handler) {
+        return wrap(std::integral_constant<bool, UseMemory>(), std::move(handler));
+    }
+
+    template<class Handler>
+    Handler wrap(std::false_type, Handler handler) {
+        return handler;
+    }
+
+    template<class Handler>
+    httplib::memory_bound_handler<Handler> wrap(std::true_type, Handler handler) {
+        return httplib::bind_handler_memory(m_memory, std::move(handler));
+    }
+
+    void handle_request(boost::system::error_code ec) {
+        if (ec) {
+            return;
+        }
+
+        m_body.emplace(m_stream, 16);
+        read_body();
+    }
+
+    void read_body() {
+        m_body->async_read_some(boost::asio::buffer(m_body_buffer), wrap([this, self = m_self](auto ec, std::size_t) {
+            this->handle_body(ec);
+        }));
+    }
+
+    void handle_body(boost::system::error_code ec) {
+        if (!ec) {
+            read_body();
+        } else if (++m_requests < requests_count) {
+            start();
+        }
+    }
+
+private:
+    httplib::ring_buffer_t m_buffer;
+    stream_t m_stream;
+    httplib::http_request_parser_t m_parser;
+    boost::optional<httplib::bound_body_reader<stream_t>> m_body;
+    std::array<char, 64> m_body_buffer;
+
+    httplib::handler_memory_t m_memory;
+    std::shared_ptr<int> m_self;
+    std::size_t m_requests;
+};
+
+
+template<bool UseMemory>
+void measure(const char *name) {
+    boost::asio::io_service io_service;
+    socket_t writer(io_service);
+    socket_t reader(io_service);
+    boost::asio::local::connect_pair(writer, reader);
+
+    std::thread sender([&writer] {
+        std::string batch;
+
+        for (std::size_t i = 0; i < 100; ++i) {
+            batch.append(request);
+        }
+
+        for (std::size_t sent = 0; sent < requests_count; sent += 100) {
+            boost::asio::write(writer, boost::asio::buffer(batch));
+        }
+    });
+
+    connection_t<UseMemory> connection(reader);
+
+    std::size_t allocations_before = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    connection.start();
+    io_service.run();
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    std::size_t allocations_count = allocations - allocations_before;
+
+    sender.join();
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+    std::cout << name << ": " << connection.requests() << " requests, "
+              << static_cast<double>(allocations_count) / connection.requests() << " allocations per request, "
+              << ms << " ms" << std::endl;
+}
+
+} // namespace
+
+
+int main() {
+    measure<false>("operator new");
+    measure<true>("handler_memory_t");
+
+    return EXIT_SUCCESS;
+}
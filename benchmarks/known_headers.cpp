@@ -0,0 +1,110 @@
+// Compares header lookups in the old std::map based container, in http_headers_t by name
+// and in http_headers_t by well-known header id.
+
+#include <httplib/http/headers.hpp>
+#include <httplib/http/known_headers.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+using map_headers_t = std::map<std::string, std::vector<std::string>, httplib::detail::ilexicographical_less_t>;
+
+const std::vector<std::pair<std::string, std::string>> typical_headers = {
+    {"Host", "example.com"},
+    {"User-Agent", "Mozilla/5.0 (X11; Linux x86_64; rv:60.0) Gecko/20100101 Firefox/60.0"},
+    {"Accept", "text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8"},
+    {"Accept-Language", "en-US,en;q=0.5"},
+    {"Accept-Encoding", "gzip, deflate, br"},
+    {"Referer", "https://example.com/"},
+    {"Cookie", "session=0123456789abcdef"},
+    {"Connection", "keep-alive"},
+    {"Upgrade-Insecure-Requests", "1"},
+    {"Cache-Control", "max-age=0"},
+    {"X-Request-Id", "4bf92f3577b34da6a3ce929d0e0e4736"}
+};
+
+// What the library itself looks up while processing every message.
+const std::vector<httplib::known_header_t> hot_headers = {
+    httplib::known_header_t::transfer_encoding,
+    httplib::known_header_t::content_length,
+    httplib::known_header_t::connection,
+    httplib::known_header_t::host
+};
+
+constexpr std::size_t iterations = 1000000;
+
+
+template<class F>
+void measure(const char *name, F &&f) {
+    std::size_t found = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        found += f();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+
+    std::cout << name << ": " << static_cast<double>(ns) / iterations << " ns per message"
+              << " (found " << found << ")" << std::endl;
+}
+
+} // namespace
+
+
+int main() {
+    map_headers_t map_headers;
+    httplib::http_headers_t headers;
+
+    for (const auto &header: typical_headers) {
+        map_headers[header.first].push_back(header.second);
+        headers.add_header_values(header.first, {header.second});
+    }
+
+    std::vector<std::string> hot_names;
+
+    for (auto id: hot_headers) {
+        hot_names.push_back(httplib::known_header_name(id).to_string());
+    }
+
+    measure("std::map by name", [&]() {
+        std::size_t found = 0;
+
+        for (const auto &name: hot_names) {
+            found += map_headers.count(name);
+        }
+
+        return found;
+    });
+
+    measure("http_headers_t by name", [&]() {
+        std::size_t found = 0;
+
+        for (const auto &name: hot_names) {
+            found += headers.has(name);
+        }
+
+        return found;
+    });
+
+    measure("http_headers_t by id", [&]() {
+        std::size_t found = 0;
+
+        for (auto id: hot_headers) {
+            found += headers.has(id);
+        }
+
+        return found;
+    });
+
+    return EXIT_SUCCESS;
+}
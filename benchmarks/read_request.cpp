@@ -0,0 +1,152 @@
+// Measures the cost of a read of async_read_request() when the head of a request arrives in many small segments.
+
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/read_request.hpp>
+#include <httplib/asio/ring_buffer.hpp>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_service.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+
+namespace {
+
+constexpr std::size_t requests_count = 200 * 1000;
+constexpr std::size_t segment_size = 48;
+
+const std::string request =
+    "GET /api/v1/objects/0123456789abcdef?with=properties&and=some&query=parameters HTTP/1.1\r\n"
+    "Host: www.example.com\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:60.0) Gecko/20100101 Firefox/60.0\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+    "Accept-Language: en-US,en;q=0.5\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Referer: https://www.example.com/some/page\r\n"
+    "Cookie: session=0123456789abcdef0123456789abcdef; theme=dark; lang=en\r\n"
+    "Connection: keep-alive\r\n"
+    "Cache-Control: max-age=0\r\n"
+    "\r\n";
+
+
+// Returns the same request over and over, at most segment_size bytes per read,
+// completing every read through the io_service like a socket does.
+class segmented_stream_t {
+public:
+    explicit segmented_stream_t(boost::asio::io_service &io_service) :
+        m_io_service(io_service),
+        m_position(0),
+        m_reads(0)
+    { }
+
+    boost::asio::io_service &get_io_service() {
+        return m_io_service;
+    }
+
+    std::size_t reads() const {
+        return m_reads;
+    }
+
+    template<class MutableBufferSequence, class Handler>
+    void async_read_some(const MutableBufferSequence &buffers, Handler &&handler) {
+        std::size_t transferred = read(buffers);
+
+        m_io_service.post([handler = std::forward<Handler>(handler), transferred]() mutable {
+            handler(boost::system::error_code(), transferred);
+        });
+    }
+
+private:
+    template<class MutableBufferSequence>
+    std::size_t read(const MutableBufferSequence &buffers) {
+        ++m_reads;
+
+        std::size_t size = boost::asio::buffer_copy(
+            buffers,
+            boost::asio::buffer(request.data() + m_position, std::min(segment_size, request.size() - m_position))
+        );
+
+        m_position = (m_position + size) % request.size();
+
+        return size;
+    }
+
+private:
+    boost::asio::io_service &m_io_service;
+    std::size_t m_position;
+    std::size_t m_reads;
+};
+
+
+using stream_t = httplib::buffered_read_stream<segmented_stream_t &, httplib::ring_buffer_t &>;
+
+
+// Reads the requests one after another with a parser owned by the operation or with the caller's one.
+template<bool ReuseParser>
+class reader_t {
+public:
+    explicit reader_t(stream_t &stream) :
+        m_stream(stream),
+        m_requests(0)
+    { }
+
+    void start() {
+        auto handler = [this](auto ec, const auto &) {
+            if (!ec && ++m_requests < requests_count) {
+                this->start();
+            }
+        };
+
+        if (ReuseParser) {
+            httplib::async_read_request(m_stream, m_parser, {}, handler);
+        } else {
+            httplib::async_read_request(m_stream, {}, handler);
+        }
+    }
+
+    std::size_t requests() const {
+        return m_requests;
+    }
+
+private:
+    stream_t &m_stream;
+    httplib::http_request_parser_t m_parser;
+    std::size_t m_requests;
+};
+
+
+template<bool ReuseParser>
+void measure(const char *name) {
+    boost::asio::io_service io_service;
+    segmented_stream_t socket(io_service);
+    httplib::ring_buffer_t buffer;
+    stream_t stream(socket, buffer);
+    reader_t<ReuseParser> reader(stream);
+
+    auto start = std::chrono::steady_clock::now();
+
+    reader.start();
+    io_service.run();
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+
+    std::cout << name << ": " << reader.requests() << " requests of " << request.size() << " bytes, "
+              << static_cast<double>(socket.reads()) / reader.requests() << " reads per request, "
+              << static_cast<double>(ns) / socket.reads() << " ns per read, "
+              << static_cast<double>(ns) / reader.requests() << " ns per request" << std::endl;
+}
+
+} // namespace
+
+
+int main() {
+    measure<false>("own parser");
+    measure<true>("caller's parser");
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,71 @@
+// Compares formatting a response head through std::ostream with serialize_head().
+
+#include <httplib/http/serialize.hpp>
+
+#include <boost/lexical_cast.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+
+namespace {
+
+constexpr std::size_t iterations = 1000000;
+
+
+template<class F>
+void measure(const char *name, F &&f) {
+    std::size_t total_size = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        total_size += f();
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+
+    std::cout << name << ": " << static_cast<double>(ns) / iterations << " ns per head"
+              << " (" << total_size << " bytes)" << std::endl;
+}
+
+} // namespace
+
+
+int main() {
+    const httplib::http_response_t response {
+        200,
+        "OK",
+        {1, 1},
+        {
+            {"Date", {"Sun, 06 Nov 1994 08:49:37 GMT"}},
+            {"Server", {"httplib"}},
+            {"Content-Type", {"text/plain; charset=utf-8"}},
+            {"Content-Length", {"1024"}},
+            {"Connection", {"keep-alive"}}
+        }
+    };
+
+    measure("lexical_cast", [&]() {
+        return boost::lexical_cast<std::string>(response).size();
+    });
+
+    measure("serialize_head into a new string", [&]() {
+        std::string output;
+        httplib::serialize_head(response, output);
+        return output.size();
+    });
+
+    std::string buffer;
+
+    measure("serialize_head into a reused string", [&]() {
+        buffer.clear();
+        httplib::serialize_head(response, buffer);
+        return buffer.size();
+    });
+
+    return EXIT_SUCCESS;
+}
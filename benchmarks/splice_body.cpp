@@ -0,0 +1,107 @@
+// Compares moving a request body from a socket into a descriptor with body_reader and write() against splice_body().
+
+#include <httplib/asio/body_reader.hpp>
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/read_request.hpp>
+#include <httplib/asio/splice_body.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+using stream_t = httplib::buffered_read_stream<socket_t &, boost::asio::streambuf &>;
+
+constexpr std::size_t body_size = 1024 * 1024 * 1024;
+constexpr std::size_t write_size = 1024 * 1024;
+
+
+// Sends a request with body_size bytes of body from another thread and measures how long f takes to consume it.
+template<class F>
+void measure(const char *name, F &&f) {
+    boost::asio::io_service io_service;
+    socket_t writer(io_service);
+    socket_t reader(io_service);
+    boost::asio::local::connect_pair(writer, reader);
+
+    std::thread sender([&writer] {
+        const std::string head = "PUT /upload HTTP/1.1\r\nContent-Length: " + std::to_string(body_size) + "\r\n\r\n";
+        const std::string part(write_size, 'x');
+
+        boost::asio::write(writer, boost::asio::buffer(head));
+
+        for (std::size_t sent = 0; sent < body_size; sent += write_size) {
+            boost::asio::write(writer, boost::asio::buffer(part));
+        }
+    });
+
+    boost::asio::streambuf buffer;
+    stream_t stream(reader, buffer);
+
+    int null_fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+
+    auto start = std::chrono::steady_clock::now();
+
+    auto request = httplib::read_request(stream);
+    std::size_t transferred = f(request, stream, null_fd);
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    sender.join();
+    ::close(null_fd);
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+    std::cout << name << ": " << ms << " ms, "
+              << static_cast<double>(transferred) / 1024 / 1024 / (static_cast<double>(ms) / 1000) << " MiB/s"
+              << (transferred == body_size ? "" : " (incomplete body)") << std::endl;
+}
+
+} // namespace
+
+
+int main() {
+    measure("body_reader + write", [](const httplib::http_request_t &request, stream_t &stream, int fd) {
+        auto reader = httplib::make_body_reader(request, stream);
+        std::array<char, 64 * 1024> buffer;
+        std::size_t total = 0;
+
+        while (true) {
+            boost::system::error_code ec;
+            std::size_t transferred = reader->read_some(boost::asio::buffer(buffer), ec);
+
+            if (::write(fd, buffer.data(), transferred) != static_cast<ssize_t>(transferred)) {
+                break;
+            }
+
+            total += transferred;
+
+            if (ec) {
+                break;
+            }
+        }
+
+        return total;
+    });
+
+    measure("splice_body", [](const httplib::http_request_t &request, stream_t &stream, int fd) {
+        return static_cast<std::size_t>(httplib::splice_body(request, stream, fd));
+    });
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,151 @@
+// The server from server.cpp written with coroutines: one detached_task_t per connection
+// holds the socket, the buffer and the parser, and serves its requests one after another.
+
+#include <httplib/asio/body_reader.hpp>
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/read_request.hpp>
+#include <httplib/asio/ring_buffer.hpp>
+#include <httplib/asio/use_awaitable.hpp>
+#include <httplib/asio/write_response.hpp>
+
+#include <httplib/response_builder.hpp>
+
+#include <boost/asio/ip/tcp.hpp>
+
+#include <array>
+#include <iostream>
+#include <string>
+
+
+namespace {
+
+using socket_t = boost::asio::ip::tcp::socket;
+using stream_t = httplib::buffered_read_stream<socket_t &, httplib::ring_buffer_t &>;
+
+
+httplib::detached_task_t serve(socket_t socket) {
+    httplib::ring_buffer_t buffer;
+    stream_t stream(socket, buffer);
+
+    // Reused for every request of the connection.
+    httplib::http_request_parser_t parser;
+
+    std::array<char, 1024> body;
+
+    while (true) {
+        auto [ec, request] = co_await httplib::async_read_request(stream, parser, {}, httplib::use_awaitable);
+
+        if (ec) {
+            std::cerr << "Failed to read request: " << ec.message() << std::endl;
+            break;
+        }
+
+        std::cerr << "Received a request:" << std::endl
+                  << request << std::endl;
+
+        httplib::http_response_t response;
+        bool keep_alive = false;
+
+        auto builder = httplib::prepare_response(request);
+        auto reader = httplib::make_body_reader(request, stream);
+
+        if (!builder) {
+            response = httplib::http_response_builder_t()
+                .content_length(0)
+                .connection_close()
+                .build(httplib::response_status_from_error(builder.error()));
+        } else if (!reader) {
+            response = builder->content_length(0)
+                .connection_close()
+                .build(httplib::response_status_from_error(reader.error()));
+        } else {
+            std::size_t body_size = 0;
+
+            while (true) {
+                auto [ec, transferred] = co_await reader->async_read_some(boost::asio::buffer(body), httplib::use_awaitable);
+                body_size += transferred;
+
+                if (ec) {
+                    keep_alive = ec == httplib::reader_errc_t::eof &&
+                                 builder->connection_status() != httplib::connection_status_t::close;
+                    break;
+                }
+            }
+
+            std::cerr << "Received a body of " << body_size << " bytes" << std::endl;
+
+            if (!keep_alive) {
+                builder->connection_close();
+            }
+
+            response = builder->content_length(0).build(httplib::STATUS_200_OK);
+        }
+
+        auto [write_ec, written] = co_await httplib::async_write_response(socket, response, httplib::use_awaitable);
+
+        if (write_ec) {
+            std::cerr << "Failed to reply: " << write_ec.message() << std::endl;
+            break;
+        }
+
+        if (!keep_alive) {
+            break;
+        }
+    }
+}
+
+
+class server_t {
+public:
+    server_t() :
+        m_acceptor(m_io_service),
+        m_accepting(m_io_service)
+    { }
+
+    void run() {
+        boost::asio::ip::tcp::endpoint endpoint(
+            boost::asio::ip::address::from_string("127.0.0.1"),
+            12345
+        );
+
+        m_acceptor.open(endpoint.protocol());
+        m_acceptor.bind(endpoint);
+        m_acceptor.listen();
+
+        start_accept();
+
+        m_io_service.run();
+    }
+
+private:
+    void start_accept() {
+        m_acceptor.async_accept(m_accepting, [this](auto ec) {
+            this->handle_accept(ec);
+        });
+    }
+
+    void handle_accept(boost::system::error_code ec) {
+        if (ec) {
+            std::cerr << "Failed to accept: " << ec.message() << std::endl;
+        } else {
+            serve(std::move(m_accepting));
+            m_accepting = socket_t(m_io_service);
+        }
+
+        start_accept();
+    }
+
+private:
+    boost::asio::io_service m_io_service;
+    boost::asio::ip::tcp::acceptor m_acceptor;
+    socket_t m_accepting;
+};
+
+} // namespace
+
+
+int main() {
+    server_t server;
+    server.run();
+    return 0;
+}
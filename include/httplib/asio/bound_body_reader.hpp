@@ -2,6 +2,7 @@
 
 #include <httplib/detail/common.hpp>
 #include <httplib/http/misc.hpp>
+#include <httplib/asio/erased_buffers.hpp>
 #include <httplib/asio/read_options.hpp>
 
 #include <boost/asio/async_result.hpp>
@@ -13,6 +14,9 @@
 HTTPLIB_OPEN_NAMESPACE
 
 
+// Reads a body of a known size.
+// When the stream's buffer is empty and the caller's buffers are at least read_buffer_size bytes,
+// it reads from the stream right into them, but never past the end of the body.
 template<class BufferedReadStream>
 class bound_body_reader {
 public:
@@ -35,12 +39,19 @@ public:
     std::size_t read_some(MutableBuffers buffers);
 
 private:
+    template<class MutableBuffers>
+    erased_mutable_buffers_t direct_read_buffers(const MutableBuffers &buffers) const;
+
+    // Stops the body timeout once the whole body is read or the reading fails.
+    void finish_timeouts(boost::system::error_code ec = boost::system::error_code());
+
     template<class Buffers, class Handler>
     struct async_read_some_op;
 
 private:
     BufferedReadStream *m_stream;
     read_options_t m_options;
+    read_size_t m_read_size;
     content_length_int_t m_to_read;
     content_length_int_t m_total_read;
 };
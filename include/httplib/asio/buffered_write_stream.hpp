@@ -0,0 +1,155 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/asio/erased_handler.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/optional.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+namespace detail {
+
+// The part of buffered_write_stream which a background flush may outlive.
+template<class Stream>
+struct buffered_write_state_t {
+    // Reset when buffered_write_stream is destroyed.
+    Stream *stream;
+    std::size_t flush_threshold;
+
+    // Accumulates the writes.
+    std::string buffer;
+    // The data being written by a background flush.
+    std::string sending;
+    bool writing = false;
+
+    // Counts the asynchronous operations started, to tell if a handler has started another one.
+    std::size_t operations = 0;
+
+    // An error of a background flush. It's reported by the next operation.
+    boost::system::error_code error;
+
+    // An operation waiting for the background flush to complete.
+    boost::optional<erased_handler<void(boost::system::error_code)>> waiter;
+
+    buffered_write_state_t(Stream *stream, std::size_t flush_threshold) :
+        stream(stream),
+        flush_threshold(flush_threshold)
+    { }
+};
+
+} // namespace detail
+
+
+// A write stream which collects small writes, e.g. responses to pipelined requests or small chunks
+// of chunked_body_writer, and sends them with one gathering write.
+// A write is copied into the buffer and completes right away if the buffer stays below flush_threshold.
+// Otherwise the buffer and the caller's buffers are sent together without copying.
+// The buffered data is also sent by flush() and by a background flush at the end of the handler
+// of an asynchronous operation, if the handler doesn't start another one.
+// So a chain of small writes, e.g. responses to a batch of pipelined requests, is sent at once,
+// and there's no need to flush after the last one.
+// An error of a background flush is reported by the next write or flush.
+// Reads are passed to the stream as is, so it can be wrapped into buffered_read_stream as well.
+// The stream must outlive the buffered_write_stream, i.e. a socket must be declared before it.
+// Don't mix synchronous and asynchronous writes.
+template<class WriteStream>
+class buffered_write_stream {
+    using stream_type = std::remove_reference_t<WriteStream>;
+
+public:
+    static constexpr std::size_t default_flush_threshold = 16 * 1024;
+
+public:
+    template<class StreamInit>
+    explicit buffered_write_stream(StreamInit &&stream, std::size_t flush_threshold = default_flush_threshold);
+
+    ~buffered_write_stream();
+
+    // The background flush refers to the object.
+    buffered_write_stream(const buffered_write_stream &) = delete;
+    buffered_write_stream &operator=(const buffered_write_stream &) = delete;
+
+    stream_type &stream() {
+        return m_stream;
+    }
+
+    const stream_type &stream() const {
+        return m_stream;
+    }
+
+    boost::asio::io_service &get_io_service();
+
+    // The number of bytes written to the buffer and not yet passed to the stream.
+    std::size_t buffered_size() const;
+
+    // The handlers of async_read_some() and async_write_some() are taken by reference, as asio streams do:
+    // a composed operation passes itself as the handler along with buffers pointing into itself.
+    template<class MutableBuffers, class Handler>
+    typename boost::asio::async_result<
+        typename boost::asio::handler_type<std::decay_t<Handler>, void(boost::system::error_code, std::size_t)>::type
+    >::type
+    async_read_some(const MutableBuffers &buffers, Handler &&handler);
+
+    template<class MutableBuffers>
+    std::size_t read_some(const MutableBuffers &buffers, boost::system::error_code &ec);
+
+    template<class MutableBuffers>
+    std::size_t read_some(const MutableBuffers &buffers);
+
+    // Always takes all the buffers.
+    template<class ConstBuffers, class Handler>
+    typename boost::asio::async_result<
+        typename boost::asio::handler_type<std::decay_t<Handler>, void(boost::system::error_code, std::size_t)>::type
+    >::type
+    async_write_some(const ConstBuffers &buffers, Handler &&handler);
+
+    template<class ConstBuffers>
+    std::size_t write_some(const ConstBuffers &buffers, boost::system::error_code &ec);
+
+    template<class ConstBuffers>
+    std::size_t write_some(const ConstBuffers &buffers);
+
+    template<class Handler>
+    typename boost::asio::async_result<
+        typename boost::asio::handler_type<Handler, void(boost::system::error_code)>::type
+    >::type
+    async_flush(Handler handler);
+
+    void flush(boost::system::error_code &ec);
+
+    void flush();
+
+private:
+    using state_t = detail::buffered_write_state_t<stream_type>;
+
+    template<class ConstBuffers>
+    bool fits(const ConstBuffers &buffers) const;
+
+    template<class ConstBuffers>
+    void append(const ConstBuffers &buffers);
+
+    static void start_background_flush(const std::shared_ptr<state_t> &state);
+
+    struct background_flush_op;
+
+    template<class ConstBuffers, class Handler>
+    struct async_write_op;
+
+private:
+    WriteStream m_stream;
+    std::shared_ptr<state_t> m_state;
+};
+
+
+HTTPLIB_CLOSE_NAMESPACE
+
+#include <httplib/asio/impl/buffered_write_stream.hpp>
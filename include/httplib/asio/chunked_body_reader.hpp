@@ -5,6 +5,7 @@
 #include <httplib/parser/chunked_body_parser.hpp>
 
 #include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
 #include <boost/asio/io_service.hpp>
 
 #include <cstdlib>
@@ -35,7 +36,27 @@ public:
     template<class MutableBuffers>
     std::size_t read_some(MutableBuffers buffers);
 
+    // These functions return the next part of the decoded body without copying it.
+    // The buffer points into the stream's buffer and stays valid until the part is consumed with consume().
+    // Until then, they return the rest of the same part again.
+    template<class Handler>
+    typename boost::asio::async_result<
+        typename boost::asio::handler_type<Handler, void(boost::system::error_code, boost::asio::const_buffer)>::type
+    >::type
+    async_read_some_view(Handler handler);
+
+    boost::asio::const_buffer read_some_view(boost::system::error_code &ec);
+
+    boost::asio::const_buffer read_some_view();
+
+    // Mark the first size bytes of the part returned by read_some_view() as processed.
+    void consume(std::size_t size);
+
 private:
+    struct view_tag_t { };
+
+    bool read_data(boost::system::error_code &ec);
+
     void consume_read_buffer();
 
     template<class Buffers, class Handler>
@@ -44,6 +65,7 @@ private:
 private:
     BufferedReadStream *m_stream;
     read_options_t m_options;
+    read_size_t m_read_size;
     chunked_body_parser_t m_parser;
     boost::system::error_code m_error;
     const char *m_unconsumed_body;
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/headers.hpp>
+#include <httplib/http/serialize.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/container/small_vector.hpp>
+
+#include <cstdlib>
+#include <string>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+// Writes a body with the chunked transfer coding.
+// Every write is sent as a single gathering write of the chunk size line, the caller's buffers and the CRLF,
+// so the payload isn't copied.
+// Writes smaller than coalesce_threshold are copied into the writer instead, and the collected data is sent
+// as one chunk when it reaches the threshold, on flush() or on finish(). The default threshold of 0 disables it.
+// Only one operation may be in progress at a time. The caller's buffers must stay alive until it completes.
+// The handlers are called with the number of payload bytes taken by the operation.
+template<class AsyncWriteStream>
+class chunked_body_writer {
+public:
+    explicit chunked_body_writer(AsyncWriteStream &stream, std::size_t coalesce_threshold = 0);
+
+    chunked_body_writer(const chunked_body_writer &) = delete;
+    chunked_body_writer &operator=(const chunked_body_writer &) = delete;
+
+    boost::asio::io_service &get_io_service();
+
+    template<class ConstBuffers, class Handler>
+    typename boost::asio::async_result<
+        typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type
+    >::type
+    async_write(ConstBuffers buffers, Handler handler);
+
+    // Send the data collected from small writes.
+    template<class Handler>
+    typename boost::asio::async_result<
+        typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type
+    >::type
+    async_flush(Handler handler);
+
+    // Send the collected data, the last chunk and the trailer headers. The body is complete after that.
+    template<class Handler>
+    typename boost::asio::async_result<
+        typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type
+    >::type
+    async_finish(const http_headers_t &trailers, Handler handler);
+
+    template<class Handler>
+    typename boost::asio::async_result<
+        typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type
+    >::type
+    async_finish(Handler handler);
+
+    template<class ConstBuffers>
+    std::size_t write(ConstBuffers buffers, boost::system::error_code &ec);
+
+    template<class ConstBuffers>
+    std::size_t write(ConstBuffers buffers);
+
+    std::size_t flush(boost::system::error_code &ec);
+
+    std::size_t flush();
+
+    std::size_t finish(const http_headers_t &trailers, boost::system::error_code &ec);
+
+    std::size_t finish(const http_headers_t &trailers = {});
+
+private:
+    using buffers_t = boost::container::small_vector<boost::asio::const_buffer, 8>;
+
+    template<class ConstBuffers>
+    bool prepare_write(const ConstBuffers &buffers, buffers_t &output);
+
+    bool prepare_flush(buffers_t &output);
+
+    void prepare_finish(const http_headers_t &trailers, buffers_t &output);
+
+    void add_pending(buffers_t &output);
+
+    void complete_write();
+
+    template<class Handler>
+    struct async_write_op;
+
+private:
+    AsyncWriteStream *m_stream;
+    std::size_t m_coalesce_threshold;
+
+    // Data of small writes. Sent as a single chunk.
+    std::string m_pending;
+    bool m_pending_sent;
+
+    char m_pending_size_line[max_chunk_size_line_size];
+    char m_size_line[max_chunk_size_line_size];
+    std::string m_last_chunk;
+};
+
+
+HTTPLIB_CLOSE_NAMESPACE
+
+#include <httplib/asio/impl/chunked_body_writer.hpp>
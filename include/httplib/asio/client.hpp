@@ -0,0 +1,155 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/request.hpp>
+#include <httplib/http/response.hpp>
+#include <httplib/asio/read_options.hpp>
+#include <httplib/asio/timer_wheel.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+struct http_client_options_t {
+    // The connections to one host are never more than this. The requests which don't fit wait in the queue of the host.
+    std::size_t max_connections_per_host = 8;
+
+    // How many requests may be sent on a connection before their responses arrive. More than 1 enables pipelining:
+    // when a host has no idle connection and can't open another one, an idempotent request is sent
+    // on the least loaded connection which has already answered with keep-alive and has only idempotent requests in flight.
+    std::size_t max_pipelined_requests = 1;
+
+    // An idle connection is closed after idle_timeout.
+    // A connection with requests in flight is closed when no response completes for response_timeout,
+    // and its requests fail with boost::asio::error::timed_out. Connecting counts too.
+    // Zero disables a timeout. The timeouts are kept in a timer_wheel_t ticking every timeout_resolution.
+    std::chrono::milliseconds idle_timeout{30 * 1000};
+    std::chrono::milliseconds response_timeout{30 * 1000};
+    std::chrono::milliseconds timeout_resolution{100};
+
+    // A response with a bigger body fails with client_errc_t::body_too_large.
+    std::size_t max_body_size = 16 * 1024 * 1024;
+
+    // The timeouts field is ignored.
+    read_options_t read_options;
+};
+
+
+struct http_client_response_t {
+    http_response_t response;
+    std::string body;
+};
+
+
+// Counters since the pool of the host was created, and the current state of the pool.
+struct http_client_metrics_t {
+    std::size_t connections_opened = 0;
+    std::size_t connections_closed = 0;
+
+    // Requests passed to async_request(), and how many of them completed with a response or with an error.
+    std::size_t requests = 0;
+    std::size_t responses = 0;
+    std::size_t errors = 0;
+
+    // Requests sent on a connection which had carried another request before.
+    std::size_t reused = 0;
+
+    // Requests sent on a connection with other requests still in flight.
+    std::size_t pipelined = 0;
+
+    // Requests sent once more after their connection was closed before answering them.
+    std::size_t retried = 0;
+
+    // Connections with requests in flight or being connected, idle connections and requests waiting for a connection.
+    std::size_t active_connections = 0;
+    std::size_t idle_connections = 0;
+    std::size_t queued_requests = 0;
+
+    http_client_metrics_t &operator+=(const http_client_metrics_t &other);
+};
+
+
+namespace detail {
+
+class client_request_t;
+class client_pool_t;
+
+} // namespace detail
+
+
+// An HTTP/1.1 client with a pool of keep-alive connections per host.
+// A connection is returned to the pool after a response unless the request or the response
+// asked to close it (see connection_status()) or the body of the response ended with the connection.
+// Requests to a host wait in a queue while all its connections are busy and max_connections_per_host are open.
+// An idempotent request whose reused connection is closed before it's answered, e.g. by the keep-alive timeout
+// of the server, and the requests pipelined after a response closing the connection, are sent again once.
+// Not thread-safe: use it in the thread running the io_service.
+class http_client_t {
+public:
+    explicit http_client_t(boost::asio::io_service &io_service, http_client_options_t options = {});
+
+    http_client_t(const http_client_t &) = delete;
+    http_client_t &operator=(const http_client_t &) = delete;
+
+    // Calls close().
+    ~http_client_t();
+
+    boost::asio::io_service &get_io_service() {
+        return m_io_service;
+    }
+
+    // Sends the request with the body to the host at the endpoint and reads the whole response.
+    // Host is set to the endpoint if the request has none, and Content-Length is set
+    // if the request has neither it nor Transfer-Encoding and has a body or is a POST or a PUT.
+    // The response is moved into the handler, so the handler may take it by value or by rvalue reference
+    // without copying.
+    template<class Handler>
+    typename boost::asio::async_result<
+        typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_client_response_t&)>::type
+    >::type
+    async_request(const boost::asio::ip::tcp::endpoint &endpoint,
+                  http_request_t request,
+                  std::string body,
+                  Handler handler);
+
+    template<class Handler>
+    typename boost::asio::async_result<
+        typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_client_response_t&)>::type
+    >::type
+    async_request(const boost::asio::ip::tcp::endpoint &endpoint, http_request_t request, Handler handler);
+
+    // Closes all the connections. The requests in progress complete with boost::asio::error::operation_aborted.
+    // The client may be used again afterwards, with new pools.
+    void close();
+
+    // The metrics of all the hosts and of one host.
+    http_client_metrics_t metrics() const;
+    http_client_metrics_t metrics(const boost::asio::ip::tcp::endpoint &endpoint) const;
+
+private:
+    void start_request(const boost::asio::ip::tcp::endpoint &endpoint, std::shared_ptr<detail::client_request_t> request);
+
+private:
+    boost::asio::io_service &m_io_service;
+    http_client_options_t m_options;
+
+    // Shared with the pools, so the connections closing after the client is destroyed can still cancel their timers.
+    std::shared_ptr<timer_wheel_t> m_timer_wheel;
+
+    std::map<boost::asio::ip::tcp::endpoint, std::shared_ptr<detail::client_pool_t>> m_pools;
+};
+
+
+HTTPLIB_CLOSE_NAMESPACE
+
+#include <httplib/asio/impl/client.hpp>
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/asio/timer_wheel.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+// Zero disables a timeout.
+struct connection_timeout_options_t {
+    // How long a connection may wait for the first byte of the next message.
+    std::chrono::milliseconds idle{0};
+
+    // How long the head of a message may take from its first byte, however the bytes trickle in.
+    std::chrono::milliseconds head{0};
+
+    // A body must arrive at min_body_rate bytes per second: every body_rate_interval
+    // at least min_body_rate * body_rate_interval bytes must be read, or the body times out.
+    // The time the application doesn't read the body counts too.
+    std::size_t min_body_rate = 0;
+    std::chrono::milliseconds body_rate_interval{10 * 1000};
+};
+
+
+// The timeouts of a connection, armed by the read operations it's passed to in read_options_t::timeouts:
+// the idle timeout while async_read_request() waits for a request, the head timeout from the first byte of the head,
+// and the body timeout while bound_body_reader or chunked_body_reader reads the body.
+// On expiry it calls on_expiry, which usually closes the socket, and the pending operation
+// completes with boost::asio::error::timed_out.
+// Only one message of the connection may be read at a time.
+class connection_timeouts_t {
+public:
+    connection_timeouts_t(timer_wheel_t &wheel, connection_timeout_options_t options, std::function<void()> on_expiry) :
+        m_wheel(wheel),
+        m_options(options),
+        m_timer([this] { this->expire(); }),
+        m_on_expiry(std::move(on_expiry)),
+        m_phase(phase_t::none),
+        m_body_read(0),
+        m_expired(false)
+    { }
+
+    connection_timeouts_t(const connection_timeouts_t &) = delete;
+    connection_timeouts_t &operator=(const connection_timeouts_t &) = delete;
+
+    const connection_timeout_options_t &options() const {
+        return m_options;
+    }
+
+    void set_options(connection_timeout_options_t options) {
+        m_options = options;
+    }
+
+    // Whether the timeouts have expired since a message was started.
+    bool expired() const {
+        return m_expired;
+    }
+
+    // The error the operation interrupted by the expiry reports.
+    boost::system::error_code error(boost::system::error_code ec) const {
+        if (ec && m_expired) {
+            return make_error_code(boost::asio::error::timed_out);
+        }
+
+        return ec;
+    }
+
+    // Called by the read operations.
+
+    // Waiting for the next message.
+    void wait_message() {
+        m_expired = false;
+        m_phase = phase_t::idle;
+        arm(m_options.idle);
+    }
+
+    // Reading the head of a message. The timeout starts at the first call.
+    void read_head() {
+        if (m_phase != phase_t::head) {
+            m_expired = false;
+            m_phase = phase_t::head;
+            arm(m_options.head);
+        }
+    }
+
+    // Reading the body of a message, transferred bytes read since the last call.
+    void read_body(std::size_t transferred) {
+        if (m_phase != phase_t::body) {
+            m_expired = false;
+            m_phase = phase_t::body;
+            m_body_read = 0;
+            arm_body();
+        } else if (m_options.min_body_rate > 0) {
+            m_body_read += transferred;
+
+            if (m_body_read >= body_quota()) {
+                m_body_read = 0;
+                arm_body();
+            }
+        }
+    }
+
+    // The message is read.
+    void finish() {
+        m_phase = phase_t::none;
+        m_timer.cancel();
+    }
+
+private:
+    enum class phase_t {
+        none,
+        idle,
+        head,
+        body
+    };
+
+    void arm(std::chrono::milliseconds timeout) {
+        if (timeout.count() > 0) {
+            m_wheel.arm(m_timer, timeout);
+        } else {
+            m_timer.cancel();
+        }
+    }
+
+    void arm_body() {
+        if (m_options.min_body_rate > 0) {
+            arm(m_options.body_rate_interval);
+        } else {
+            m_timer.cancel();
+        }
+    }
+
+    std::size_t body_quota() const {
+        auto quota = m_options.min_body_rate * static_cast<std::size_t>(m_options.body_rate_interval.count()) / 1000;
+        return std::max<std::size_t>(quota, 1);
+    }
+
+    void expire() {
+        m_expired = true;
+        m_phase = phase_t::none;
+        m_on_expiry();
+    }
+
+private:
+    timer_wheel_t &m_wheel;
+    connection_timeout_options_t m_options;
+    timer_wheel_t::timer_t m_timer;
+    std::function<void()> m_on_expiry;
+
+    phase_t m_phase;
+
+    // The bytes of the body read since the body timeout was armed.
+    std::size_t m_body_read;
+
+    bool m_expired;
+};
+
+
+HTTPLIB_CLOSE_NAMESPACE
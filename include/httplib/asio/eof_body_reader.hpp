@@ -13,6 +13,9 @@
 HTTPLIB_OPEN_NAMESPACE
 
 
+// Reads a body until the end of the stream.
+// When the stream's buffer is empty and the caller's buffers are at least read_buffer_size bytes,
+// it reads from the stream right into them.
 template<class BufferedReadStream>
 class eof_body_reader {
 public:
@@ -41,6 +44,7 @@ private:
 private:
     BufferedReadStream *m_stream;
     read_options_t m_options;
+    read_size_t m_read_size;
 };
 
 
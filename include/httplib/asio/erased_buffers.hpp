@@ -5,6 +5,9 @@
 #include <boost/asio/buffer.hpp>
 #include <boost/container/small_vector.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+
 
 HTTPLIB_OPEN_NAMESPACE
 
@@ -76,6 +79,23 @@ public:
         }
     }
 
+    // Only the first max_size bytes of the buffers.
+    template<class MutableBuffers>
+    erased_mutable_buffers_t(const MutableBuffers &buffers, std::size_t max_size) {
+        for (auto it = buffers.begin(); it != buffers.end() && max_size > 0; ++it) {
+            // The element may be a detail::mutable_buffer_t, which buffer_size() would take for a buffer sequence.
+            boost::asio::mutable_buffer buffer(*it);
+            std::size_t size = std::min(boost::asio::buffer_size(buffer), max_size);
+
+            m_buffers.emplace_back(detail::mutable_buffer_t{
+                boost::asio::buffer_cast<void *>(buffer),
+                size
+            });
+
+            max_size -= size;
+        }
+    }
+
     const_iterator begin() const {
         return m_buffers.begin();
     }
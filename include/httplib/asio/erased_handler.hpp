@@ -6,7 +6,11 @@
 #include <boost/asio/handler_continuation_hook.hpp>
 #include <boost/asio/handler_invoke_hook.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 
@@ -14,57 +18,238 @@ HTTPLIB_OPEN_NAMESPACE
 
 namespace detail {
 
-template<class R, class... Args>
-class erased_handler_base {
+// A function object passed to asio_handler_invoke() with its type erased.
+// It refers to the original function object, which is enough when the hook calls it right away.
+// If the hook keeps it for later (e.g. a strand posts it), the copy takes a copy of the original.
+class erased_function_t {
 public:
-    virtual ~erased_handler_base() { }
+    // Not for erased_function_t itself, so a non-constant one is copied rather than referred to.
+    template<
+        class Callable,
+        class = std::enable_if_t<!std::is_same<std::remove_const_t<Callable>, erased_function_t>::value>
+    >
+    explicit erased_function_t(Callable &callable) :
+        m_callable(const_cast<void *>(static_cast<const void *>(&callable))),
+        m_call(&call<Callable>),
+        m_clone(&clone<Callable>),
+        m_destroy(&destroy<Callable>),
+        m_owning(false)
+    { }
+
+    erased_function_t(const erased_function_t &other) :
+        m_callable(other.m_clone(other.m_callable)),
+        m_call(other.m_call),
+        m_clone(other.m_clone),
+        m_destroy(other.m_destroy),
+        m_owning(true)
+    { }
+
+    erased_function_t &operator=(const erased_function_t &) = delete;
+
+    ~erased_function_t() {
+        if (m_owning) {
+            m_destroy(m_callable);
+        }
+    }
+
+    void operator()() {
+        m_call(m_callable);
+    }
 
-    virtual R operator()(Args... args) = 0;
-    virtual void *allocate(std::size_t) = 0;
-    virtual void deallocate(void *, std::size_t) = 0;
-    virtual bool is_continuation() = 0;
-    virtual void invoke(std::function<void()>) = 0;
+private:
+    template<class Callable>
+    static void call(void *callable) {
+        call_impl(*static_cast<Callable *>(callable));
+    }
 
-    virtual std::unique_ptr<erased_handler_base> clone() = 0;
+    template<class Callable>
+    static void call_impl(Callable &callable) {
+        callable();
+    }
+
+    // The same as the default asio_handler_invoke() does with constant function objects.
+    template<class Callable>
+    static void call_impl(const Callable &callable) {
+        Callable copy(callable);
+        copy();
+    }
+
+    template<class Callable>
+    static void *clone(void *callable) {
+        return new std::decay_t<Callable>(*static_cast<Callable *>(callable));
+    }
+
+    template<class Callable>
+    static void destroy(void *callable) {
+        delete static_cast<std::decay_t<Callable> *>(callable);
+    }
+
+private:
+    void *m_callable;
+    void (*m_call)(void *);
+    void *(*m_clone)(void *);
+    void (*m_destroy)(void *);
+    bool m_owning;
 };
 
-template<class F, class R, class... Args>
-class erased_handler_impl: public erased_handler_base<R, Args...> {
-public:
-    erased_handler_impl(F f) :
-        m_function(f)
-    { }
 
-    R operator()(Args... args) override {
-        return m_function(std::move(args)...);
+template<class R, class... Args>
+struct erased_handler_vtable_t {
+    R (*call)(void *, Args...);
+    void *(*allocate)(void *, std::size_t);
+    void (*deallocate)(void *, void *, std::size_t);
+    bool (*is_continuation)(void *);
+    void (*invoke)(void *, erased_function_t &);
+
+    void (*copy)(const void *, void *);
+    void (*move)(void *, void *);
+    void (*destroy)(void *);
+};
+
+
+// Storage is the raw storage of erased_handler. Small handlers are constructed right in it,
+// big ones are allocated on the heap and the storage keeps the pointer.
+template<class F, bool Inline>
+struct erased_handler_storage_t;
+
+template<class F>
+struct erased_handler_storage_t<F, true> {
+    static F &get(void *storage) {
+        return *static_cast<F *>(storage);
+    }
+
+    static const F &get(const void *storage) {
+        return *static_cast<const F *>(storage);
+    }
+
+    template<class G>
+    static void construct(void *storage, G &&f) {
+        new (storage) F(std::forward<G>(f));
+    }
+
+    static void move(void *from, void *to) {
+        new (to) F(std::move(get(from)));
+        get(from).~F();
+    }
+
+    static void destroy(void *storage) {
+        get(storage).~F();
+    }
+};
+
+template<class F>
+struct erased_handler_storage_t<F, false> {
+    static F &get(void *storage) {
+        return **static_cast<F **>(storage);
+    }
+
+    static const F &get(const void *storage) {
+        return **static_cast<F *const *>(storage);
     }
 
-    void *allocate(std::size_t size) override {
+    template<class G>
+    static void construct(void *storage, G &&f) {
+        void *memory = allocate();
+
+        try {
+            *static_cast<F **>(storage) = new (memory) F(std::forward<G>(f));
+        } catch (...) {
+            deallocate(memory);
+            throw;
+        }
+    }
+
+    static void move(void *from, void *to) {
+        *static_cast<F **>(to) = *static_cast<F **>(from);
+    }
+
+    static void destroy(void *storage) {
+        F *f = *static_cast<F **>(storage);
+        f->~F();
+        deallocate(f);
+    }
+
+private:
+    // Before C++17 operator new doesn't align beyond max_align_t, so an over-aligned handler gets a bigger block
+    // with the pointer to its start right before the handler.
+    static constexpr bool over_aligned = alignof(F) > alignof(std::max_align_t);
+
+    static void *allocate() {
+        if (!over_aligned) {
+            return ::operator new(sizeof(F));
+        }
+
+        void *block = ::operator new(sizeof(F) + alignof(F) + sizeof(void *));
+        auto address = reinterpret_cast<std::uintptr_t>(block) + sizeof(void *);
+        void *memory = reinterpret_cast<void *>((address + alignof(F) - 1) & ~(alignof(F) - 1));
+        static_cast<void **>(memory)[-1] = block;
+
+        return memory;
+    }
+
+    static void deallocate(void *memory) {
+        if (!over_aligned) {
+            ::operator delete(memory);
+        } else {
+            ::operator delete(static_cast<void **>(memory)[-1]);
+        }
+    }
+};
+
+
+template<class F, bool Inline, class R, class... Args>
+struct erased_handler_ops_t {
+    using storage_t = erased_handler_storage_t<F, Inline>;
+
+    static R call(void *storage, Args... args) {
+        return storage_t::get(storage)(std::move(args)...);
+    }
+
+    static void *allocate(void *storage, std::size_t size) {
         using boost::asio::asio_handler_allocate;
-        return asio_handler_allocate(size, &m_function);
+        return asio_handler_allocate(size, &storage_t::get(storage));
     }
 
-    void deallocate(void *ptr, std::size_t size) override {
+    static void deallocate(void *storage, void *pointer, std::size_t size) {
         using boost::asio::asio_handler_deallocate;
-        asio_handler_deallocate(ptr, size, &m_function);
+        asio_handler_deallocate(pointer, size, &storage_t::get(storage));
     }
 
-    bool is_continuation() override {
+    static bool is_continuation(void *storage) {
         using boost::asio::asio_handler_is_continuation;
-        return asio_handler_is_continuation(&m_function);
+        return asio_handler_is_continuation(&storage_t::get(storage));
     }
 
-    void invoke(std::function<void()> callable) override {
+    static void invoke(void *storage, erased_function_t &function) {
         using boost::asio::asio_handler_invoke;
-        asio_handler_invoke(callable, &m_function);
+        asio_handler_invoke(function, &storage_t::get(storage));
     }
 
-    std::unique_ptr<erased_handler_base<R, Args...>> clone() override {
-        return std::make_unique<erased_handler_impl>(m_function);
+    static void copy(const void *from, void *to) {
+        storage_t::construct(to, storage_t::get(from));
     }
 
-private:
-    F m_function;
+    static void move(void *from, void *to) {
+        storage_t::move(from, to);
+    }
+
+    static void destroy(void *storage) {
+        storage_t::destroy(storage);
+    }
+
+    static const erased_handler_vtable_t<R, Args...> vtable;
+};
+
+template<class F, bool Inline, class R, class... Args>
+const erased_handler_vtable_t<R, Args...> erased_handler_ops_t<F, Inline, R, Args...>::vtable = {
+    &erased_handler_ops_t::call,
+    &erased_handler_ops_t::allocate,
+    &erased_handler_ops_t::deallocate,
+    &erased_handler_ops_t::is_continuation,
+    &erased_handler_ops_t::invoke,
+    &erased_handler_ops_t::copy,
+    &erased_handler_ops_t::move,
+    &erased_handler_ops_t::destroy
 };
 
 } // namespace detail
@@ -73,62 +258,114 @@ private:
 template<class Signature>
 class erased_handler;
 
+// Type-erased handler which forwards the asio hooks to the wrapped one.
+// Handlers up to inline_size bytes (enough for a lambda holding a shared_ptr and a few more pointers) are stored
+// inline, so wrapping, moving and copying them doesn't allocate.
+// It's copyable because asio before 1.66 requires handlers to be CopyConstructible.
 template<class R, class... Args>
 class erased_handler<R(Args...)> {
 public:
+    static constexpr std::size_t inline_size = 8 * sizeof(void *);
+
     template<class F>
-    erased_handler(F f) :
-        m_impl(std::make_unique<detail::erased_handler_impl<F, R, Args...>>(std::move(f)))
-    { }
+    static constexpr bool is_stored_inline() {
+        return sizeof(F) <= inline_size &&
+               alignof(F) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<F>::value;
+    }
+
+public:
+    template<
+        class F,
+        class = std::enable_if_t<!std::is_same<std::decay_t<F>, erased_handler>::value>
+    >
+    erased_handler(F &&f) {
+        using function_t = std::decay_t<F>;
+        using ops_t = detail::erased_handler_ops_t<function_t, is_stored_inline<function_t>(), R, Args...>;
+
+        ops_t::storage_t::construct(&m_storage, std::forward<F>(f));
+        m_vtable = &ops_t::vtable;
+    }
 
     erased_handler(const erased_handler &other) :
-        m_impl(other.m_impl->clone())
-    { }
+        m_vtable(other.m_vtable)
+    {
+        m_vtable->copy(&other.m_storage, &m_storage);
+    }
 
     erased_handler(erased_handler &&other) :
-        m_impl(std::move(other.m_impl))
-    { }
+        m_vtable(other.m_vtable)
+    {
+        m_vtable->move(&other.m_storage, &m_storage);
+        other.m_vtable = nullptr;
+    }
+
+    ~erased_handler() {
+        reset();
+    }
+
+    erased_handler &operator=(const erased_handler &other) {
+        if (this != &other) {
+            reset();
+            other.m_vtable->copy(&other.m_storage, &m_storage);
+            m_vtable = other.m_vtable;
+        }
 
-    erased_handler *operator=(const erased_handler &other) {
-        m_impl = other.m_impl->clone();
         return *this;
     }
 
-    erased_handler *operator=(erased_handler &&other) {
-        m_impl = std::move(other.m_impl);
+    erased_handler &operator=(erased_handler &&other) {
+        if (this != &other) {
+            reset();
+            other.m_vtable->move(&other.m_storage, &m_storage);
+            m_vtable = other.m_vtable;
+            other.m_vtable = nullptr;
+        }
+
         return *this;
     }
 
     template<class... Args2>
     R operator()(Args2 &&... args) {
-        return (*m_impl)(std::forward<Args2>(args)...);
+        return m_vtable->call(&m_storage, std::forward<Args2>(args)...);
     }
 
 
     friend void *asio_handler_allocate(std::size_t size, erased_handler *context) {
-        return context->m_impl->allocate(size);
+        return context->m_vtable->allocate(&context->m_storage, size);
     }
 
     friend void asio_handler_deallocate(void *pointer, std::size_t size, erased_handler *context) {
-        context->m_impl->deallocate(pointer, size);
+        context->m_vtable->deallocate(&context->m_storage, pointer, size);
     }
 
     friend bool asio_handler_is_continuation(erased_handler *context) {
-        return context->m_impl->is_continuation();
+        return context->m_vtable->is_continuation(&context->m_storage);
     }
 
     template<class Callable>
     friend void asio_handler_invoke(Callable &function, erased_handler *context) {
-        context->m_impl->invoke(function);
+        detail::erased_function_t erased_function(function);
+        context->m_vtable->invoke(&context->m_storage, erased_function);
     }
 
     template<class Callable>
     friend void asio_handler_invoke(const Callable &function, erased_handler *context) {
-        context->m_impl->invoke(function);
+        detail::erased_function_t erased_function(function);
+        context->m_vtable->invoke(&context->m_storage, erased_function);
+    }
+
+private:
+    void reset() {
+        if (m_vtable) {
+            m_vtable->destroy(&m_storage);
+            m_vtable = nullptr;
+        }
     }
 
 private:
-    std::unique_ptr<detail::erased_handler_base<R, Args...>> m_impl;
+    const detail::erased_handler_vtable_t<R, Args...> *m_vtable;
+    std::aligned_storage_t<inline_size, alignof(std::max_align_t)> m_storage;
 };
 
 HTTPLIB_CLOSE_NAMESPACE
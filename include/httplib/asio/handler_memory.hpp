@@ -0,0 +1,140 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+
+#include <boost/asio/handler_continuation_hook.hpp>
+#include <boost/asio/handler_invoke_hook.hpp>
+
+#include <array>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+// Memory for the operations of one connection.
+// asio allocates the state of an asynchronous operation through the handler's asio_handler_allocate()
+// and frees it before calling the handler. A read in progress holds two blocks: the state of
+// async_read_request() and the socket read it's waiting for; a write holds one more.
+// So a connection with one read and one write in progress never needs more than three blocks at a time.
+// The arena keeps three blocks and reuses them, growing a free block when a bigger one is requested.
+// When all of them are in use, it falls back to operator new.
+// Not thread-safe: use it for the operations of one connection running in one thread or strand.
+class handler_memory_t {
+public:
+    handler_memory_t() = default;
+
+    handler_memory_t(const handler_memory_t &) = delete;
+    handler_memory_t &operator=(const handler_memory_t &) = delete;
+
+    ~handler_memory_t() {
+        for (auto &slot: m_slots) {
+            ::operator delete(slot.memory);
+        }
+    }
+
+    void *allocate(std::size_t size) {
+        for (auto &slot: m_slots) {
+            if (!slot.in_use && slot.size >= size) {
+                slot.in_use = true;
+                return slot.memory;
+            }
+        }
+
+        for (auto &slot: m_slots) {
+            if (!slot.in_use) {
+                ::operator delete(slot.memory);
+                slot.memory = nullptr;
+                slot.size = 0;
+
+                slot.memory = ::operator new(size);
+                slot.size = size;
+                slot.in_use = true;
+                return slot.memory;
+            }
+        }
+
+        return ::operator new(size);
+    }
+
+    void deallocate(void *pointer, std::size_t) {
+        for (auto &slot: m_slots) {
+            if (slot.memory == pointer) {
+                slot.in_use = false;
+                return;
+            }
+        }
+
+        ::operator delete(pointer);
+    }
+
+private:
+    struct slot_t {
+        void *memory = nullptr;
+        std::size_t size = 0;
+        bool in_use = false;
+    };
+
+    std::array<slot_t, 3> m_slots;
+};
+
+
+// Allocates the memory of the operations it's passed to from a handler_memory_t
+// and forwards the other asio hooks to the wrapped handler. Made by bind_handler_memory().
+// The memory must outlive all the operations.
+template<class Handler>
+class memory_bound_handler {
+public:
+    memory_bound_handler(handler_memory_t &memory, Handler handler) :
+        m_memory(&memory),
+        m_handler(std::move(handler))
+    { }
+
+    template<class... Args>
+    void operator()(Args &&... args) {
+        m_handler(std::forward<Args>(args)...);
+    }
+
+    friend void *asio_handler_allocate(std::size_t size, memory_bound_handler *context) {
+        return context->m_memory->allocate(size);
+    }
+
+    friend void asio_handler_deallocate(void *pointer, std::size_t size, memory_bound_handler *context) {
+        context->m_memory->deallocate(pointer, size);
+    }
+
+    friend bool asio_handler_is_continuation(memory_bound_handler *context) {
+        using boost::asio::asio_handler_is_continuation;
+        return asio_handler_is_continuation(&context->m_handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(Callable &function, memory_bound_handler *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->m_handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(const Callable &function, memory_bound_handler *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->m_handler);
+    }
+
+private:
+    handler_memory_t *m_memory;
+    Handler m_handler;
+};
+
+
+// Wraps the handler of an operation on a connection, e.g.
+//     httplib::async_read_request(stream, parser, options, httplib::bind_handler_memory(m_memory, [self](...) { ... }));
+template<class Handler>
+memory_bound_handler<std::decay_t<Handler>> bind_handler_memory(handler_memory_t &memory, Handler &&handler) {
+    return memory_bound_handler<std::decay_t<Handler>>(memory, std::forward<Handler>(handler));
+}
+
+
+HTTPLIB_CLOSE_NAMESPACE
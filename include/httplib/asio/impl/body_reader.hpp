@@ -131,7 +131,7 @@ make_body_reader(body_size_t size, const http_headers_t &headers, BufferedReadSt
         } break;
 
         case body_size_t::type_t::transfer_encoding: {
-            auto transfer_encoding = headers.get_header_values("Transfer-Encoding");
+            auto transfer_encoding = headers.get_header_values(known_header_t::transfer_encoding);
 
             if (!transfer_encoding || transfer_encoding->empty()) {
                 return make_error_result<result_t>(make_body_reader_error_t::bad_message);
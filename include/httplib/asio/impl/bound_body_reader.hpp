@@ -3,6 +3,7 @@
 #include <httplib/detail/common.hpp>
 #include <httplib/error.hpp>
 #include <httplib/http/misc.hpp>
+#include <httplib/asio/connection_timeouts.hpp>
 #include <httplib/asio/read_options.hpp>
 
 #include <boost/asio/async_result.hpp>
@@ -34,6 +35,7 @@ bound_body_reader<BufferedReadStream>::bound_body_reader(
 template<class BufferedReadStream>
 void bound_body_reader<BufferedReadStream>::set_options(read_options_t options) {
     m_options = options;
+    m_read_size = read_size_t(m_options);
 }
 
 
@@ -71,14 +73,26 @@ std::size_t bound_body_reader<BufferedReadStream>::read_some(MutableBuffers buff
     } else if (m_total_read >= m_to_read) {
         ec = make_error_code(httplib::reader_errc_t::eof);
         return 0;
+    } else if (m_stream->buffer().size() == 0 && boost::asio::buffer_size(buffers) >= m_options.read_buffer_size) {
+        boost::system::error_code read_error;
+        std::size_t transferred = m_stream->stream().read_some(direct_read_buffers(buffers), read_error);
+
+        m_total_read += transferred;
+
+        if (transferred == 0 && read_error) {
+            ec = read_error;
+        }
+
+        return transferred;
     } else {
         if (m_stream->buffer().size() == 0) {
             boost::system::error_code read_error;
             std::size_t transferred = m_stream->stream().read_some(
-                m_stream->buffer().prepare(m_options.read_buffer_size),
+                m_stream->buffer().prepare(m_read_size.get()),
                 read_error
             );
 
+            m_read_size.update(transferred);
             m_stream->buffer().commit(transferred);
 
             if (transferred == 0 && read_error) {
@@ -101,6 +115,28 @@ std::size_t bound_body_reader<BufferedReadStream>::read_some(MutableBuffers buff
 }
 
 
+template<class BufferedReadStream>
+template<class MutableBuffers>
+erased_mutable_buffers_t bound_body_reader<BufferedReadStream>::direct_read_buffers(const MutableBuffers &buffers) const {
+    // Don't let the next message into the caller's buffers.
+    content_length_int_t left = m_to_read - m_total_read;
+
+    if (left < boost::asio::buffer_size(buffers)) {
+        return erased_mutable_buffers_t(buffers, static_cast<std::size_t>(left));
+    } else {
+        return erased_mutable_buffers_t(buffers);
+    }
+}
+
+
+template<class BufferedReadStream>
+void bound_body_reader<BufferedReadStream>::finish_timeouts(boost::system::error_code ec) {
+    if (m_options.timeouts && (ec || m_total_read >= m_to_read)) {
+        m_options.timeouts->finish();
+    }
+}
+
+
 template<class BufferedReadStream>
 template<class MutableBuffers>
 std::size_t bound_body_reader<BufferedReadStream>::read_some(MutableBuffers buffers) {
@@ -122,10 +158,14 @@ struct bound_body_reader<BufferedReadStream>::async_read_some_op {
     Buffers buffers;
     Handler handler;
 
+    // Whether the pending read is into the caller's buffers.
+    bool direct;
+
     async_read_some_op(bound_body_reader &reader, Buffers buffers, Handler handler) :
         reader(reader),
         buffers(buffers),
-        handler(std::move(handler))
+        handler(std::move(handler)),
+        direct(false)
     { }
 
     void start() {
@@ -134,9 +174,19 @@ struct bound_body_reader<BufferedReadStream>::async_read_some_op {
             boost::asio::buffer_size(buffers) == 0)
         {
             reader.m_stream->stream().get_io_service().post(std::move(*this));
+            return;
+        }
+
+        if (auto *timeouts = reader.m_options.timeouts) {
+            timeouts->read_body(0);
+        }
+
+        if (boost::asio::buffer_size(buffers) >= reader.m_options.read_buffer_size) {
+            direct = true;
+            reader.m_stream->stream().async_read_some(reader.direct_read_buffers(buffers), std::move(*this));
         } else {
             reader.m_stream->stream().async_read_some(
-                reader.m_stream->buffer().prepare(reader.m_options.read_buffer_size),
+                reader.m_stream->buffer().prepare(reader.m_read_size.get()),
                 std::move(*this)
             );
         }
@@ -144,6 +194,7 @@ struct bound_body_reader<BufferedReadStream>::async_read_some_op {
 
     void operator()() {
         if (reader.m_total_read >= reader.m_to_read) {
+            reader.finish_timeouts();
             handler(make_error_code(httplib::reader_errc_t::eof), 0);
         } else {
             std::size_t transferred = boost::asio::buffer_copy(
@@ -154,11 +205,39 @@ struct bound_body_reader<BufferedReadStream>::async_read_some_op {
 
             reader.m_stream->buffer().consume(transferred);
             reader.m_total_read += transferred;
+            reader.finish_timeouts();
             handler(boost::system::error_code(), transferred);
         }
     }
 
     void operator()(boost::system::error_code ec, std::size_t transferred) {
+        if (auto *timeouts = reader.m_options.timeouts) {
+            // After an expiry read_body() would start the timeouts anew and hide it.
+            ec = timeouts->error(ec);
+
+            if (transferred > 0) {
+                timeouts->read_body(transferred);
+            }
+        }
+
+        if (direct) {
+            reader.m_total_read += transferred;
+            reader.finish_timeouts();
+
+            if (transferred > 0) {
+                handler(boost::system::error_code(), transferred);
+            } else if (ec) {
+                reader.finish_timeouts(ec);
+                handler(ec, 0);
+            } else {
+                handler(make_error_code(boost::asio::error::try_again), 0);
+            }
+
+            return;
+        }
+
+        reader.m_read_size.update(transferred);
+
         if (transferred > 0) {
             reader.m_stream->buffer().commit(transferred);
         }
@@ -169,6 +248,7 @@ struct bound_body_reader<BufferedReadStream>::async_read_some_op {
         }
 
         if (ec) {
+            reader.finish_timeouts(ec);
             handler(ec, 0);
             return;
         }
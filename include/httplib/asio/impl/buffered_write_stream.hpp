@@ -0,0 +1,418 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/handler_alloc_hook.hpp>
+#include <boost/asio/handler_continuation_hook.hpp>
+#include <boost/asio/handler_invoke_hook.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/container/small_vector.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <cstdlib>
+#include <utility>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+namespace detail {
+
+// Adapts a flush handler to the completion signature of a write.
+template<class Handler>
+struct flush_handler_t {
+    Handler handler;
+
+    void operator()(boost::system::error_code ec, std::size_t) {
+        handler(ec);
+    }
+
+    friend void *asio_handler_allocate(std::size_t size, flush_handler_t *context) {
+        using boost::asio::asio_handler_allocate;
+        return asio_handler_allocate(size, &context->handler);
+    }
+
+    friend void asio_handler_deallocate(void *pointer, std::size_t size, flush_handler_t *context) {
+        using boost::asio::asio_handler_deallocate;
+        asio_handler_deallocate(pointer, size, &context->handler);
+    }
+
+    friend bool asio_handler_is_continuation(flush_handler_t *context) {
+        using boost::asio::asio_handler_is_continuation;
+        return asio_handler_is_continuation(&context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(Callable &function, flush_handler_t *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(const Callable &function, flush_handler_t *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+};
+
+} // namespace detail
+
+
+template<class WriteStream>
+template<class StreamInit>
+buffered_write_stream<WriteStream>::buffered_write_stream(StreamInit &&stream, std::size_t flush_threshold) :
+    m_stream(std::forward<StreamInit>(stream))
+{
+    m_state = std::make_shared<state_t>(&m_stream, flush_threshold);
+}
+
+
+template<class WriteStream>
+buffered_write_stream<WriteStream>::~buffered_write_stream() {
+    m_state->stream = nullptr;
+}
+
+
+template<class WriteStream>
+boost::asio::io_service &buffered_write_stream<WriteStream>::get_io_service() {
+    return m_stream.get_io_service();
+}
+
+
+template<class WriteStream>
+std::size_t buffered_write_stream<WriteStream>::buffered_size() const {
+    return m_state->buffer.size() + m_state->sending.size();
+}
+
+
+template<class WriteStream>
+template<class MutableBuffers, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<std::decay_t<Handler>, void(boost::system::error_code, std::size_t)>::type
+>::type
+buffered_write_stream<WriteStream>::async_read_some(const MutableBuffers &buffers, Handler &&handler) {
+    return m_stream.async_read_some(buffers, std::forward<Handler>(handler));
+}
+
+
+template<class WriteStream>
+template<class MutableBuffers>
+std::size_t buffered_write_stream<WriteStream>::read_some(const MutableBuffers &buffers, boost::system::error_code &ec) {
+    return m_stream.read_some(buffers, ec);
+}
+
+
+template<class WriteStream>
+template<class MutableBuffers>
+std::size_t buffered_write_stream<WriteStream>::read_some(const MutableBuffers &buffers) {
+    return m_stream.read_some(buffers);
+}
+
+
+template<class WriteStream>
+template<class ConstBuffers, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<std::decay_t<Handler>, void(boost::system::error_code, std::size_t)>::type
+>::type
+buffered_write_stream<WriteStream>::async_write_some(const ConstBuffers &buffers, Handler &&handler) {
+    using handler_t = typename boost::asio::handler_type<
+        std::decay_t<Handler>,
+        void(boost::system::error_code, std::size_t)
+    >::type;
+
+    using op_t = async_write_op<ConstBuffers, handler_t>;
+
+    // A composed operation may pass buffers pointing into itself along with itself as the handler,
+    // e.g. async_write() passes its consuming_buffers. Copy them before the handler is moved from.
+    ConstBuffers sequence(buffers);
+
+    handler_t concrete_handler = std::forward<Handler>(handler);
+    boost::asio::async_result<handler_t> result(concrete_handler);
+
+    op_t(*this, sequence, false, std::move(concrete_handler)).start();
+
+    return result.get();
+}
+
+
+template<class WriteStream>
+template<class ConstBuffers>
+std::size_t buffered_write_stream<WriteStream>::write_some(const ConstBuffers &buffers, boost::system::error_code &ec) {
+    if (m_state->error) {
+        ec = m_state->error;
+        return 0;
+    }
+
+    ec.clear();
+
+    std::size_t size = boost::asio::buffer_size(buffers);
+
+    if (fits(buffers)) {
+        append(buffers);
+        return size;
+    }
+
+    boost::container::small_vector<boost::asio::const_buffer, 8> sequence;
+
+    if (!m_state->buffer.empty()) {
+        sequence.emplace_back(boost::asio::buffer(m_state->buffer));
+    }
+
+    sequence.insert(sequence.end(), buffers.begin(), buffers.end());
+
+    boost::asio::write(m_stream, sequence, ec);
+    m_state->buffer.clear();
+
+    if (ec) {
+        m_state->error = ec;
+        return 0;
+    }
+
+    return size;
+}
+
+
+template<class WriteStream>
+template<class ConstBuffers>
+std::size_t buffered_write_stream<WriteStream>::write_some(const ConstBuffers &buffers) {
+    boost::system::error_code ec;
+    std::size_t result = write_some(buffers, ec);
+
+    if (ec) {
+        throw boost::system::system_error(ec);
+    }
+
+    return result;
+}
+
+
+template<class WriteStream>
+template<class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code)>::type
+>::type
+buffered_write_stream<WriteStream>::async_flush(Handler handler) {
+    using handler_t = typename boost::asio::handler_type<Handler, void(boost::system::error_code)>::type;
+    using op_t = async_write_op<boost::asio::const_buffers_1, detail::flush_handler_t<handler_t>>;
+
+    handler_t concrete_handler = std::move(handler);
+    boost::asio::async_result<handler_t> result(concrete_handler);
+
+    op_t(
+        *this,
+        boost::asio::const_buffers_1(nullptr, 0),
+        true,
+        detail::flush_handler_t<handler_t>{std::move(concrete_handler)}
+    ).start();
+
+    return result.get();
+}
+
+
+template<class WriteStream>
+void buffered_write_stream<WriteStream>::flush(boost::system::error_code &ec) {
+    if (m_state->error) {
+        ec = m_state->error;
+        return;
+    }
+
+    ec.clear();
+
+    if (!m_state->buffer.empty()) {
+        boost::asio::write(m_stream, boost::asio::buffer(m_state->buffer), ec);
+        m_state->buffer.clear();
+        m_state->error = ec;
+    }
+}
+
+
+template<class WriteStream>
+void buffered_write_stream<WriteStream>::flush() {
+    boost::system::error_code ec;
+    flush(ec);
+
+    if (ec) {
+        throw boost::system::system_error(ec);
+    }
+}
+
+
+template<class WriteStream>
+template<class ConstBuffers>
+bool buffered_write_stream<WriteStream>::fits(const ConstBuffers &buffers) const {
+    return m_state->buffer.size() + boost::asio::buffer_size(buffers) < m_state->flush_threshold;
+}
+
+
+template<class WriteStream>
+template<class ConstBuffers>
+void buffered_write_stream<WriteStream>::append(const ConstBuffers &buffers) {
+    for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+        boost::asio::const_buffer buffer(*it);
+        m_state->buffer.append(boost::asio::buffer_cast<const char *>(buffer), boost::asio::buffer_size(buffer));
+    }
+}
+
+
+template<class WriteStream>
+void buffered_write_stream<WriteStream>::start_background_flush(const std::shared_ptr<state_t> &state) {
+    if (!state->stream || state->writing || state->error || state->buffer.empty()) {
+        return;
+    }
+
+    // Writes made while this one is in progress go to the other buffer.
+    state->buffer.swap(state->sending);
+    state->writing = true;
+
+    boost::asio::async_write(*state->stream, boost::asio::buffer(state->sending), background_flush_op{state});
+}
+
+
+// Owns the state, so the buffers stay valid even if the buffered_write_stream is destroyed during the write.
+template<class WriteStream>
+struct buffered_write_stream<WriteStream>::background_flush_op {
+    std::shared_ptr<state_t> state;
+
+    void operator()(boost::system::error_code ec, std::size_t) {
+        state->writing = false;
+        state->sending.clear();
+
+        if (ec && !state->error) {
+            state->error = ec;
+        }
+
+        if (state->waiter) {
+            auto waiter = std::move(*state->waiter);
+            state->waiter = boost::none;
+            waiter(state->error);
+        } else {
+            start_background_flush(state);
+        }
+    }
+};
+
+
+template<class WriteStream>
+template<class ConstBuffers, class Handler>
+struct buffered_write_stream<WriteStream>::async_write_op {
+    buffered_write_stream &stream;
+    ConstBuffers buffers;
+    bool flush;
+    Handler handler;
+    boost::system::error_code result;
+
+    async_write_op(buffered_write_stream &stream, const ConstBuffers &buffers, bool flush, Handler handler) :
+        stream(stream),
+        buffers(buffers),
+        flush(flush),
+        handler(std::move(handler))
+    { }
+
+    void start() {
+        state_t &state = *stream.m_state;
+        ++state.operations;
+
+        if (state.error) {
+            result = state.error;
+            stream.get_io_service().post(std::move(*this));
+            return;
+        }
+
+        // Small writes go to the buffer even while a background flush is in progress.
+        if (!flush && stream.fits(buffers)) {
+            stream.append(buffers);
+            stream.get_io_service().post(std::move(*this));
+            return;
+        }
+
+        if (state.writing) {
+            state.waiter = erased_handler<void(boost::system::error_code)>(std::move(*this));
+            return;
+        }
+
+        boost::container::small_vector<boost::asio::const_buffer, 8> sequence;
+
+        if (!state.buffer.empty()) {
+            sequence.emplace_back(boost::asio::buffer(state.buffer));
+        }
+
+        for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+            boost::asio::const_buffer buffer(*it);
+
+            if (boost::asio::buffer_size(buffer) > 0) {
+                sequence.emplace_back(buffer);
+            }
+        }
+
+        if (sequence.empty()) {
+            stream.get_io_service().post(std::move(*this));
+            return;
+        }
+
+        state.writing = true;
+        boost::asio::async_write(stream.m_stream, sequence, std::move(*this));
+    }
+
+    // Completes the operation with the result.
+    // The buffer is flushed at the end of the handler, unless the handler starts another operation.
+    void operator()() {
+        // The handler may destroy the stream.
+        std::shared_ptr<state_t> state = stream.m_state;
+        std::size_t operations = state->operations;
+
+        handler(result, result ? 0 : boost::asio::buffer_size(buffers));
+
+        if (state->operations == operations) {
+            start_background_flush(state);
+        }
+    }
+
+    // The background flush this operation waited for is completed.
+    void operator()(boost::system::error_code) {
+        start();
+    }
+
+    void operator()(boost::system::error_code ec, std::size_t) {
+        state_t &state = *stream.m_state;
+
+        state.writing = false;
+        state.buffer.clear();
+
+        if (ec) {
+            state.error = ec;
+        }
+
+        result = ec;
+        (*this)();
+    }
+
+    friend void *asio_handler_allocate(std::size_t size, async_write_op *context) {
+        using boost::asio::asio_handler_allocate;
+        return asio_handler_allocate(size, &context->handler);
+    }
+
+    friend void asio_handler_deallocate(void *pointer, std::size_t size, async_write_op *context) {
+        using boost::asio::asio_handler_deallocate;
+        asio_handler_deallocate(pointer, size, &context->handler);
+    }
+
+    friend bool asio_handler_is_continuation(async_write_op *context) {
+        using boost::asio::asio_handler_is_continuation;
+        return asio_handler_is_continuation(&context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(Callable &function, async_write_op *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(const Callable &function, async_write_op *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+};
+
+HTTPLIB_CLOSE_NAMESPACE
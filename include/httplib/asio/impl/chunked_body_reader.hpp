@@ -2,6 +2,7 @@
 
 #include <httplib/detail/common.hpp>
 #include <httplib/error.hpp>
+#include <httplib/asio/connection_timeouts.hpp>
 #include <httplib/asio/read_options.hpp>
 
 #include <boost/asio/async_result.hpp>
@@ -10,6 +11,7 @@
 #include <boost/asio/handler_continuation_hook.hpp>
 #include <boost/asio/handler_invoke_hook.hpp>
 
+#include <algorithm>
 #include <cstdlib>
 
 
@@ -30,6 +32,7 @@ chunked_body_reader<BufferedReadStream>::chunked_body_reader(BufferedReadStream
 template<class BufferedReadStream>
 void chunked_body_reader<BufferedReadStream>::set_options(read_options_t options) {
     m_options = options;
+    m_read_size = read_size_t(m_options);
     m_parser.set_options(m_options.parsing);
 }
 
@@ -66,48 +69,51 @@ chunked_body_reader<BufferedReadStream>::async_read_some(MutableBuffers buffers,
 
 
 template<class BufferedReadStream>
-template<class MutableBuffers>
-std::size_t chunked_body_reader<BufferedReadStream>::read_some(MutableBuffers buffers, boost::system::error_code &ec) {
-    if (boost::asio::buffer_size(buffers) == 0) {
-        return 0;
-    }
+template<class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, boost::asio::const_buffer)>::type
+>::type
+chunked_body_reader<BufferedReadStream>::async_read_some_view(Handler handler) {
+    using handler_t = typename boost::asio::handler_type<Handler, void(boost::system::error_code, boost::asio::const_buffer)>::type;
+    using op_t = async_read_some_op<view_tag_t, handler_t>;
 
-    while (true) {
-        if (m_unconsumed_body_size > 0) {
-            std::size_t transferred = boost::asio::buffer_copy(
-                buffers,
-                boost::asio::buffer(m_unconsumed_body, m_unconsumed_body_size)
-            );
+    handler_t concrete_handler = std::move(handler);
+    boost::asio::async_result<handler_t> result(concrete_handler);
+    op_t op(*this, view_tag_t(), std::move(concrete_handler));
 
-            m_unconsumed_body += transferred;
-            m_unconsumed_body_size -= transferred;
+    op.start();
+
+    return result.get();
+}
 
-            if (m_unconsumed_body_size == 0) {
-                m_stream->buffer().consume(m_last_parsed_part);
-            }
 
-            return transferred;
+template<class BufferedReadStream>
+bool chunked_body_reader<BufferedReadStream>::read_data(boost::system::error_code &ec) {
+    while (true) {
+        if (m_unconsumed_body_size > 0) {
+            return true;
         } else if (m_error) {
             ec = m_error;
-            return 0;
+            return false;
         } else if (m_parser.done()) {
             m_error = make_error_code(httplib::reader_errc_t::eof);
             ec = m_error;
-            return 0;
+            return false;
         }
 
         if (m_stream->buffer().size() == 0) {
             boost::system::error_code read_error;
             std::size_t transferred = m_stream->stream().read_some(
-                m_stream->buffer().prepare(m_options.read_buffer_size),
+                m_stream->buffer().prepare(m_read_size.get()),
                 read_error
             );
 
+            m_read_size.update(transferred);
             m_stream->buffer().commit(transferred);
 
             if (transferred == 0 && read_error) {
                 ec = read_error;
-                return 0;
+                return false;
             }
         }
 
@@ -116,6 +122,24 @@ std::size_t chunked_body_reader<BufferedReadStream>::read_some(MutableBuffers bu
 }
 
 
+template<class BufferedReadStream>
+template<class MutableBuffers>
+std::size_t chunked_body_reader<BufferedReadStream>::read_some(MutableBuffers buffers, boost::system::error_code &ec) {
+    if (boost::asio::buffer_size(buffers) == 0 || !read_data(ec)) {
+        return 0;
+    }
+
+    std::size_t transferred = boost::asio::buffer_copy(
+        buffers,
+        boost::asio::buffer(m_unconsumed_body, m_unconsumed_body_size)
+    );
+
+    consume(transferred);
+
+    return transferred;
+}
+
+
 template<class BufferedReadStream>
 template<class MutableBuffers>
 std::size_t chunked_body_reader<BufferedReadStream>::read_some(MutableBuffers buffers) {
@@ -130,6 +154,42 @@ std::size_t chunked_body_reader<BufferedReadStream>::read_some(MutableBuffers bu
 }
 
 
+template<class BufferedReadStream>
+boost::asio::const_buffer chunked_body_reader<BufferedReadStream>::read_some_view(boost::system::error_code &ec) {
+    if (!read_data(ec)) {
+        return boost::asio::const_buffer();
+    }
+
+    return boost::asio::const_buffer(m_unconsumed_body, m_unconsumed_body_size);
+}
+
+
+template<class BufferedReadStream>
+boost::asio::const_buffer chunked_body_reader<BufferedReadStream>::read_some_view() {
+    boost::system::error_code ec;
+    boost::asio::const_buffer result = read_some_view(ec);
+
+    if (ec) {
+        throw boost::system::system_error(ec);
+    }
+
+    return result;
+}
+
+
+template<class BufferedReadStream>
+void chunked_body_reader<BufferedReadStream>::consume(std::size_t size) {
+    size = std::min(size, m_unconsumed_body_size);
+
+    m_unconsumed_body += size;
+    m_unconsumed_body_size -= size;
+
+    if (size > 0 && m_unconsumed_body_size == 0) {
+        m_stream->buffer().consume(m_last_parsed_part);
+    }
+}
+
+
 template<class BufferedReadStream>
 void chunked_body_reader<BufferedReadStream>::consume_read_buffer() {
     auto buffers = m_stream->buffer().data();
@@ -164,6 +224,11 @@ void chunked_body_reader<BufferedReadStream>::consume_read_buffer() {
                 m_error = error->code;
                 return;
             }
+
+            // The rest of the buffer belongs to the next message.
+            if (m_parser.done()) {
+                return;
+            }
         }
     }
 }
@@ -200,28 +265,29 @@ struct chunked_body_reader<BufferedReadStream>::async_read_some_op {
 
     void operator()() {
         if (reader.m_unconsumed_body_size > 0) {
-            std::size_t transferred = boost::asio::buffer_copy(
-                buffers,
-                boost::asio::buffer(reader.m_unconsumed_body, reader.m_unconsumed_body_size)
-            );
-
-            reader.m_unconsumed_body += transferred;
-            reader.m_unconsumed_body_size -= transferred;
-
-            if (reader.m_unconsumed_body_size == 0) {
-                reader.m_stream->buffer().consume(reader.m_last_parsed_part);
-            }
-
-            handler(boost::system::error_code(), transferred);
+            complete(buffers);
         } else if (reader.m_error) {
-            handler(reader.m_error, 0);
+            finish_timeouts();
+            fail(reader.m_error, buffers);
         } else {
             reader.m_error = make_error_code(httplib::reader_errc_t::eof);
-            handler(reader.m_error, 0);
+            finish_timeouts();
+            fail(reader.m_error, buffers);
         }
     }
 
     void operator()(boost::system::error_code ec, std::size_t transferred) {
+        if (auto *timeouts = reader.m_options.timeouts) {
+            // After an expiry read_body() would start the timeouts anew and hide it.
+            ec = timeouts->error(ec);
+
+            if (transferred > 0) {
+                timeouts->read_body(transferred);
+            }
+        }
+
+        reader.m_read_size.update(transferred);
+
         if (transferred > 0) {
             reader.m_stream->buffer().commit(transferred);
         }
@@ -240,7 +306,8 @@ struct chunked_body_reader<BufferedReadStream>::async_read_some_op {
                 reader.m_error = ec;
             }
 
-            handler(reader.m_error, 0);
+            finish_timeouts();
+            fail(reader.m_error, buffers);
             return;
         }
 
@@ -275,9 +342,46 @@ struct chunked_body_reader<BufferedReadStream>::async_read_some_op {
     }
 
 private:
+    template<class MutableBuffers>
+    void complete(const MutableBuffers &buffers) {
+        std::size_t transferred = boost::asio::buffer_copy(
+            buffers,
+            boost::asio::buffer(reader.m_unconsumed_body, reader.m_unconsumed_body_size)
+        );
+
+        reader.consume(transferred);
+        handler(boost::system::error_code(), transferred);
+    }
+
+    void complete(const view_tag_t &) {
+        handler(
+            boost::system::error_code(),
+            boost::asio::const_buffer(reader.m_unconsumed_body, reader.m_unconsumed_body_size)
+        );
+    }
+
+    template<class MutableBuffers>
+    void fail(boost::system::error_code ec, const MutableBuffers &) {
+        handler(ec, 0);
+    }
+
+    void fail(boost::system::error_code ec, const view_tag_t &) {
+        handler(ec, boost::asio::const_buffer());
+    }
+
+    void finish_timeouts() {
+        if (auto *timeouts = reader.m_options.timeouts) {
+            timeouts->finish();
+        }
+    }
+
     void start_async_read() {
+        if (auto *timeouts = reader.m_options.timeouts) {
+            timeouts->read_body(0);
+        }
+
         reader.m_stream->stream().async_read_some(
-            reader.m_stream->buffer().prepare(reader.m_options.read_buffer_size),
+            reader.m_stream->buffer().prepare(reader.m_read_size.get()),
             std::move(*this)
         );
     }
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/handler_alloc_hook.hpp>
+#include <boost/asio/handler_continuation_hook.hpp>
+#include <boost/asio/handler_invoke_hook.hpp>
+#include <boost/asio/write.hpp>
+
+#include <cstdlib>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+namespace detail {
+
+constexpr char chunk_separator[] = {'\r', '\n'};
+
+} // namespace detail
+
+
+template<class AsyncWriteStream>
+chunked_body_writer<AsyncWriteStream>::chunked_body_writer(AsyncWriteStream &stream, std::size_t coalesce_threshold) :
+    m_stream(&stream),
+    m_coalesce_threshold(coalesce_threshold),
+    m_pending_sent(false)
+{
+    m_pending.reserve(m_coalesce_threshold);
+}
+
+
+template<class AsyncWriteStream>
+boost::asio::io_service &chunked_body_writer<AsyncWriteStream>::get_io_service() {
+    return m_stream->get_io_service();
+}
+
+
+template<class AsyncWriteStream>
+template<class ConstBuffers, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type
+>::type
+chunked_body_writer<AsyncWriteStream>::async_write(ConstBuffers buffers, Handler handler) {
+    using handler_t = typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type;
+    using op_t = async_write_op<handler_t>;
+
+    handler_t concrete_handler = std::move(handler);
+    boost::asio::async_result<handler_t> result(concrete_handler);
+
+    buffers_t output;
+    prepare_write(buffers, output);
+    op_t(*this, boost::asio::buffer_size(buffers), std::move(concrete_handler)).start(output);
+
+    return result.get();
+}
+
+
+template<class AsyncWriteStream>
+template<class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type
+>::type
+chunked_body_writer<AsyncWriteStream>::async_flush(Handler handler) {
+    using handler_t = typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type;
+    using op_t = async_write_op<handler_t>;
+
+    handler_t concrete_handler = std::move(handler);
+    boost::asio::async_result<handler_t> result(concrete_handler);
+
+    buffers_t output;
+    prepare_flush(output);
+    op_t(*this, m_pending.size(), std::move(concrete_handler)).start(output);
+
+    return result.get();
+}
+
+
+template<class AsyncWriteStream>
+template<class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type
+>::type
+chunked_body_writer<AsyncWriteStream>::async_finish(const http_headers_t &trailers, Handler handler) {
+    using handler_t = typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type;
+    using op_t = async_write_op<handler_t>;
+
+    handler_t concrete_handler = std::move(handler);
+    boost::asio::async_result<handler_t> result(concrete_handler);
+
+    buffers_t output;
+    prepare_finish(trailers, output);
+    op_t(*this, m_pending.size(), std::move(concrete_handler)).start(output);
+
+    return result.get();
+}
+
+
+template<class AsyncWriteStream>
+template<class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type
+>::type
+chunked_body_writer<AsyncWriteStream>::async_finish(Handler handler) {
+    return async_finish(http_headers_t(), std::move(handler));
+}
+
+
+template<class AsyncWriteStream>
+template<class ConstBuffers>
+std::size_t chunked_body_writer<AsyncWriteStream>::write(ConstBuffers buffers, boost::system::error_code &ec) {
+    ec.clear();
+
+    buffers_t output;
+
+    if (prepare_write(buffers, output)) {
+        boost::asio::write(*m_stream, output, ec);
+        complete_write();
+    }
+
+    return ec ? 0 : boost::asio::buffer_size(buffers);
+}
+
+
+template<class AsyncWriteStream>
+template<class ConstBuffers>
+std::size_t chunked_body_writer<AsyncWriteStream>::write(ConstBuffers buffers) {
+    boost::system::error_code ec;
+    std::size_t result = write(buffers, ec);
+
+    if (ec) {
+        throw boost::system::system_error(ec);
+    }
+
+    return result;
+}
+
+
+template<class AsyncWriteStream>
+std::size_t chunked_body_writer<AsyncWriteStream>::flush(boost::system::error_code &ec) {
+    ec.clear();
+
+    std::size_t payload = m_pending.size();
+    buffers_t output;
+
+    if (prepare_flush(output)) {
+        boost::asio::write(*m_stream, output, ec);
+        complete_write();
+    }
+
+    return ec ? 0 : payload;
+}
+
+
+template<class AsyncWriteStream>
+std::size_t chunked_body_writer<AsyncWriteStream>::flush() {
+    boost::system::error_code ec;
+    std::size_t result = flush(ec);
+
+    if (ec) {
+        throw boost::system::system_error(ec);
+    }
+
+    return result;
+}
+
+
+template<class AsyncWriteStream>
+std::size_t chunked_body_writer<AsyncWriteStream>::finish(const http_headers_t &trailers, boost::system::error_code &ec) {
+    ec.clear();
+
+    std::size_t payload = m_pending.size();
+    buffers_t output;
+
+    prepare_finish(trailers, output);
+    boost::asio::write(*m_stream, output, ec);
+    complete_write();
+
+    return ec ? 0 : payload;
+}
+
+
+template<class AsyncWriteStream>
+std::size_t chunked_body_writer<AsyncWriteStream>::finish(const http_headers_t &trailers) {
+    boost::system::error_code ec;
+    std::size_t result = finish(trailers, ec);
+
+    if (ec) {
+        throw boost::system::system_error(ec);
+    }
+
+    return result;
+}
+
+
+// Fills the output with the buffers to send, if the write doesn't go entirely to the pending data.
+template<class AsyncWriteStream>
+template<class ConstBuffers>
+bool chunked_body_writer<AsyncWriteStream>::prepare_write(const ConstBuffers &buffers, buffers_t &output) {
+    std::size_t size = boost::asio::buffer_size(buffers);
+
+    // An empty chunk would end the body.
+    if (size == 0) {
+        return false;
+    }
+
+    if (size < m_coalesce_threshold) {
+        for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+            boost::asio::const_buffer buffer(*it);
+            m_pending.append(boost::asio::buffer_cast<const char *>(buffer), boost::asio::buffer_size(buffer));
+        }
+
+        if (m_pending.size() < m_coalesce_threshold) {
+            return false;
+        }
+
+        add_pending(output);
+        return true;
+    }
+
+    add_pending(output);
+
+    const char *size_line_end = serialize_chunk_size_line(size, m_size_line);
+    output.emplace_back(boost::asio::buffer(m_size_line, size_line_end - m_size_line));
+
+    for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+        boost::asio::const_buffer buffer(*it);
+
+        if (boost::asio::buffer_size(buffer) > 0) {
+            output.emplace_back(buffer);
+        }
+    }
+
+    output.emplace_back(boost::asio::buffer(detail::chunk_separator));
+    return true;
+}
+
+
+template<class AsyncWriteStream>
+bool chunked_body_writer<AsyncWriteStream>::prepare_flush(buffers_t &output) {
+    add_pending(output);
+    return !output.empty();
+}
+
+
+template<class AsyncWriteStream>
+void chunked_body_writer<AsyncWriteStream>::prepare_finish(const http_headers_t &trailers, buffers_t &output) {
+    add_pending(output);
+
+    m_last_chunk.clear();
+    serialize_last_chunk(trailers, m_last_chunk);
+    output.emplace_back(boost::asio::buffer(m_last_chunk));
+}
+
+
+template<class AsyncWriteStream>
+void chunked_body_writer<AsyncWriteStream>::add_pending(buffers_t &output) {
+    if (m_pending.empty()) {
+        return;
+    }
+
+    const char *size_line_end = serialize_chunk_size_line(m_pending.size(), m_pending_size_line);
+    output.emplace_back(boost::asio::buffer(m_pending_size_line, size_line_end - m_pending_size_line));
+    output.emplace_back(boost::asio::buffer(m_pending));
+    output.emplace_back(boost::asio::buffer(detail::chunk_separator));
+
+    m_pending_sent = true;
+}
+
+
+// The pending data is kept until the write completes, since the buffers reference it.
+template<class AsyncWriteStream>
+void chunked_body_writer<AsyncWriteStream>::complete_write() {
+    if (m_pending_sent) {
+        m_pending.clear();
+        m_pending_sent = false;
+    }
+}
+
+
+template<class AsyncWriteStream>
+template<class Handler>
+struct chunked_body_writer<AsyncWriteStream>::async_write_op {
+    chunked_body_writer &writer;
+    std::size_t payload;
+    Handler handler;
+
+    async_write_op(chunked_body_writer &writer, std::size_t payload, Handler handler) :
+        writer(writer),
+        payload(payload),
+        handler(std::move(handler))
+    { }
+
+    void start(const buffers_t &buffers) {
+        if (buffers.empty()) {
+            writer.get_io_service().post(std::move(*this));
+        } else {
+            boost::asio::async_write(*writer.m_stream, buffers, std::move(*this));
+        }
+    }
+
+    void operator()() {
+        handler(boost::system::error_code(), payload);
+    }
+
+    void operator()(boost::system::error_code ec, std::size_t) {
+        writer.complete_write();
+        handler(ec, ec ? 0 : payload);
+    }
+
+    friend void *asio_handler_allocate(std::size_t size, async_write_op *context) {
+        using boost::asio::asio_handler_allocate;
+        return asio_handler_allocate(size, &context->handler);
+    }
+
+    friend void asio_handler_deallocate(void *pointer, std::size_t size, async_write_op *context) {
+        using boost::asio::asio_handler_deallocate;
+        asio_handler_deallocate(pointer, size, &context->handler);
+    }
+
+    friend bool asio_handler_is_continuation(async_write_op *context) {
+        using boost::asio::asio_handler_is_continuation;
+        return asio_handler_is_continuation(&context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(Callable &function, async_write_op *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(const Callable &function, async_write_op *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+};
+
+HTTPLIB_CLOSE_NAMESPACE
@@ -0,0 +1,770 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/message_properties.hpp>
+#include <httplib/http/serialize.hpp>
+#include <httplib/asio/body_reader.hpp>
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/handler_memory.hpp>
+#include <httplib/asio/read_response.hpp>
+#include <httplib/asio/ring_buffer.hpp>
+#include <httplib/asio/timer_wheel.hpp>
+#include <httplib/error.hpp>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/handler_invoke_hook.hpp>
+#include <boost/asio/write.hpp>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <vector>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+inline http_client_metrics_t &http_client_metrics_t::operator+=(const http_client_metrics_t &other) {
+    connections_opened += other.connections_opened;
+    connections_closed += other.connections_closed;
+    requests += other.requests;
+    responses += other.responses;
+    errors += other.errors;
+    reused += other.reused;
+    pipelined += other.pipelined;
+    retried += other.retried;
+    active_connections += other.active_connections;
+    idle_connections += other.idle_connections;
+    queued_requests += other.queued_requests;
+    return *this;
+}
+
+
+namespace detail {
+
+// rfc7231, section 4.2.2.
+inline bool idempotent_method(const std::string &method) {
+    return method == "GET" ||
+           method == "HEAD" ||
+           method == "PUT" ||
+           method == "DELETE" ||
+           method == "OPTIONS" ||
+           method == "TRACE";
+}
+
+
+inline void prepare_client_request(const boost::asio::ip::tcp::endpoint &endpoint,
+                                   http_request_t &request,
+                                   const std::string &body)
+{
+    if (!request.headers.has(known_header_t::host)) {
+        auto address = endpoint.address().to_string();
+
+        if (endpoint.address().is_v6()) {
+            address = "[" + address + "]";
+        }
+
+        request.headers.set_header(known_header_t::host, {address + ":" + std::to_string(endpoint.port())});
+    }
+
+    if (!request.headers.has(known_header_t::content_length) &&
+        !request.headers.has(known_header_t::transfer_encoding) &&
+        (!body.empty() || request.method == "POST" || request.method == "PUT"))
+    {
+        request.headers.set_header(known_header_t::content_length, {std::to_string(body.size())});
+    }
+}
+
+
+// A request of http_client_t with its handler type erased, so the pools and the connections can keep it.
+// Shared, since a write may still refer to the request after it's completed.
+class client_request_t {
+public:
+    client_request_t(http_request_t request, std::string body) :
+        request(std::move(request)),
+        body(std::move(body)),
+        idempotent(idempotent_method(this->request.method)),
+        retried(false)
+    { }
+
+    virtual ~client_request_t() = default;
+
+    // Called once.
+    virtual void complete(boost::system::error_code ec, http_client_response_t response) = 0;
+
+    http_request_t request;
+    std::string body;
+    bool idempotent;
+    bool retried;
+};
+
+
+template<class Handler>
+struct client_completion_t {
+    Handler handler;
+    boost::system::error_code ec;
+    http_client_response_t response;
+
+    void operator()() {
+        handler(ec, std::move(response));
+    }
+};
+
+
+template<class Handler>
+class client_request_impl_t : public client_request_t {
+public:
+    client_request_impl_t(http_request_t request, std::string body, Handler handler) :
+        client_request_t(std::move(request), std::move(body)),
+        m_handler(std::move(handler))
+    { }
+
+    void complete(boost::system::error_code ec, http_client_response_t response) override {
+        client_completion_t<Handler> completion{std::move(m_handler), ec, std::move(response)};
+
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(completion, &completion.handler);
+    }
+
+private:
+    Handler m_handler;
+};
+
+
+class client_connection_t;
+
+
+// The connections to one host and the requests waiting for them.
+class client_pool_t : public std::enable_shared_from_this<client_pool_t> {
+public:
+    client_pool_t(boost::asio::io_service &io_service,
+                  std::shared_ptr<timer_wheel_t> timer_wheel,
+                  const http_client_options_t &options,
+                  const boost::asio::ip::tcp::endpoint &endpoint) :
+        m_io_service(io_service),
+        m_timer_wheel(std::move(timer_wheel)),
+        m_options(options),
+        m_endpoint(endpoint),
+        m_closed(false)
+    { }
+
+    boost::asio::io_service &get_io_service() {
+        return m_io_service;
+    }
+
+    timer_wheel_t &timer_wheel() {
+        return *m_timer_wheel;
+    }
+
+    const http_client_options_t &options() const {
+        return m_options;
+    }
+
+    const boost::asio::ip::tcp::endpoint &endpoint() const {
+        return m_endpoint;
+    }
+
+    // The counters, updated by the connections.
+    http_client_metrics_t &counters() {
+        return m_metrics;
+    }
+
+    http_client_metrics_t metrics() const {
+        auto result = m_metrics;
+        result.idle_connections = m_idle.size();
+        result.active_connections = m_connections.size() - m_idle.size();
+        result.queued_requests = m_queue.size();
+        return result;
+    }
+
+    void submit(std::shared_ptr<client_request_t> request) {
+        ++m_metrics.requests;
+        m_queue.push_back(std::move(request));
+        dispatch();
+    }
+
+    // Puts the request to the head of the queue. Call dispatch() afterwards.
+    void retry(std::shared_ptr<client_request_t> request) {
+        ++m_metrics.retried;
+        m_queue.push_front(std::move(request));
+    }
+
+    void complete(std::shared_ptr<client_request_t> request,
+                  boost::system::error_code ec,
+                  http_client_response_t response = http_client_response_t())
+    {
+        if (ec) {
+            ++m_metrics.errors;
+        } else {
+            ++m_metrics.responses;
+        }
+
+        request->complete(ec, std::move(response));
+    }
+
+    // Sends the queued requests on the idle connections, new connections and, with pipelining, the busy ones.
+    void dispatch();
+
+    void connection_idle(client_connection_t *connection) {
+        m_idle.push_back(connection);
+    }
+
+    void connection_closed(client_connection_t *connection);
+
+    // Closes the connections and completes all the requests with operation_aborted.
+    void close();
+
+private:
+    client_connection_t *open_connection();
+    client_connection_t *pipelining_connection();
+
+private:
+    boost::asio::io_service &m_io_service;
+    std::shared_ptr<timer_wheel_t> m_timer_wheel;
+    http_client_options_t m_options;
+    boost::asio::ip::tcp::endpoint m_endpoint;
+
+    std::vector<std::shared_ptr<client_connection_t>> m_connections;
+
+    // The most recently used connection is taken first, so the others may time out when the load drops.
+    std::vector<client_connection_t *> m_idle;
+
+    std::deque<std::shared_ptr<client_request_t>> m_queue;
+
+    http_client_metrics_t m_metrics;
+
+    bool m_closed;
+};
+
+
+// Writes the requests of a connection one after another and reads their responses in the same order.
+// A read is always pending on an open connection, an idle one included, so a connection closed by the server
+// leaves the pool right away. The pending operations keep the connection alive.
+class client_connection_t : public std::enable_shared_from_this<client_connection_t> {
+    using stream_t = buffered_read_stream<boost::asio::ip::tcp::socket &, ring_buffer_t &>;
+
+public:
+    explicit client_connection_t(std::shared_ptr<client_pool_t> pool) :
+        m_pool(std::move(pool)),
+        m_socket(m_pool->get_io_service()),
+        m_read_options(m_pool->options().read_options),
+        m_stream(m_socket, m_buffer),
+        m_timer([this] { this->expire(); }),
+        m_unwritten(0),
+        m_sent(0),
+        m_answered(0),
+        m_connected(false),
+        m_writing(false),
+        m_last_request(false),
+        m_keep_alive(false),
+        m_closed(false)
+    {
+        m_read_options.timeouts = nullptr;
+    }
+
+    std::size_t in_flight() const {
+        return m_in_flight.size();
+    }
+
+    // Whether another request may be pipelined after the ones in flight.
+    bool can_pipeline() const {
+        if (m_closed || m_last_request || m_answered == 0 ||
+            m_in_flight.size() >= m_pool->options().max_pipelined_requests)
+        {
+            return false;
+        }
+
+        return std::all_of(m_in_flight.begin(), m_in_flight.end(), [](const auto &request) {
+            return request->idempotent;
+        });
+    }
+
+    void connect() {
+        arm(m_pool->options().response_timeout);
+
+        m_socket.async_connect(m_pool->endpoint(),
+            bind_handler_memory(m_memory, [self = shared_from_this()](auto ec) {
+                self->handle_connect(ec);
+            })
+        );
+    }
+
+    void send(std::shared_ptr<client_request_t> request) {
+        auto &counters = m_pool->counters();
+
+        if (m_sent > 0) {
+            ++counters.reused;
+        }
+
+        if (!m_in_flight.empty()) {
+            ++counters.pipelined;
+        } else if (m_connected) {
+            arm(m_pool->options().response_timeout);
+        }
+
+        if (connection_status(request->request) != connection_status_t::keep_alive) {
+            m_last_request = true;
+        }
+
+        ++m_sent;
+        ++m_unwritten;
+        m_in_flight.push_back(std::move(request));
+
+        if (m_connected && !m_writing) {
+            write_request();
+        }
+    }
+
+    // Closes the connection and returns the requests in flight.
+    std::deque<std::shared_ptr<client_request_t>> abort() {
+        auto requests = std::move(m_in_flight);
+        m_in_flight.clear();
+        close();
+        return requests;
+    }
+
+private:
+    void handle_connect(boost::system::error_code ec) {
+        if (m_closed) {
+            return;
+        }
+
+        if (ec) {
+            fail(ec, false);
+            return;
+        }
+
+        m_socket.set_option(boost::asio::ip::tcp::no_delay(true), ec);
+        m_connected = true;
+
+        write_request();
+        read_response();
+    }
+
+    void write_request() {
+        if (m_unwritten == 0) {
+            return;
+        }
+
+        auto request = m_in_flight[m_in_flight.size() - m_unwritten];
+        --m_unwritten;
+
+        m_head.clear();
+        serialize_head(request->request, m_head);
+
+        std::array<boost::asio::const_buffer, 2> buffers = {{
+            boost::asio::buffer(m_head),
+            boost::asio::buffer(request->body)
+        }};
+
+        m_writing = true;
+
+        boost::asio::async_write(m_socket, buffers,
+            bind_handler_memory(m_memory, [self = shared_from_this(), request = std::move(request)](auto ec, std::size_t) {
+                self->handle_write(ec);
+            })
+        );
+    }
+
+    void handle_write(boost::system::error_code ec) {
+        m_writing = false;
+
+        if (m_closed) {
+            return;
+        }
+
+        if (ec) {
+            fail(ec, m_answered > 0);
+        } else {
+            write_request();
+        }
+    }
+
+    void read_response() {
+        async_read_response(m_stream, m_read_options,
+            bind_handler_memory(m_memory, [self = shared_from_this()](auto ec, http_response_t response) {
+                self->handle_response(ec, std::move(response));
+            })
+        );
+    }
+
+    void handle_response(boost::system::error_code ec, http_response_t response) {
+        if (m_closed) {
+            return;
+        }
+
+        if (ec) {
+            if (m_in_flight.empty()) {
+                // Closed by the server while idle.
+                close();
+            } else {
+                bool dropped = ec == boost::asio::error::eof || ec == boost::asio::error::connection_reset;
+                fail(ec, dropped && m_answered > 0);
+            }
+
+            return;
+        }
+
+        if (m_in_flight.empty()) {
+            close();
+            return;
+        }
+
+        if (m_unwritten == m_in_flight.size()) {
+            fail(client_errc_t::bad_response, false);
+            return;
+        }
+
+        // An interim response goes before the final one.
+        if (response.code >= 100 && response.code < 200 && response.code != 101) {
+            read_response();
+            return;
+        }
+
+        const auto &request = m_in_flight.front()->request;
+        auto reader = make_body_reader(response, request, m_stream, m_read_options);
+
+        if (!reader) {
+            fail(client_errc_t::bad_response, false);
+            return;
+        }
+
+        auto size = body_size(response, request);
+
+        m_keep_alive = response.code != 101 &&
+                       size && size->type != body_size_t::type_t::until_eof &&
+                       connection_status(response) == connection_status_t::keep_alive &&
+                       connection_status(request) == connection_status_t::keep_alive;
+
+        m_response.response = std::move(response);
+        m_response.body.clear();
+        m_body_reader = std::move(*reader);
+
+        read_body();
+    }
+
+    void read_body() {
+        m_body_reader.async_read_some(boost::asio::buffer(m_read_buffer),
+            bind_handler_memory(m_memory, [self = shared_from_this()](auto ec, std::size_t transferred) {
+                self->handle_body(ec, transferred);
+            })
+        );
+    }
+
+    void handle_body(boost::system::error_code ec, std::size_t transferred) {
+        if (m_closed) {
+            return;
+        }
+
+        m_response.body.append(m_read_buffer.data(), transferred);
+
+        if (m_response.body.size() > m_pool->options().max_body_size) {
+            fail(client_errc_t::body_too_large, false);
+        } else if (ec == reader_errc_t::eof) {
+            finish_response();
+        } else if (ec) {
+            fail(ec, false);
+        } else {
+            read_body();
+        }
+    }
+
+    // The pool and the connection are brought up to date before the handler is called,
+    // so the handler may send new requests right away.
+    void finish_response() {
+        auto request = std::move(m_in_flight.front());
+        m_in_flight.pop_front();
+        ++m_answered;
+
+        auto response = std::move(m_response);
+
+        if (m_keep_alive) {
+            if (m_in_flight.empty()) {
+                arm(m_pool->options().idle_timeout);
+                m_pool->connection_idle(this);
+            } else {
+                arm(m_pool->options().response_timeout);
+            }
+
+            read_response();
+            m_pool->dispatch();
+        } else {
+            // The requests pipelined after this one won't be answered.
+            fail(boost::asio::error::eof, true);
+        }
+
+        m_pool->complete(std::move(request), boost::system::error_code(), std::move(response));
+    }
+
+    // Closes the connection. The idempotent requests which haven't been retried yet are sent again,
+    // the first one in flight only if retry_front is set. The others complete with the error.
+    void fail(boost::system::error_code ec, bool retry_front) {
+        auto requests = std::move(m_in_flight);
+        m_in_flight.clear();
+        close();
+
+        for (auto it = requests.rbegin(); it != requests.rend(); ++it) {
+            auto &request = *it;
+            bool front = std::next(it) == requests.rend();
+
+            if ((retry_front || !front) && request->idempotent && !request->retried) {
+                request->retried = true;
+                m_pool->retry(std::move(request));
+            }
+        }
+
+        m_pool->dispatch();
+
+        for (auto &request: requests) {
+            if (request) {
+                m_pool->complete(std::move(request), ec);
+            }
+        }
+    }
+
+    void expire() {
+        if (m_in_flight.empty()) {
+            close();
+        } else {
+            fail(boost::asio::error::timed_out, false);
+        }
+    }
+
+    void arm(std::chrono::milliseconds timeout) {
+        if (timeout.count() > 0) {
+            m_pool->timer_wheel().arm(m_timer, timeout);
+        } else {
+            m_timer.cancel();
+        }
+    }
+
+    void close() {
+        if (m_closed) {
+            return;
+        }
+
+        m_closed = true;
+        m_timer.cancel();
+
+        boost::system::error_code ec;
+        m_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+        m_socket.close(ec);
+
+        m_pool->connection_closed(this);
+    }
+
+private:
+    // Destroyed last: it keeps the timer wheel alive.
+    std::shared_ptr<client_pool_t> m_pool;
+
+    // Memory for the operations of the connection, so they don't allocate.
+    handler_memory_t m_memory;
+
+    boost::asio::ip::tcp::socket m_socket;
+    read_options_t m_read_options;
+
+    ring_buffer_t m_buffer;
+    stream_t m_stream;
+
+    // The response timeout while requests are in flight, the idle timeout otherwise.
+    timer_wheel_t::timer_t m_timer;
+
+    // The requests sent or waiting to be written, in order. The last m_unwritten haven't been written yet.
+    std::deque<std::shared_ptr<client_request_t>> m_in_flight;
+    std::size_t m_unwritten;
+    std::string m_head;
+
+    std::size_t m_sent;
+    std::size_t m_answered;
+
+    body_reader<stream_t> m_body_reader;
+    std::array<char, 4 * 1024> m_read_buffer;
+    http_client_response_t m_response;
+
+    bool m_connected;
+    bool m_writing;
+
+    // Whether a request asked to close the connection, so nothing may be sent after it.
+    bool m_last_request;
+
+    // Whether the connection stays open after the current response.
+    bool m_keep_alive;
+
+    bool m_closed;
+};
+
+
+inline void client_pool_t::dispatch() {
+    while (!m_closed && !m_queue.empty()) {
+        client_connection_t *connection = nullptr;
+
+        if (!m_idle.empty()) {
+            connection = m_idle.back();
+            m_idle.pop_back();
+        } else if (m_connections.size() < std::max<std::size_t>(m_options.max_connections_per_host, 1)) {
+            connection = open_connection();
+        } else if (m_options.max_pipelined_requests > 1 && m_queue.front()->idempotent) {
+            connection = pipelining_connection();
+        }
+
+        if (!connection) {
+            break;
+        }
+
+        auto request = std::move(m_queue.front());
+        m_queue.pop_front();
+        connection->send(std::move(request));
+    }
+}
+
+inline void client_pool_t::connection_closed(client_connection_t *connection) {
+    ++m_metrics.connections_closed;
+
+    m_idle.erase(std::remove(m_idle.begin(), m_idle.end(), connection), m_idle.end());
+
+    auto it = std::find_if(m_connections.begin(), m_connections.end(), [connection](const auto &item) {
+        return item.get() == connection;
+    });
+
+    if (it != m_connections.end()) {
+        std::swap(*it, m_connections.back());
+        m_connections.pop_back();
+    }
+}
+
+inline void client_pool_t::close() {
+    m_closed = true;
+
+    auto connections = std::move(m_connections);
+    m_connections.clear();
+    m_idle.clear();
+
+    std::deque<std::shared_ptr<client_request_t>> requests;
+
+    for (auto &connection: connections) {
+        for (auto &request: connection->abort()) {
+            requests.push_back(std::move(request));
+        }
+    }
+
+    for (auto &request: m_queue) {
+        requests.push_back(std::move(request));
+    }
+
+    m_queue.clear();
+
+    // Not called right away, since close() may be called by a handler of the client or by its destructor.
+    for (auto &request: requests) {
+        ++m_metrics.errors;
+
+        m_io_service.post([request] {
+            request->complete(boost::asio::error::operation_aborted, http_client_response_t());
+        });
+    }
+}
+
+inline client_connection_t *client_pool_t::open_connection() {
+    auto connection = std::make_shared<client_connection_t>(shared_from_this());
+    m_connections.push_back(connection);
+    ++m_metrics.connections_opened;
+
+    connection->connect();
+
+    return connection.get();
+}
+
+inline client_connection_t *client_pool_t::pipelining_connection() {
+    client_connection_t *result = nullptr;
+
+    for (const auto &connection: m_connections) {
+        if (connection->can_pipeline() && (!result || connection->in_flight() < result->in_flight())) {
+            result = connection.get();
+        }
+    }
+
+    return result;
+}
+
+} // namespace detail
+
+
+inline http_client_t::http_client_t(boost::asio::io_service &io_service, http_client_options_t options) :
+    m_io_service(io_service),
+    m_options(std::move(options)),
+    m_timer_wheel(std::make_shared<timer_wheel_t>(io_service, m_options.timeout_resolution))
+{ }
+
+inline http_client_t::~http_client_t() {
+    close();
+}
+
+template<class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_client_response_t&)>::type
+>::type
+http_client_t::async_request(const boost::asio::ip::tcp::endpoint &endpoint,
+                             http_request_t request,
+                             std::string body,
+                             Handler handler)
+{
+    using handler_t = typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_client_response_t&)>::type;
+    using request_t = detail::client_request_impl_t<handler_t>;
+
+    handler_t concrete_handler = std::move(handler);
+    boost::asio::async_result<handler_t> result(concrete_handler);
+
+    detail::prepare_client_request(endpoint, request, body);
+    start_request(endpoint, std::make_shared<request_t>(std::move(request), std::move(body), std::move(concrete_handler)));
+
+    return result.get();
+}
+
+template<class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_client_response_t&)>::type
+>::type
+http_client_t::async_request(const boost::asio::ip::tcp::endpoint &endpoint, http_request_t request, Handler handler) {
+    return async_request(endpoint, std::move(request), std::string(), std::move(handler));
+}
+
+inline void http_client_t::close() {
+    for (auto &pool: m_pools) {
+        pool.second->close();
+    }
+
+    m_pools.clear();
+}
+
+inline http_client_metrics_t http_client_t::metrics() const {
+    http_client_metrics_t result;
+
+    for (const auto &pool: m_pools) {
+        result += pool.second->metrics();
+    }
+
+    return result;
+}
+
+inline http_client_metrics_t http_client_t::metrics(const boost::asio::ip::tcp::endpoint &endpoint) const {
+    auto it = m_pools.find(endpoint);
+
+    if (it == m_pools.end()) {
+        return {};
+    }
+
+    return it->second->metrics();
+}
+
+inline void http_client_t::start_request(const boost::asio::ip::tcp::endpoint &endpoint,
+                                         std::shared_ptr<detail::client_request_t> request)
+{
+    auto &pool = m_pools[endpoint];
+
+    if (!pool) {
+        pool = std::make_shared<detail::client_pool_t>(m_io_service, m_timer_wheel, m_options, endpoint);
+    }
+
+    pool->submit(std::move(request));
+}
+
+HTTPLIB_CLOSE_NAMESPACE
@@ -28,6 +28,7 @@ eof_body_reader<BufferedReadStream>::eof_body_reader(BufferedReadStream &stream,
 template<class BufferedReadStream>
 void eof_body_reader<BufferedReadStream>::set_options(read_options_t options) {
     m_options = options;
+    m_read_size = read_size_t(m_options);
 }
 
 
@@ -62,14 +63,24 @@ template<class MutableBuffers>
 std::size_t eof_body_reader<BufferedReadStream>::read_some(MutableBuffers buffers, boost::system::error_code &ec) {
     if (boost::asio::buffer_size(buffers) == 0) {
         return 0;
+    } else if (m_stream->buffer().size() == 0 && boost::asio::buffer_size(buffers) >= m_options.read_buffer_size) {
+        boost::system::error_code read_error;
+        std::size_t transferred = m_stream->stream().read_some(buffers, read_error);
+
+        if (transferred == 0 && read_error) {
+            ec = make_error_code(httplib::reader_errc_t::eof);
+        }
+
+        return transferred;
     } else {
         if (m_stream->buffer().size() == 0) {
             boost::system::error_code read_error;
             std::size_t transferred = m_stream->stream().read_some(
-                m_stream->buffer().prepare(m_options.read_buffer_size),
+                m_stream->buffer().prepare(m_read_size.get()),
                 read_error
             );
 
+            m_read_size.update(transferred);
             m_stream->buffer().commit(transferred);
 
             // FIXME: Shouldn't it return error even if there's some data?
@@ -108,18 +119,25 @@ struct eof_body_reader<BufferedReadStream>::async_read_some_op {
     Buffers buffers;
     Handler handler;
 
+    // Whether the pending read is into the caller's buffers.
+    bool direct;
+
     async_read_some_op(eof_body_reader &reader, Buffers buffers, Handler handler) :
         reader(reader),
         buffers(buffers),
-        handler(std::move(handler))
+        handler(std::move(handler)),
+        direct(false)
     { }
 
     void start() {
         if (reader.m_stream->buffer().size() != 0 || boost::asio::buffer_size(buffers) == 0){
             reader.m_stream->stream().get_io_service().post(std::move(*this));
+        } else if (boost::asio::buffer_size(buffers) >= reader.m_options.read_buffer_size) {
+            direct = true;
+            reader.m_stream->stream().async_read_some(buffers, std::move(*this));
         } else {
             reader.m_stream->stream().async_read_some(
-                reader.m_stream->buffer().prepare(reader.m_options.read_buffer_size),
+                reader.m_stream->buffer().prepare(reader.m_read_size.get()),
                 std::move(*this)
             );
         }
@@ -132,6 +150,20 @@ struct eof_body_reader<BufferedReadStream>::async_read_some_op {
     }
 
     void operator()(boost::system::error_code ec, std::size_t transferred) {
+        if (direct) {
+            if (transferred > 0) {
+                handler(boost::system::error_code(), transferred);
+            } else if (ec) {
+                handler(make_error_code(httplib::reader_errc_t::eof), 0);
+            } else {
+                handler(make_error_code(boost::asio::error::try_again), 0);
+            }
+
+            return;
+        }
+
+        reader.m_read_size.update(transferred);
+
         if (transferred > 0) {
             reader.m_stream->buffer().commit(transferred);
         }
@@ -2,45 +2,138 @@
 
 #include <httplib/detail/common.hpp>
 #include <httplib/http/request.hpp>
+#include <httplib/asio/connection_timeouts.hpp>
 #include <httplib/asio/read_options.hpp>
+#include <httplib/asio/ring_buffer.hpp>
 #include <httplib/parser/request_parser.hpp>
 
 #include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
 #include <boost/asio/handler_alloc_hook.hpp>
 #include <boost/asio/handler_continuation_hook.hpp>
 #include <boost/asio/handler_invoke_hook.hpp>
 
+#include <cassert>
 #include <cstdlib>
+#include <new>
+#include <type_traits>
 
 
 HTTPLIB_OPEN_NAMESPACE
 
 namespace detail {
 
-template<class BufferedReadStream, class Handler>
+// Parser is either http_request_parser_t owned by the operation or a reference to the caller's one.
+// The request is moved out of an owned parser into the handler, the caller's parser is left intact.
+// The state of the operation, the parser included, is allocated once through the handler's allocation hook,
+// so only a pointer is moved into every read of the stream however many reads the head takes.
+// asio requires handlers to be copyable, so copies of the operation share the state.
+template<class BufferedReadStream, class Handler, class Parser = http_request_parser_t>
 struct async_read_request_op {
-    BufferedReadStream &stream;
-    read_options_t options;
-    Handler handler;
+    using request_reference_t = std::conditional_t<
+        std::is_reference<Parser>::value,
+        const http_request_t &,
+        http_request_t &&
+    >;
 
-    http_request_parser_t parser;
+    // What the request is kept in between releasing the state and calling the handler.
+    using request_storage_t = std::conditional_t<
+        std::is_reference<Parser>::value,
+        const http_request_t &,
+        http_request_t
+    >;
+
+    struct state_t {
+        BufferedReadStream &stream;
+        read_options_t options;
+        Handler handler;
+
+        Parser parser;
+
+        read_size_t read_size;
+
+        // Whether the pending read is a null_buffers probe.
+        bool probing;
+
+        // The number of copies of the operation referring to the state.
+        std::size_t owners;
+
+        state_t(BufferedReadStream &stream, read_options_t options, Handler &&handler, Parser &&parser) :
+            stream(stream),
+            options(options),
+            handler(std::move(handler)),
+            parser(std::forward<Parser>(parser)),
+            read_size(options),
+            probing(false),
+            owners(1)
+        { }
+    };
+
+    state_t *state;
 
 
     async_read_request_op(BufferedReadStream &stream,
                           read_options_t options,
-                          Handler handler) :
-        stream(stream),
-        options(options),
-        handler(std::move(handler))
+                          Handler handler,
+                          Parser &&parser = Parser()) :
+        state(nullptr)
     {
-        parser.set_options(options.parsing);
+        using boost::asio::asio_handler_allocate;
+        using boost::asio::asio_handler_deallocate;
+
+        void *memory = asio_handler_allocate(sizeof(state_t), &handler);
+
+        try {
+            state = new (memory) state_t(stream, options, std::move(handler), std::forward<Parser>(parser));
+        } catch (...) {
+            asio_handler_deallocate(memory, sizeof(state_t), &handler);
+            throw;
+        }
+    }
+
+    async_read_request_op(const async_read_request_op &other) :
+        state(other.state)
+    {
+        if (state) {
+            ++state->owners;
+        }
+    }
+
+    async_read_request_op(async_read_request_op &&other) :
+        state(other.state)
+    {
+        other.state = nullptr;
+    }
+
+    async_read_request_op &operator=(const async_read_request_op &) = delete;
+
+    // The last copy is destroyed without completing, e.g. with the io_service.
+    ~async_read_request_op() {
+        if (state && state->owners == 1) {
+            Handler handler = std::move(state->handler);
+            release(handler);
+        } else if (state) {
+            --state->owners;
+        }
     }
 
     void start() {
-        if (stream.buffer().size() != 0) {
+        state->parser.reset();
+        state->parser.set_options(state->options.parsing);
+
+        if (auto *timeouts = state->options.timeouts) {
+            if (state->stream.buffer().size() != 0) {
+                timeouts->read_head();
+            } else {
+                timeouts->wait_message();
+            }
+        }
+
+        if (state->stream.buffer().size() != 0) {
             consume_buffer();
 
-            if (parser.done()) {
+            if (state->parser.done()) {
+                auto &stream = state->stream;
                 stream.stream().get_io_service().post(std::move(*this));
                 return;
             }
@@ -50,31 +143,48 @@ struct async_read_request_op {
     }
 
     void operator()() {
-        assert(parser.done());
-
-        if (parser.error()) {
-            handler(parser.error(), http_request_t());
-        } else {
-            handler(boost::system::error_code(), parser.request());
-        }
+        assert(state->parser.done());
+        complete(state->parser.error());
     }
 
     void operator()(boost::system::error_code ec, std::size_t transferred) {
+        if (auto *timeouts = state->options.timeouts) {
+            ec = timeouts->error(ec);
+
+            if (transferred > 0) {
+                timeouts->read_head();
+            }
+        }
+
+        if (state->probing) {
+            state->probing = false;
+
+            if (ec) {
+                complete(ec);
+            } else {
+                async_read();
+            }
+
+            return;
+        }
+
+        state->read_size.update(transferred);
+
         if (transferred > 0) {
-            stream.buffer().commit(transferred);
+            state->stream.buffer().commit(transferred);
         }
 
-        if (stream.buffer().size() != 0) {
+        if (state->stream.buffer().size() != 0) {
             consume_buffer();
 
-            if (parser.done()) {
+            if (state->parser.done()) {
                 (*this)();
                 return;
             }
         }
 
         if (ec) {
-            handler(ec, http_request_t());
+            complete(ec);
             return;
         }
 
@@ -83,33 +193,65 @@ struct async_read_request_op {
 
     friend void *asio_handler_allocate(std::size_t size, async_read_request_op *context) {
         using boost::asio::asio_handler_allocate;
-        return asio_handler_allocate(size, &context->handler);
+        return asio_handler_allocate(size, &context->state->handler);
     }
 
     friend void asio_handler_deallocate(void *pointer, std::size_t size, async_read_request_op *context) {
         using boost::asio::asio_handler_deallocate;
-        asio_handler_deallocate(pointer, size, &context->handler);
+        asio_handler_deallocate(pointer, size, &context->state->handler);
     }
 
     friend bool asio_handler_is_continuation(async_read_request_op *context) {
         using boost::asio::asio_handler_is_continuation;
-        return asio_handler_is_continuation(&context->handler);
+        return asio_handler_is_continuation(&context->state->handler);
     }
 
     template<class Callable>
     friend void asio_handler_invoke(Callable &function, async_read_request_op *context) {
         using boost::asio::asio_handler_invoke;
-        asio_handler_invoke(function, &context->handler);
+        asio_handler_invoke(function, &context->state->handler);
     }
 
     template<class Callable>
     friend void asio_handler_invoke(const Callable &function, async_read_request_op *context) {
         using boost::asio::asio_handler_invoke;
-        asio_handler_invoke(function, &context->handler);
+        asio_handler_invoke(function, &context->state->handler);
     }
 
 private:
+    // Frees the state before calling the handler, so the handler may start another operation with the same memory.
+    void complete(boost::system::error_code ec) {
+        if (auto *timeouts = state->options.timeouts) {
+            timeouts->finish();
+        }
+
+        Handler handler = std::move(state->handler);
+
+        if (ec) {
+            release(handler);
+            handler(ec, http_request_t());
+        } else {
+            request_storage_t request = static_cast<request_reference_t>(state->parser.request());
+            release(handler);
+            handler(ec, static_cast<request_reference_t>(request));
+        }
+    }
+
+    void release(Handler &handler) {
+        using boost::asio::asio_handler_deallocate;
+
+        if (--state->owners == 0) {
+            state->~state_t();
+            asio_handler_deallocate(state, sizeof(state_t), &handler);
+        }
+
+        state = nullptr;
+    }
+
     void consume_buffer() {
+        auto &stream = state->stream;
+        auto &parser = state->parser;
+
         if (stream.buffer().size() == 0) {
             return;
         }
@@ -138,8 +280,22 @@ private:
     }
 
     void start_async_read() {
+        if (state->options.probe_before_read && state->stream.buffer().size() == 0) {
+            auto &stream = state->stream;
+
+            release_read_buffer(stream.buffer());
+            state->probing = true;
+            stream.stream().async_read_some(boost::asio::null_buffers(), std::move(*this));
+        } else {
+            async_read();
+        }
+    }
+
+    void async_read() {
+        auto &stream = state->stream;
+
         stream.stream().async_read_some(
-            stream.buffer().prepare(options.read_buffer_size),
+            stream.buffer().prepare(state->read_size.get()),
             std::move(*this)
         );
     }
@@ -173,14 +329,46 @@ async_read_request(BufferedReadStream &stream, Handler handler) {
     return async_read_request(stream, {}, std::move(handler));
 }
 
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_request_t&)>::type
+>::type
+async_read_request(BufferedReadStream &stream,
+                   http_request_parser_t &parser,
+                   read_options_t options,
+                   Handler handler)
+{
+    using handler_t = typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_request_t&)>::type;
+    using op_t = detail::async_read_request_op<BufferedReadStream, handler_t, http_request_parser_t &>;
+
+    handler_t concrete_handler = std::move(handler);
+    boost::asio::async_result<handler_t> result(concrete_handler);
+    op_t op(stream, options, std::move(concrete_handler), parser);
+
+    op.start();
+
+    return result.get();
+}
+
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_request_t&)>::type
+>::type
+async_read_request(BufferedReadStream &stream, http_request_parser_t &parser, Handler handler) {
+    return async_read_request(stream, parser, {}, std::move(handler));
+}
+
 template<class BufferedReadStream>
-http_request_t read_request(BufferedReadStream &stream,
-                            read_options_t options,
-                            boost::system::error_code &ec)
+const http_request_t &read_request(BufferedReadStream &stream,
+                                   http_request_parser_t &parser,
+                                   read_options_t options,
+                                   boost::system::error_code &ec)
 {
-    http_request_parser_t parser;
+    parser.reset();
     parser.set_options(options.parsing);
 
+    read_size_t read_size(options);
+
     while (true) {
         auto buffers = stream.buffer().data();
 
@@ -195,31 +383,55 @@ http_request_t read_request(BufferedReadStream &stream,
             stream.buffer().consume(parsed);
 
             if (parser.done()) {
-                if (parser.error()) {
-                    ec = parser.error();
-                    return {};
-                } else {
-                    return parser.request();
-                }
+                ec = parser.error();
+                return parser.request();
             }
         }
 
         boost::system::error_code read_error;
 
         std::size_t transferred = stream.stream().read_some(
-            stream.buffer().prepare(options.read_buffer_size),
+            stream.buffer().prepare(read_size.get()),
             read_error
         );
 
+        read_size.update(transferred);
         stream.buffer().commit(transferred);
 
         if (transferred == 0 && read_error) {
             ec = read_error;
-            return {};
+            return parser.request();
         }
     }
 }
 
+template<class BufferedReadStream>
+const http_request_t &read_request(BufferedReadStream &stream, http_request_parser_t &parser, read_options_t options) {
+    boost::system::error_code ec;
+    const http_request_t &result = read_request(stream, parser, std::move(options), ec);
+
+    if (ec) {
+        throw boost::system::system_error(ec);
+    }
+
+    return result;
+}
+
+template<class BufferedReadStream>
+http_request_t read_request(BufferedReadStream &stream,
+                            read_options_t options,
+                            boost::system::error_code &ec)
+{
+    http_request_parser_t parser;
+    read_request(stream, parser, std::move(options), ec);
+
+    if (ec) {
+        return {};
+    }
+
+    return std::move(parser.request());
+}
+
 template<class BufferedReadStream>
 http_request_t read_request(BufferedReadStream &stream, boost::system::error_code &ec) {
     return read_request(stream, read_options_t(), ec);
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/request_view.hpp>
+#include <httplib/asio/read_options.hpp>
+#include <httplib/asio/ring_buffer.hpp>
+#include <httplib/parser/request_view_parser.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/handler_alloc_hook.hpp>
+#include <boost/asio/handler_continuation_hook.hpp>
+#include <boost/asio/handler_invoke_hook.hpp>
+
+#include <cstdlib>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+namespace detail {
+
+// Feeds the buffered data to the parser one buffer at a time.
+// The consumed data stays in memory until the next prepare() on the buffer, so the view remains valid.
+template<class BufferedReadStream>
+void consume_request_view(BufferedReadStream &stream, http_request_view_parser_t &parser) {
+    auto buffers = stream.buffer().data();
+
+    for (const auto &buf: buffers) {
+        auto const_buffer = boost::asio::const_buffer(buf);
+
+        while (boost::asio::buffer_size(const_buffer) > 0) {
+            size_t parsed = parser.parse(boost::asio::buffer_cast<const char *>(const_buffer),
+                                         boost::asio::buffer_size(const_buffer));
+
+            const_buffer = boost::asio::const_buffer(
+                boost::asio::buffer_cast<const char *>(const_buffer) + parsed,
+                boost::asio::buffer_size(const_buffer) - parsed
+            );
+
+            stream.buffer().consume(parsed);
+
+            if (parser.done()) {
+                return;
+            }
+        }
+    }
+}
+
+
+template<class BufferedReadStream, class Handler>
+struct async_read_request_view_op {
+    BufferedReadStream &stream;
+    read_options_t options;
+    Handler handler;
+
+    http_request_view_parser_t parser;
+
+    read_size_t read_size;
+
+    // Whether the pending read is a null_buffers probe.
+    bool probing;
+
+
+    async_read_request_view_op(BufferedReadStream &stream,
+                               read_options_t options,
+                               Handler handler) :
+        stream(stream),
+        options(options),
+        handler(std::move(handler)),
+        read_size(options),
+        probing(false)
+    {
+        parser.set_options(options.parsing);
+    }
+
+    void start() {
+        if (stream.buffer().size() != 0) {
+            consume_request_view(stream, parser);
+
+            if (parser.done()) {
+                stream.stream().get_io_service().post(std::move(*this));
+                return;
+            }
+        }
+
+        start_async_read();
+    }
+
+    void operator()() {
+        assert(parser.done());
+
+        if (parser.error()) {
+            handler(parser.error(), http_request_view_t());
+        } else {
+            handler(boost::system::error_code(), parser.request());
+        }
+    }
+
+    void operator()(boost::system::error_code ec, std::size_t transferred) {
+        if (probing) {
+            probing = false;
+
+            if (ec) {
+                handler(ec, http_request_view_t());
+            } else {
+                async_read();
+            }
+
+            return;
+        }
+
+        read_size.update(transferred);
+
+        if (transferred > 0) {
+            stream.buffer().commit(transferred);
+        }
+
+        if (stream.buffer().size() != 0) {
+            consume_request_view(stream, parser);
+
+            if (parser.done()) {
+                (*this)();
+                return;
+            }
+        }
+
+        if (ec) {
+            handler(ec, http_request_view_t());
+            return;
+        }
+
+        start_async_read();
+    }
+
+    friend void *asio_handler_allocate(std::size_t size, async_read_request_view_op *context) {
+        using boost::asio::asio_handler_allocate;
+        return asio_handler_allocate(size, &context->handler);
+    }
+
+    friend void asio_handler_deallocate(void *pointer, std::size_t size, async_read_request_view_op *context) {
+        using boost::asio::asio_handler_deallocate;
+        asio_handler_deallocate(pointer, size, &context->handler);
+    }
+
+    friend bool asio_handler_is_continuation(async_read_request_view_op *context) {
+        using boost::asio::asio_handler_is_continuation;
+        return asio_handler_is_continuation(&context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(Callable &function, async_read_request_view_op *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(const Callable &function, async_read_request_view_op *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+
+private:
+    void start_async_read() {
+        if (options.probe_before_read && stream.buffer().size() == 0) {
+            release_read_buffer(stream.buffer());
+            probing = true;
+            stream.stream().async_read_some(boost::asio::null_buffers(), std::move(*this));
+        } else {
+            async_read();
+        }
+    }
+
+    void async_read() {
+        stream.stream().async_read_some(
+            stream.buffer().prepare(read_size.get()),
+            std::move(*this)
+        );
+    }
+};
+
+} // namespace detail
+
+
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_request_view_t&)>::type
+>::type
+async_read_request_view(BufferedReadStream &stream, read_options_t options, Handler handler) {
+    using handler_t = typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_request_view_t&)>::type;
+    using op_t = detail::async_read_request_view_op<BufferedReadStream, handler_t>;
+
+    handler_t concrete_handler = std::move(handler);
+    boost::asio::async_result<handler_t> result(concrete_handler);
+    op_t op(stream, options, std::move(concrete_handler));
+
+    op.start();
+
+    return result.get();
+}
+
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_request_view_t&)>::type
+>::type
+async_read_request_view(BufferedReadStream &stream, Handler handler) {
+    return async_read_request_view(stream, {}, std::move(handler));
+}
+
+template<class BufferedReadStream>
+const http_request_view_t &read_request_view(BufferedReadStream &stream,
+                                             http_request_view_parser_t &parser,
+                                             read_options_t options,
+                                             boost::system::error_code &ec)
+{
+    parser.reset();
+    parser.set_options(options.parsing);
+
+    read_size_t read_size(options);
+
+    while (true) {
+        detail::consume_request_view(stream, parser);
+
+        if (parser.done()) {
+            ec = parser.error();
+            return parser.request();
+        }
+
+        boost::system::error_code read_error;
+
+        std::size_t transferred = stream.stream().read_some(
+            stream.buffer().prepare(read_size.get()),
+            read_error
+        );
+
+        read_size.update(transferred);
+        stream.buffer().commit(transferred);
+
+        if (transferred == 0 && read_error) {
+            ec = read_error;
+            return parser.request();
+        }
+    }
+}
+
+template<class BufferedReadStream>
+const http_request_view_t &read_request_view(BufferedReadStream &stream,
+                                             http_request_view_parser_t &parser,
+                                             read_options_t options)
+{
+    boost::system::error_code ec;
+    const http_request_view_t &result = read_request_view(stream, parser, std::move(options), ec);
+
+    if (ec) {
+        throw boost::system::system_error(ec);
+    }
+
+    return result;
+}
+
+HTTPLIB_CLOSE_NAMESPACE
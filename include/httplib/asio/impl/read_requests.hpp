@@ -0,0 +1,318 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/message_properties.hpp>
+#include <httplib/http/request.hpp>
+#include <httplib/asio/read_options.hpp>
+#include <httplib/asio/ring_buffer.hpp>
+#include <httplib/parser/request_parser.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/handler_alloc_hook.hpp>
+#include <boost/asio/handler_continuation_hook.hpp>
+#include <boost/asio/handler_invoke_hook.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+namespace detail {
+
+inline bool has_body(const http_request_t &request) {
+    auto size = body_size(request);
+
+    // A request with invalid framing ends the batch too, the caller will fail to read its body.
+    return !size || size->type != body_size_t::type_t::content_length || size->content_length != 0;
+}
+
+
+// Prepares the parser for the next batch.
+// Returns false if the parser has failed on the previous call.
+inline bool start_requests_batch(http_request_parser_t &parser,
+                                 std::vector<http_request_t> &requests,
+                                 const read_options_t &options)
+{
+    requests.clear();
+
+    if (parser.done()) {
+        if (parser.error()) {
+            return false;
+        }
+
+        parser.reset();
+    }
+
+    parser.set_options(options.parsing);
+
+    return true;
+}
+
+
+// Parses the buffered data until it runs out, a request with a body is parsed or an error occurs.
+template<class BufferedReadStream>
+void consume_requests(BufferedReadStream &stream,
+                      http_request_parser_t &parser,
+                      std::vector<http_request_t> &requests)
+{
+    while (stream.buffer().size() != 0 && !parser.done()) {
+        auto buffers = stream.buffer().data();
+
+        for (auto it = buffers.begin(); it != buffers.end() && !parser.done(); ++it) {
+            auto const_buffer = boost::asio::const_buffer(*it);
+
+            while (boost::asio::buffer_size(const_buffer) > 0 && !parser.done()) {
+                std::size_t parsed = parser.parse(boost::asio::buffer_cast<const char *>(const_buffer),
+                                                  boost::asio::buffer_size(const_buffer));
+
+                const_buffer = boost::asio::const_buffer(
+                    boost::asio::buffer_cast<const char *>(const_buffer) + parsed,
+                    boost::asio::buffer_size(const_buffer) - parsed
+                );
+
+                stream.buffer().consume(parsed);
+            }
+        }
+
+        if (parser.done() && !parser.error()) {
+            requests.push_back(std::move(parser.request()));
+
+            if (has_body(requests.back())) {
+                return;
+            }
+
+            parser.reset();
+        }
+    }
+}
+
+
+template<class BufferedReadStream, class Handler>
+struct async_read_requests_op {
+    BufferedReadStream &stream;
+    http_request_parser_t &parser;
+    std::vector<http_request_t> &requests;
+    read_options_t options;
+    Handler handler;
+
+    read_size_t read_size;
+
+    // Whether the pending read is a null_buffers probe.
+    bool probing;
+
+
+    async_read_requests_op(BufferedReadStream &stream,
+                           http_request_parser_t &parser,
+                           std::vector<http_request_t> &requests,
+                           read_options_t options,
+                           Handler handler) :
+        stream(stream),
+        parser(parser),
+        requests(requests),
+        options(options),
+        handler(std::move(handler)),
+        read_size(options),
+        probing(false)
+    { }
+
+    void start() {
+        if (!start_requests_batch(parser, requests, options)) {
+            stream.stream().get_io_service().post(std::move(*this));
+            return;
+        }
+
+        consume_requests(stream, parser, requests);
+
+        if (!requests.empty() || parser.done()) {
+            stream.stream().get_io_service().post(std::move(*this));
+            return;
+        }
+
+        start_async_read();
+    }
+
+    void operator()() {
+        if (requests.empty()) {
+            handler(parser.error());
+        } else {
+            handler(boost::system::error_code());
+        }
+    }
+
+    void operator()(boost::system::error_code ec, std::size_t transferred) {
+        if (probing) {
+            probing = false;
+
+            if (ec) {
+                handler(ec);
+            } else {
+                async_read();
+            }
+
+            return;
+        }
+
+        read_size.update(transferred);
+
+        if (transferred > 0) {
+            stream.buffer().commit(transferred);
+        }
+
+        consume_requests(stream, parser, requests);
+
+        if (!requests.empty() || parser.done()) {
+            (*this)();
+            return;
+        }
+
+        if (ec) {
+            handler(ec);
+            return;
+        }
+
+        start_async_read();
+    }
+
+    friend void *asio_handler_allocate(std::size_t size, async_read_requests_op *context) {
+        using boost::asio::asio_handler_allocate;
+        return asio_handler_allocate(size, &context->handler);
+    }
+
+    friend void asio_handler_deallocate(void *pointer, std::size_t size, async_read_requests_op *context) {
+        using boost::asio::asio_handler_deallocate;
+        asio_handler_deallocate(pointer, size, &context->handler);
+    }
+
+    friend bool asio_handler_is_continuation(async_read_requests_op *context) {
+        using boost::asio::asio_handler_is_continuation;
+        return asio_handler_is_continuation(&context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(Callable &function, async_read_requests_op *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(const Callable &function, async_read_requests_op *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+
+private:
+    void start_async_read() {
+        if (options.probe_before_read && stream.buffer().size() == 0) {
+            release_read_buffer(stream.buffer());
+            probing = true;
+            stream.stream().async_read_some(boost::asio::null_buffers(), std::move(*this));
+        } else {
+            async_read();
+        }
+    }
+
+    void async_read() {
+        stream.stream().async_read_some(
+            stream.buffer().prepare(read_size.get()),
+            std::move(*this)
+        );
+    }
+};
+
+} // namespace detail
+
+
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code)>::type
+>::type
+async_read_requests(BufferedReadStream &stream,
+                    http_request_parser_t &parser,
+                    std::vector<http_request_t> &requests,
+                    read_options_t options,
+                    Handler handler)
+{
+    using handler_t = typename boost::asio::handler_type<Handler, void(boost::system::error_code)>::type;
+    using op_t = detail::async_read_requests_op<BufferedReadStream, handler_t>;
+
+    handler_t concrete_handler = std::move(handler);
+    boost::asio::async_result<handler_t> result(concrete_handler);
+    op_t op(stream, parser, requests, options, std::move(concrete_handler));
+
+    op.start();
+
+    return result.get();
+}
+
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code)>::type
+>::type
+async_read_requests(BufferedReadStream &stream,
+                    http_request_parser_t &parser,
+                    std::vector<http_request_t> &requests,
+                    Handler handler)
+{
+    return async_read_requests(stream, parser, requests, {}, std::move(handler));
+}
+
+template<class BufferedReadStream>
+void read_requests(BufferedReadStream &stream,
+                   http_request_parser_t &parser,
+                   std::vector<http_request_t> &requests,
+                   read_options_t options,
+                   boost::system::error_code &ec)
+{
+    if (!detail::start_requests_batch(parser, requests, options)) {
+        ec = parser.error();
+        return;
+    }
+
+    read_size_t read_size(options);
+
+    while (true) {
+        detail::consume_requests(stream, parser, requests);
+
+        if (!requests.empty()) {
+            return;
+        }
+
+        if (parser.done()) {
+            ec = parser.error();
+            return;
+        }
+
+        boost::system::error_code read_error;
+
+        std::size_t transferred = stream.stream().read_some(
+            stream.buffer().prepare(read_size.get()),
+            read_error
+        );
+
+        read_size.update(transferred);
+        stream.buffer().commit(transferred);
+
+        if (transferred == 0 && read_error) {
+            ec = read_error;
+            return;
+        }
+    }
+}
+
+template<class BufferedReadStream>
+void read_requests(BufferedReadStream &stream,
+                   http_request_parser_t &parser,
+                   std::vector<http_request_t> &requests,
+                   read_options_t options)
+{
+    boost::system::error_code ec;
+    read_requests(stream, parser, requests, std::move(options), ec);
+
+    if (ec) {
+        throw boost::system::system_error(ec);
+    }
+}
+
+HTTPLIB_CLOSE_NAMESPACE
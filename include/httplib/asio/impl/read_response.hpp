@@ -3,9 +3,11 @@
 #include <httplib/detail/common.hpp>
 #include <httplib/http/response.hpp>
 #include <httplib/asio/read_options.hpp>
+#include <httplib/asio/ring_buffer.hpp>
 #include <httplib/parser/response_parser.hpp>
 
 #include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
 #include <boost/asio/handler_alloc_hook.hpp>
 #include <boost/asio/handler_continuation_hook.hpp>
 #include <boost/asio/handler_invoke_hook.hpp>
@@ -25,13 +27,20 @@ struct async_read_response_op {
 
     http_response_parser_t parser;
 
+    read_size_t read_size;
+
+    // Whether the pending read is a null_buffers probe.
+    bool probing;
+
 
     async_read_response_op(BufferedReadStream &stream,
                            read_options_t options,
                            Handler handler) :
         stream(stream),
         options(options),
-        handler(std::move(handler))
+        handler(std::move(handler)),
+        read_size(options),
+        probing(false)
     {
         parser.set_options(options.parsing);
     }
@@ -55,11 +64,25 @@ struct async_read_response_op {
         if (parser.error()) {
             handler(parser.error(), http_response_t());
         } else {
-            handler(boost::system::error_code(), parser.response());
+            handler(boost::system::error_code(), std::move(parser.response()));
         }
     }
 
     void operator()(boost::system::error_code ec, std::size_t transferred) {
+        if (probing) {
+            probing = false;
+
+            if (ec) {
+                handler(ec, http_response_t());
+            } else {
+                async_read();
+            }
+
+            return;
+        }
+
+        read_size.update(transferred);
+
         if (transferred > 0) {
             stream.buffer().commit(transferred);
         }
@@ -138,8 +161,18 @@ private:
     }
 
     void start_async_read() {
+        if (options.probe_before_read && stream.buffer().size() == 0) {
+            release_read_buffer(stream.buffer());
+            probing = true;
+            stream.stream().async_read_some(boost::asio::null_buffers(), std::move(*this));
+        } else {
+            async_read();
+        }
+    }
+
+    void async_read() {
         stream.stream().async_read_some(
-            stream.buffer().prepare(options.read_buffer_size),
+            stream.buffer().prepare(read_size.get()),
             std::move(*this)
         );
     }
@@ -181,6 +214,8 @@ http_response_t read_response(BufferedReadStream &stream,
     http_response_parser_t parser;
     parser.set_options(options.parsing);
 
+    read_size_t read_size(options);
+
     while (true) {
         auto buffers = stream.buffer().data();
 
@@ -199,7 +234,7 @@ http_response_t read_response(BufferedReadStream &stream,
                     ec = parser.error();
                     return {};
                 } else {
-                    return parser.response();
+                    return std::move(parser.response());
                 }
             }
         }
@@ -207,10 +242,11 @@ http_response_t read_response(BufferedReadStream &stream,
         boost::system::error_code read_error;
 
         std::size_t transferred = stream.stream().read_some(
-            stream.buffer().prepare(options.read_buffer_size),
+            stream.buffer().prepare(read_size.get()),
             read_error
         );
 
+        read_size.update(transferred);
         stream.buffer().commit(transferred);
 
         if (transferred == 0 && read_error) {
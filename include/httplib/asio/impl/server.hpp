@@ -0,0 +1,539 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/message_properties.hpp>
+#include <httplib/asio/body_reader.hpp>
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/connection_timeouts.hpp>
+#include <httplib/asio/handler_memory.hpp>
+#include <httplib/asio/read_request.hpp>
+#include <httplib/asio/ring_buffer.hpp>
+#include <httplib/asio/timer_wheel.hpp>
+#include <httplib/asio/write_response.hpp>
+#include <httplib/error.hpp>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/detail/socket_option.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <thread>
+#include <unordered_set>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+namespace detail {
+
+#ifdef SO_REUSEPORT
+using reuse_port_option_t = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+
+
+// The CPUs the process may run on, empty if unknown.
+inline std::vector<int> available_cpus() {
+    std::vector<int> result;
+
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                result.push_back(cpu);
+            }
+        }
+    }
+#endif
+
+    return result;
+}
+
+
+// Pins the current thread to the CPU. Failing to do it is not an error: the thread just runs anywhere.
+inline void pin_current_thread(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void) cpu;
+#endif
+}
+
+
+class server_connection_t;
+
+
+// A thread of server_t with its io_service, its acceptor and the connections it serves.
+// Everything but start(), stop() and join() is called in the thread of the worker.
+class server_worker_t {
+public:
+    explicit server_worker_t(server_t &server) :
+        m_server(server),
+        m_timer_wheel(m_io_service, server.m_options.timeout_resolution),
+        m_accept_timer(m_io_service),
+        m_accepts_for_all(false),
+        m_next_worker(0),
+        m_stopping(false)
+    { }
+
+    boost::asio::io_service &get_io_service() {
+        return m_io_service;
+    }
+
+    timer_wheel_t &timer_wheel() {
+        return m_timer_wheel;
+    }
+
+    const server_handler_t &handler() const {
+        return m_server.m_handler;
+    }
+
+    const server_options_t &options() const {
+        return m_server.m_options;
+    }
+
+    bool stopping() const {
+        return m_stopping;
+    }
+
+    void listen(const boost::asio::ip::tcp::endpoint &endpoint, bool reuse_port) {
+        m_acceptor.emplace(m_io_service);
+        m_accepts_for_all = !reuse_port;
+        m_acceptor->open(endpoint.protocol());
+        m_acceptor->set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+
+#ifdef SO_REUSEPORT
+        if (reuse_port) {
+            m_acceptor->set_option(reuse_port_option_t(true));
+        }
+#else
+        (void) reuse_port;
+#endif
+
+        m_acceptor->bind(endpoint);
+        m_acceptor->listen(options().backlog);
+    }
+
+    boost::asio::ip::tcp::endpoint local_endpoint() const {
+        return m_acceptor->local_endpoint();
+    }
+
+    // cpu is the CPU to pin the thread to, or -1.
+    void start(int cpu) {
+        m_work.emplace(m_io_service);
+
+        if (m_acceptor) {
+            start_accept();
+        }
+
+        m_thread = std::thread([this, cpu] {
+            if (cpu >= 0) {
+                pin_current_thread(cpu);
+            }
+
+            m_io_service.run();
+        });
+    }
+
+    void stop() {
+        m_io_service.post([this] {
+            this->handle_stop();
+        });
+    }
+
+    void join() {
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    void add_connection(server_connection_t *connection) {
+        m_connections.insert(connection);
+    }
+
+    void remove_connection(server_connection_t *connection) {
+        m_connections.erase(connection);
+    }
+
+private:
+    void start_accept();
+    void handle_accept(boost::system::error_code ec, server_worker_t &target);
+    void handle_stop();
+
+private:
+    server_t &m_server;
+
+    std::unordered_set<server_connection_t *> m_connections;
+
+    // Destroyed before the connections set, so the connections still pending in the queue can remove themselves.
+    boost::asio::io_service m_io_service;
+    boost::optional<boost::asio::io_service::work> m_work;
+
+    timer_wheel_t m_timer_wheel;
+
+    boost::optional<boost::asio::ip::tcp::acceptor> m_acceptor;
+    boost::optional<boost::asio::ip::tcp::socket> m_accepting;
+
+    // Delays the next accept after a failed one.
+    boost::asio::steady_timer m_accept_timer;
+
+    // Whether the acceptor is the only one and hands the connections out to all the workers in turn.
+    bool m_accepts_for_all;
+    std::size_t m_next_worker;
+
+    bool m_stopping;
+
+    std::thread m_thread;
+};
+
+
+// Reads the requests of a connection one after another, reads their bodies, calls the handler and writes the responses.
+class server_connection_t : public std::enable_shared_from_this<server_connection_t> {
+    using stream_t = buffered_read_stream<boost::asio::ip::tcp::socket &, ring_buffer_t &>;
+
+public:
+    server_connection_t(server_worker_t &worker, boost::asio::ip::tcp::socket socket) :
+        m_worker(worker),
+        m_socket(std::move(socket)),
+        m_timeouts(worker.timer_wheel(), worker.options().timeouts, [this] { this->close(); }),
+        m_read_options(worker.options().read_options),
+        m_stream(m_socket, m_buffer),
+        m_request(nullptr),
+        m_idle(false),
+        m_keep_alive(false)
+    {
+        m_read_options.timeouts = &m_timeouts;
+    }
+
+    ~server_connection_t() {
+        m_worker.remove_connection(this);
+    }
+
+    void start() {
+        m_worker.add_connection(this);
+
+        boost::system::error_code ec;
+        m_socket.set_option(boost::asio::ip::tcp::no_delay(true), ec);
+
+        read_request();
+    }
+
+    // Closes the connection if it's waiting for a request, otherwise it's closed after the current response.
+    void stop() {
+        if (m_idle) {
+            close();
+        }
+    }
+
+private:
+    void read_request() {
+        if (m_worker.stopping()) {
+            close();
+            return;
+        }
+
+        m_idle = true;
+
+        async_read_request(m_stream, m_parser, m_read_options,
+            bind_handler_memory(m_memory, [self = shared_from_this()](auto ec, const auto &request) {
+                self->handle_request(ec, request);
+            })
+        );
+    }
+
+    void handle_request(boost::system::error_code ec, const http_request_t &request) {
+        m_idle = false;
+
+        if (ec) {
+            if (m_parser.done() && m_parser.error()) {
+                reply_error(STATUS_400_BAD_REQUEST);
+            } else {
+                close();
+            }
+
+            return;
+        }
+
+        auto builder = prepare_response(request);
+
+        if (!builder) {
+            reply_error(response_status_from_error(builder.error()));
+            return;
+        }
+
+        auto reader = make_body_reader(request, m_stream, m_read_options);
+
+        if (!reader) {
+            reply_error(response_status_from_error(reader.error()));
+            return;
+        }
+
+        m_request = &request;
+        m_response.builder = std::move(*builder);
+        m_response.status = STATUS_200_OK;
+        m_response.body.clear();
+
+        m_body.clear();
+        m_body_reader = std::move(*reader);
+
+        read_body();
+    }
+
+    void read_body() {
+        m_body_reader.async_read_some(boost::asio::buffer(m_read_buffer),
+            bind_handler_memory(m_memory, [self = shared_from_this()](auto ec, std::size_t transferred) {
+                self->handle_body(ec, transferred);
+            })
+        );
+    }
+
+    void handle_body(boost::system::error_code ec, std::size_t transferred) {
+        m_body.append(m_read_buffer.data(), transferred);
+
+        if (m_body.size() > m_worker.options().max_body_size) {
+            reply_error(STATUS_413_PAYLOAD_TOO_LARGE);
+        } else if (ec == reader_errc_t::eof) {
+            handle();
+        } else if (ec) {
+            close();
+        } else {
+            read_body();
+        }
+    }
+
+    void handle() {
+        try {
+            m_worker.handler()(*m_request, m_body, m_response);
+        } catch (...) {
+            reply_error(STATUS_500_INTERNAL_SERVER_ERROR);
+            return;
+        }
+
+        reply(true);
+    }
+
+    // The body of the request may be left unread, so the connection is closed after the response.
+    void reply_error(const status_code_t &status) {
+        m_response.builder = http_response_builder_t();
+        m_response.status = status;
+        m_response.body.clear();
+
+        reply(false);
+    }
+
+    void reply(bool keep_alive) {
+        auto &builder = m_response.builder;
+
+        m_keep_alive = keep_alive &&
+                       !m_worker.stopping() &&
+                       builder.connection_status() != connection_status_t::close;
+
+        if (!m_keep_alive) {
+            builder.connection_close();
+        }
+
+        builder.content_length(m_response.body.size());
+        m_reply = builder.build(m_response.status);
+
+        async_write_response(m_socket, m_reply, boost::asio::buffer(m_response.body),
+            bind_handler_memory(m_memory, [self = shared_from_this()](auto ec, std::size_t) {
+                self->handle_write(ec);
+            })
+        );
+    }
+
+    void handle_write(boost::system::error_code ec) {
+        if (ec || !m_keep_alive) {
+            close();
+        } else {
+            read_request();
+        }
+    }
+
+    void close() {
+        boost::system::error_code ec;
+        m_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+        m_socket.close(ec);
+    }
+
+private:
+    // Memory for the operations of the connection, so they don't allocate.
+    handler_memory_t m_memory;
+
+    server_worker_t &m_worker;
+    boost::asio::ip::tcp::socket m_socket;
+
+    // Close the socket on expiry.
+    connection_timeouts_t m_timeouts;
+    read_options_t m_read_options;
+
+    ring_buffer_t m_buffer;
+    stream_t m_stream;
+
+    // Reused for every request of the connection. The current request is the one stored in it.
+    http_request_parser_t m_parser;
+    const http_request_t *m_request;
+
+    body_reader<stream_t> m_body_reader;
+    std::array<char, 4 * 1024> m_read_buffer;
+    std::string m_body;
+
+    server_response_t m_response;
+    http_response_t m_reply;
+
+    // Whether the connection is waiting for the next request.
+    bool m_idle;
+
+    // Whether to read the next request after the current response.
+    bool m_keep_alive;
+};
+
+
+inline void server_worker_t::start_accept() {
+    server_worker_t *target = this;
+
+    if (m_accepts_for_all) {
+        target = m_server.m_workers[m_next_worker].get();
+        m_next_worker = (m_next_worker + 1) % m_server.m_workers.size();
+    }
+
+    m_accepting.emplace(target->m_io_service);
+
+    m_acceptor->async_accept(*m_accepting, [this, target](auto ec) {
+        this->handle_accept(ec, *target);
+    });
+}
+
+inline void server_worker_t::handle_accept(boost::system::error_code ec, server_worker_t &target) {
+    if (m_stopping || ec == boost::asio::error::operation_aborted) {
+        return;
+    }
+
+    if (ec) {
+        ++m_server.m_accept_errors;
+
+        m_accept_timer.expires_from_now(options().accept_error_delay);
+        m_accept_timer.async_wait([this](auto wait_error) {
+            if (!wait_error && !m_stopping) {
+                this->start_accept();
+            }
+        });
+
+        return;
+    }
+
+    auto connection = std::make_shared<server_connection_t>(target, std::move(*m_accepting));
+
+    if (&target == this) {
+        connection->start();
+    } else {
+        target.m_io_service.post([connection] {
+            connection->start();
+        });
+    }
+
+    start_accept();
+}
+
+inline void server_worker_t::handle_stop() {
+    m_stopping = true;
+    m_work.reset();
+
+    if (m_acceptor) {
+        boost::system::error_code ec;
+        m_acceptor->close(ec);
+        m_accept_timer.cancel(ec);
+    }
+
+    for (auto *connection: m_connections) {
+        connection->stop();
+    }
+}
+
+} // namespace detail
+
+
+inline server_t::server_t(server_handler_t handler, server_options_t options) :
+    m_handler(std::move(handler)),
+    m_options(std::move(options)),
+    m_accept_errors(0)
+{ }
+
+inline server_t::~server_t() {
+    stop();
+    join();
+}
+
+inline void server_t::start(const boost::asio::ip::tcp::endpoint &endpoint) {
+    assert(m_workers.empty());
+
+    auto cpus = detail::available_cpus();
+    std::size_t threads = m_options.threads;
+
+    if (threads == 0) {
+        threads = cpus.empty() ? std::max(1u, std::thread::hardware_concurrency()) : cpus.size();
+    }
+
+#ifdef SO_REUSEPORT
+    bool reuse_port = m_options.reuse_port;
+#else
+    bool reuse_port = false;
+#endif
+
+    for (std::size_t i = 0; i < threads; ++i) {
+        m_workers.push_back(std::make_unique<detail::server_worker_t>(*this));
+    }
+
+    try {
+        // The first acceptor binds the port, so with port 0 the others bind the one it's got.
+        auto bound = endpoint;
+
+        for (std::size_t i = 0; i < (reuse_port ? threads : 1); ++i) {
+            m_workers[i]->listen(bound, reuse_port);
+            bound = m_workers[i]->local_endpoint();
+        }
+    } catch (...) {
+        m_workers.clear();
+        throw;
+    }
+
+    for (std::size_t i = 0; i < threads; ++i) {
+        m_workers[i]->start(m_options.pin_threads && !cpus.empty() ? cpus[i % cpus.size()] : -1);
+    }
+}
+
+inline void server_t::stop() {
+    for (auto &worker: m_workers) {
+        worker->stop();
+    }
+}
+
+inline void server_t::join() {
+    for (auto &worker: m_workers) {
+        worker->join();
+    }
+}
+
+inline boost::asio::ip::tcp::endpoint server_t::local_endpoint() const {
+    return m_workers.front()->local_endpoint();
+}
+
+inline std::size_t server_t::accept_errors() const {
+    return m_accept_errors;
+}
+
+HTTPLIB_CLOSE_NAMESPACE
@@ -0,0 +1,879 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/error.hpp>
+#include <httplib/http/message_properties.hpp>
+#include <httplib/asio/body_reader.hpp>
+#include <httplib/asio/read_options.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/handler_alloc_hook.hpp>
+#include <boost/asio/handler_continuation_hook.hpp>
+#include <boost/asio/handler_invoke_hook.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+namespace detail {
+
+inline boost::system::error_code last_system_error() {
+    return boost::system::error_code(errno, boost::system::system_category());
+}
+
+
+inline bool would_block(int error) {
+    return error == EAGAIN || error == EWOULDBLOCK;
+}
+
+
+inline void wait_for(int fd, short events, boost::system::error_code &ec) {
+    pollfd descriptor = {fd, events, 0};
+
+    while (::poll(&descriptor, 1, -1) < 0) {
+        if (errno != EINTR) {
+            ec = last_system_error();
+            return;
+        }
+    }
+}
+
+
+// Writes as much as the descriptor takes now.
+// The error is boost::asio::error::would_block if a non-blocking descriptor takes nothing.
+inline std::size_t write_some(int fd, const char *data, std::size_t size, boost::system::error_code &ec) {
+    while (true) {
+        ssize_t written = ::write(fd, data, size);
+
+        if (written >= 0) {
+            return static_cast<std::size_t>(written);
+        } else if (would_block(errno)) {
+            ec = boost::asio::error::would_block;
+            return 0;
+        } else if (errno != EINTR) {
+            ec = last_system_error();
+            return 0;
+        }
+    }
+}
+
+
+// Writes all of the data, waiting for a non-blocking descriptor when it's full.
+inline void write_all(int fd, const char *data, std::size_t size, boost::system::error_code &ec) {
+    while (size > 0 && !ec) {
+        std::size_t written = write_some(fd, data, size, ec);
+
+        if (ec == boost::asio::error::would_block) {
+            ec.clear();
+            wait_for(fd, POLLOUT, ec);
+        }
+
+        data += written;
+        size -= written;
+    }
+}
+
+
+inline boost::system::error_code make_body_reader_error_code(make_body_reader_error_t error) {
+    switch (error) {
+        case make_body_reader_error_t::bad_message:
+            return boost::system::errc::make_error_code(boost::system::errc::bad_message);
+        case make_body_reader_error_t::unsupported_encoding:
+            return boost::system::errc::make_error_code(boost::system::errc::not_supported);
+    }
+
+    return boost::system::errc::make_error_code(boost::system::errc::invalid_argument);
+}
+
+
+// Writes the beginning of the buffered part of the body, as much as the descriptor takes now.
+template<class BufferedReadStream>
+std::size_t write_read_buffer_some(BufferedReadStream &stream,
+                                   int fd,
+                                   content_length_int_t size,
+                                   boost::system::error_code &ec)
+{
+    auto buffers = stream.buffer().data();
+    auto buffer = boost::asio::const_buffer(*buffers.begin());
+
+    std::size_t part = static_cast<std::size_t>(
+        std::min<content_length_int_t>(boost::asio::buffer_size(buffer), size)
+    );
+
+    std::size_t written = write_some(fd, boost::asio::buffer_cast<const char *>(buffer), part, ec);
+    stream.buffer().consume(written);
+
+    return written;
+}
+
+
+// Writes the buffered part of the body to the descriptor.
+template<class BufferedReadStream>
+content_length_int_t drain_read_buffer(BufferedReadStream &stream,
+                                       int fd,
+                                       content_length_int_t size,
+                                       boost::system::error_code &ec)
+{
+    content_length_int_t written = 0;
+
+    while (written < size && stream.buffer().size() != 0 && !ec) {
+        written += write_read_buffer_some(stream, fd, size - written, ec);
+
+        if (ec == boost::asio::error::would_block) {
+            ec.clear();
+            wait_for(fd, POLLOUT, ec);
+        }
+    }
+
+    return written;
+}
+
+
+// No more than the default pipe capacity is spliced at once, so a part always fits into an empty pipe.
+// A namespace scope constant, since std::min() takes it by reference and a static member would need a definition.
+constexpr std::size_t max_splice_part_size = 64 * 1024;
+
+// async_splice_body() returns to the io_service after this many steps even if the socket has more data
+// and the descriptor takes it.
+constexpr std::size_t max_splice_steps_per_turn = 16;
+
+
+// A pipe to splice the data through.
+class splice_pipe_t {
+public:
+    splice_pipe_t() :
+        m_read(-1),
+        m_write(-1),
+        m_size(0)
+    { }
+
+    splice_pipe_t(const splice_pipe_t &) = delete;
+    splice_pipe_t &operator=(const splice_pipe_t &) = delete;
+
+    ~splice_pipe_t() {
+        if (m_read >= 0) {
+            ::close(m_read);
+            ::close(m_write);
+        }
+    }
+
+    void open(boost::system::error_code &ec) {
+        int fds[2];
+
+        if (::pipe2(fds, O_CLOEXEC) != 0) {
+            ec = last_system_error();
+            return;
+        }
+
+        m_read = fds[0];
+        m_write = fds[1];
+    }
+
+    // The number of bytes in the pipe, which are yet to be moved to the descriptor.
+    std::size_t size() const {
+        return m_size;
+    }
+
+    // Moves up to size bytes from the socket into the empty pipe.
+    // The error is boost::asio::error::would_block if the socket has nothing to read.
+    std::size_t fill(int from, std::size_t size, boost::system::error_code &ec) {
+        size = std::min(size, max_splice_part_size);
+
+        ssize_t received;
+
+        do {
+            received = ::splice(from, nullptr, m_write, nullptr, size, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        } while (received < 0 && errno == EINTR);
+
+        if (received < 0) {
+            if (would_block(errno)) {
+                ec = boost::asio::error::would_block;
+            } else {
+                ec = last_system_error();
+            }
+
+            return 0;
+        } else if (received == 0) {
+            ec = boost::asio::error::eof;
+            return 0;
+        }
+
+        m_size += received;
+        return received;
+    }
+
+    // Moves the data from the pipe to the descriptor, as much as it takes now.
+    // The error is boost::asio::error::would_block if a non-blocking descriptor takes nothing.
+    std::size_t drain(int to, boost::system::error_code &ec) {
+        std::size_t moved = 0;
+
+        while (m_size > 0) {
+            ssize_t sent = ::splice(m_read, nullptr, to, nullptr, m_size, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                } else if (moved == 0 && would_block(errno)) {
+                    ec = boost::asio::error::would_block;
+                } else if (!would_block(errno)) {
+                    ec = last_system_error();
+                }
+
+                break;
+            }
+
+            m_size -= sent;
+            moved += sent;
+        }
+
+        return moved;
+    }
+
+private:
+    int m_read;
+    int m_write;
+    std::size_t m_size;
+};
+
+
+// The descriptor the asynchronous functions write to.
+// It's switched to the non-blocking mode for the time of the operation, so a slow reader on the other side of
+// a socket or a pipe doesn't block the thread, and it's waited for in the io_service when it's full.
+// The wait goes through a duplicate of the descriptor, since the descriptor itself may already be registered
+// in the io_service, e.g. if it belongs to another asio socket.
+class async_destination_t {
+public:
+    async_destination_t(boost::asio::io_service &io_service, int fd) :
+        m_fd(fd),
+        m_flags(-1),
+        m_descriptor(io_service)
+    { }
+
+    async_destination_t(const async_destination_t &) = delete;
+    async_destination_t &operator=(const async_destination_t &) = delete;
+
+    ~async_destination_t() {
+        release();
+    }
+
+    int native_handle() const {
+        return m_fd;
+    }
+
+    void open(boost::system::error_code &ec) {
+        int flags = ::fcntl(m_fd, F_GETFL);
+
+        if (flags < 0 || ((flags & O_NONBLOCK) == 0 && ::fcntl(m_fd, F_SETFL, flags | O_NONBLOCK) != 0)) {
+            ec = last_system_error();
+            return;
+        }
+
+        m_flags = flags;
+    }
+
+    // Prepares the wait for the descriptor. Regular files never get here, since they are never full,
+    // and they can't be waited for.
+    void prepare_wait(boost::system::error_code &ec) {
+        if (m_descriptor.is_open()) {
+            return;
+        }
+
+        int duplicate = ::fcntl(m_fd, F_DUPFD_CLOEXEC, 0);
+
+        if (duplicate < 0) {
+            ec = last_system_error();
+            return;
+        }
+
+        m_descriptor.assign(duplicate, ec);
+
+        if (ec) {
+            ::close(duplicate);
+        }
+    }
+
+    // Calls the handler once the descriptor is writable.
+    template<class Handler>
+    void async_wait(Handler &&handler) {
+        m_descriptor.async_write_some(boost::asio::null_buffers(), std::forward<Handler>(handler));
+    }
+
+    // Restores the mode of the descriptor and closes the duplicate.
+    void release() {
+        boost::system::error_code ignored;
+        m_descriptor.close(ignored);
+
+        if (m_flags >= 0 && (m_flags & O_NONBLOCK) == 0) {
+            ::fcntl(m_fd, F_SETFL, m_flags);
+        }
+
+        m_flags = -1;
+    }
+
+private:
+    int m_fd;
+    int m_flags;
+    boost::asio::posix::stream_descriptor m_descriptor;
+};
+
+
+template<class Message, class BufferedReadStream>
+content_length_int_t copy_body(const Message &message,
+                               BufferedReadStream &stream,
+                               int fd,
+                               read_options_t options,
+                               boost::system::error_code &ec)
+{
+    auto reader = make_body_reader(message, stream, options);
+
+    if (!reader) {
+        ec = make_body_reader_error_code(reader.error());
+        return 0;
+    }
+
+    std::vector<char> buffer(std::max(options.read_buffer_size, options.max_read_buffer_size));
+    content_length_int_t written = 0;
+
+    while (true) {
+        boost::system::error_code read_error;
+        std::size_t transferred = reader->read_some(boost::asio::buffer(buffer), read_error);
+
+        write_all(fd, buffer.data(), transferred, ec);
+
+        if (ec) {
+            return written;
+        }
+
+        written += transferred;
+
+        if (read_error == reader_errc_t::eof) {
+            return written;
+        } else if (read_error) {
+            ec = read_error;
+            return written;
+        }
+    }
+}
+
+
+template<class Message, class BufferedReadStream>
+content_length_int_t splice_body(const Message &message,
+                                 BufferedReadStream &stream,
+                                 int fd,
+                                 read_options_t options,
+                                 boost::system::error_code &ec)
+{
+    auto size = body_size(message);
+
+    if (!size) {
+        ec = make_body_reader_error_code(make_body_reader_error_t::bad_message);
+        return 0;
+    } else if (size->type != body_size_t::type_t::content_length) {
+        return copy_body(message, stream, fd, std::move(options), ec);
+    }
+
+    content_length_int_t written = drain_read_buffer(stream, fd, size->content_length, ec);
+
+    if (ec || written == size->content_length) {
+        return written;
+    }
+
+    splice_pipe_t pipe;
+    pipe.open(ec);
+
+    int socket = stream.stream().native_handle();
+
+    while (!ec && written < size->content_length) {
+        if (pipe.size() == 0) {
+            pipe.fill(socket, static_cast<std::size_t>(
+                std::min<content_length_int_t>(size->content_length - written, max_splice_part_size)
+            ), ec);
+
+            if (ec == boost::asio::error::would_block) {
+                ec.clear();
+                wait_for(socket, POLLIN, ec);
+            }
+        } else {
+            written += pipe.drain(fd, ec);
+
+            if (ec == boost::asio::error::would_block) {
+                ec.clear();
+                wait_for(fd, POLLOUT, ec);
+            }
+        }
+    }
+
+    return written;
+}
+
+
+template<class BufferedReadStream, class Handler>
+struct async_splice_body_op {
+    struct state_t {
+        state_t(boost::asio::io_service &io_service, int fd) :
+            destination(io_service, fd),
+            restore_socket_mode(false),
+            socket_non_blocking(false)
+        { }
+
+        async_destination_t destination;
+        splice_pipe_t pipe;
+
+        // The mode of the socket to restore before the handler is called.
+        bool restore_socket_mode;
+        bool socket_non_blocking;
+    };
+
+    BufferedReadStream &stream;
+    content_length_int_t size;
+    Handler handler;
+
+    content_length_int_t written;
+    boost::system::error_code error;
+    std::shared_ptr<state_t> state;
+
+
+    async_splice_body_op(BufferedReadStream &stream,
+                         int fd,
+                         content_length_int_t size,
+                         boost::system::error_code error,
+                         Handler handler) :
+        stream(stream),
+        size(size),
+        handler(std::move(handler)),
+        written(0),
+        error(error),
+        state(std::make_shared<state_t>(stream.stream().get_io_service(), fd))
+    { }
+
+    void start() {
+        auto &current = *state;
+
+        if (!error && size > 0) {
+            current.destination.open(error);
+        }
+
+        if (!error && size > stream.buffer().size()) {
+            current.pipe.open(error);
+        }
+
+        if (!error && size > stream.buffer().size()) {
+            current.socket_non_blocking = stream.stream().native_non_blocking();
+            stream.stream().native_non_blocking(true, error);
+            current.restore_socket_mode = !error;
+        }
+
+        if (error || !resume()) {
+            stream.stream().get_io_service().post(std::move(*this));
+        }
+    }
+
+    void operator()() {
+        complete();
+    }
+
+    void operator()(boost::system::error_code ec, std::size_t) {
+        error = ec;
+
+        if (error || !resume()) {
+            complete();
+        }
+    }
+
+    friend void *asio_handler_allocate(std::size_t size, async_splice_body_op *context) {
+        using boost::asio::asio_handler_allocate;
+        return asio_handler_allocate(size, &context->handler);
+    }
+
+    friend void asio_handler_deallocate(void *pointer, std::size_t size, async_splice_body_op *context) {
+        using boost::asio::asio_handler_deallocate;
+        asio_handler_deallocate(pointer, size, &context->handler);
+    }
+
+    friend bool asio_handler_is_continuation(async_splice_body_op *context) {
+        using boost::asio::asio_handler_is_continuation;
+        return asio_handler_is_continuation(&context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(Callable &function, async_splice_body_op *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(const Callable &function, async_splice_body_op *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+
+private:
+    // Moves the body until the socket or the descriptor would block, but makes about max_splice_steps_per_turn
+    // steps at once, so a fast peer doesn't keep the thread from the other handlers.
+    // The data left in the pipe waits there for the descriptor.
+    // Returns true if it waits for the socket or the descriptor, false if it's done or failed.
+    bool resume() {
+        auto &current = *state;
+        int fd = current.destination.native_handle();
+
+        for (std::size_t steps = 0; written < size; ++steps) {
+            boost::system::error_code ec;
+            bool destination_is_full = true;
+
+            if (steps >= max_splice_steps_per_turn && stream.buffer().size() == 0 && current.pipe.size() == 0) {
+                // Only the socket is waited for here, since a regular file can't be waited for.
+                // The wait completes right away if the socket has more data.
+                ec = boost::asio::error::would_block;
+                destination_is_full = false;
+            } else if (stream.buffer().size() != 0) {
+                written += write_read_buffer_some(stream, fd, size - written, ec);
+            } else if (current.pipe.size() != 0) {
+                written += current.pipe.drain(fd, ec);
+            } else {
+                current.pipe.fill(stream.stream().native_handle(), static_cast<std::size_t>(
+                    std::min<content_length_int_t>(size - written, max_splice_part_size)
+                ), ec);
+
+                destination_is_full = false;
+            }
+
+            if (ec == boost::asio::error::would_block && destination_is_full) {
+                current.destination.prepare_wait(error);
+
+                if (error) {
+                    return false;
+                }
+
+                current.destination.async_wait(std::move(*this));
+                return true;
+            } else if (ec == boost::asio::error::would_block) {
+                stream.stream().async_read_some(boost::asio::null_buffers(), std::move(*this));
+                return true;
+            } else if (ec) {
+                error = ec;
+                return false;
+            }
+        }
+
+        return false;
+    }
+
+    // Gives the socket and the descriptor back in their modes and calls the handler.
+    void complete() {
+        auto &current = *state;
+        current.destination.release();
+
+        if (current.restore_socket_mode) {
+            boost::system::error_code ignored;
+            stream.stream().native_non_blocking(current.socket_non_blocking, ignored);
+            current.restore_socket_mode = false;
+        }
+
+        handler(error, written);
+    }
+};
+
+
+template<class BufferedReadStream, class Handler>
+struct async_copy_body_op {
+    struct state_t {
+        state_t(body_reader<BufferedReadStream> reader, BufferedReadStream &stream, int fd, std::size_t buffer_size) :
+            reader(std::move(reader)),
+            buffer(buffer_size),
+            destination(stream.stream().get_io_service(), fd),
+            begin(0),
+            end(0),
+            waits_for_destination(false)
+        { }
+
+        body_reader<BufferedReadStream> reader;
+        std::vector<char> buffer;
+        async_destination_t destination;
+
+        // The part of the buffer to write before the next read, and the error of the last read.
+        std::size_t begin;
+        std::size_t end;
+        boost::system::error_code read_error;
+
+        // Whether the pending operation is a wait for the descriptor.
+        bool waits_for_destination;
+    };
+
+    BufferedReadStream &stream;
+    Handler handler;
+    std::shared_ptr<state_t> state;
+    content_length_int_t written;
+    boost::system::error_code error;
+
+
+    async_copy_body_op(body_reader<BufferedReadStream> reader,
+                       BufferedReadStream &stream,
+                       int fd,
+                       std::size_t buffer_size,
+                       Handler handler) :
+        stream(stream),
+        handler(std::move(handler)),
+        state(std::make_shared<state_t>(std::move(reader), stream, fd, buffer_size)),
+        written(0)
+    { }
+
+    void start() {
+        auto &current = *state;
+        current.destination.open(error);
+
+        if (error) {
+            stream.stream().get_io_service().post(std::move(*this));
+            return;
+        }
+
+        read();
+    }
+
+    void operator()() {
+        complete();
+    }
+
+    void operator()(boost::system::error_code ec, std::size_t transferred) {
+        auto &current = *state;
+
+        if (current.waits_for_destination) {
+            current.waits_for_destination = false;
+
+            if (ec) {
+                error = ec;
+                complete();
+                return;
+            }
+        } else {
+            current.begin = 0;
+            current.end = transferred;
+            current.read_error = ec;
+        }
+
+        write();
+    }
+
+    friend void *asio_handler_allocate(std::size_t size, async_copy_body_op *context) {
+        using boost::asio::asio_handler_allocate;
+        return asio_handler_allocate(size, &context->handler);
+    }
+
+    friend void asio_handler_deallocate(void *pointer, std::size_t size, async_copy_body_op *context) {
+        using boost::asio::asio_handler_deallocate;
+        asio_handler_deallocate(pointer, size, &context->handler);
+    }
+
+    friend bool asio_handler_is_continuation(async_copy_body_op *context) {
+        using boost::asio::asio_handler_is_continuation;
+        return asio_handler_is_continuation(&context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(Callable &function, async_copy_body_op *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(const Callable &function, async_copy_body_op *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+
+private:
+    void read() {
+        // The state must be reached before *this is moved into the handler argument.
+        auto &current = *state;
+
+        current.reader.async_read_some(boost::asio::buffer(current.buffer), std::move(*this));
+    }
+
+    // Writes the data read last, waiting for the descriptor when it's full, then reads on or completes.
+    void write() {
+        auto &current = *state;
+
+        while (current.begin < current.end) {
+            boost::system::error_code ec;
+            std::size_t transferred = write_some(current.destination.native_handle(),
+                                                 current.buffer.data() + current.begin,
+                                                 current.end - current.begin,
+                                                 ec);
+
+            current.begin += transferred;
+            written += transferred;
+
+            if (ec == boost::asio::error::would_block) {
+                ec.clear();
+                current.destination.prepare_wait(ec);
+
+                if (!ec) {
+                    current.waits_for_destination = true;
+                    current.destination.async_wait(std::move(*this));
+                    return;
+                }
+            }
+
+            if (ec) {
+                error = ec;
+                complete();
+                return;
+            }
+        }
+
+        if (current.read_error && current.read_error != reader_errc_t::eof) {
+            error = current.read_error;
+            complete();
+        } else if (current.read_error) {
+            complete();
+        } else {
+            read();
+        }
+    }
+
+    // Gives the descriptor back in its mode and calls the handler.
+    void complete() {
+        state->destination.release();
+        handler(error, written);
+    }
+};
+
+
+template<class Message, class BufferedReadStream, class Handler>
+void async_splice_body(const Message &message,
+                       BufferedReadStream &stream,
+                       int fd,
+                       read_options_t options,
+                       Handler handler)
+{
+    using splice_op_t = async_splice_body_op<BufferedReadStream, Handler>;
+    using copy_op_t = async_copy_body_op<BufferedReadStream, Handler>;
+
+    auto size = body_size(message);
+    boost::system::error_code error;
+
+    if (!size) {
+        error = make_body_reader_error_code(make_body_reader_error_t::bad_message);
+    } else if (size->type != body_size_t::type_t::content_length) {
+        auto reader = make_body_reader(message, stream, options);
+
+        if (reader) {
+            std::size_t buffer_size = std::max(options.read_buffer_size, options.max_read_buffer_size);
+            copy_op_t(std::move(*reader), stream, fd, buffer_size, std::move(handler)).start();
+            return;
+        }
+
+        error = make_body_reader_error_code(reader.error());
+    }
+
+    splice_op_t(stream, fd, error ? 0 : size->content_length, error, std::move(handler)).start();
+}
+
+} // namespace detail
+
+
+template<class BufferedReadStream>
+content_length_int_t splice_body(const http_request_t &request,
+                                 BufferedReadStream &stream,
+                                 int fd,
+                                 read_options_t options,
+                                 boost::system::error_code &ec)
+{
+    return detail::splice_body(request, stream, fd, std::move(options), ec);
+}
+
+template<class BufferedReadStream>
+content_length_int_t splice_body(const http_request_t &request,
+                                 BufferedReadStream &stream,
+                                 int fd,
+                                 read_options_t options)
+{
+    boost::system::error_code ec;
+    content_length_int_t result = splice_body(request, stream, fd, std::move(options), ec);
+
+    if (ec) {
+        throw boost::system::system_error(ec);
+    }
+
+    return result;
+}
+
+template<class BufferedReadStream>
+content_length_int_t splice_body(const http_response_t &response,
+                                 BufferedReadStream &stream,
+                                 int fd,
+                                 read_options_t options,
+                                 boost::system::error_code &ec)
+{
+    return detail::splice_body(response, stream, fd, std::move(options), ec);
+}
+
+template<class BufferedReadStream>
+content_length_int_t splice_body(const http_response_t &response,
+                                 BufferedReadStream &stream,
+                                 int fd,
+                                 read_options_t options)
+{
+    boost::system::error_code ec;
+    content_length_int_t result = splice_body(response, stream, fd, std::move(options), ec);
+
+    if (ec) {
+        throw boost::system::system_error(ec);
+    }
+
+    return result;
+}
+
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, content_length_int_t)>::type
+>::type
+async_splice_body(const http_request_t &request,
+                  BufferedReadStream &stream,
+                  int fd,
+                  read_options_t options,
+                  Handler handler)
+{
+    using handler_t = typename boost::asio::handler_type<Handler, void(boost::system::error_code, content_length_int_t)>::type;
+
+    handler_t concrete_handler = std::move(handler);
+    boost::asio::async_result<handler_t> result(concrete_handler);
+    detail::async_splice_body(request, stream, fd, std::move(options), std::move(concrete_handler));
+
+    return result.get();
+}
+
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, content_length_int_t)>::type
+>::type
+async_splice_body(const http_response_t &response,
+                  BufferedReadStream &stream,
+                  int fd,
+                  read_options_t options,
+                  Handler handler)
+{
+    using handler_t = typename boost::asio::handler_type<Handler, void(boost::system::error_code, content_length_int_t)>::type;
+
+    handler_t concrete_handler = std::move(handler);
+    boost::asio::async_result<handler_t> result(concrete_handler);
+    detail::async_splice_body(response, stream, fd, std::move(options), std::move(concrete_handler));
+
+    return result.get();
+}
+
+HTTPLIB_CLOSE_NAMESPACE
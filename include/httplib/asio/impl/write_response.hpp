@@ -0,0 +1,243 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/response.hpp>
+#include <httplib/http/status_code.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/handler_alloc_hook.hpp>
+#include <boost/asio/handler_continuation_hook.hpp>
+#include <boost/asio/handler_invoke_hook.hpp>
+#include <boost/asio/write.hpp>
+
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+namespace detail {
+
+constexpr char header_separator[] = {':', ' '};
+constexpr char line_separator[] = {'\r', '\n'};
+
+
+// Buffers of the whole response. The header values and the body are referenced, the rest of the head is rendered:
+// each header name with the separators around it, e.g. "\r\nName: ", goes into a single buffer,
+// so a header value takes two buffers.
+// The buffers point into the object itself, so it's neither copyable nor movable.
+class response_buffers_t {
+public:
+    template<class ConstBufferSequence>
+    response_buffers_t(const http_response_t &response, const ConstBufferSequence &body) {
+        std::size_t values_count = 0;
+        std::size_t head_size = sizeof(line_separator);
+
+        for (const auto &header: response.headers) {
+            std::size_t line_size = header.first.size() + sizeof(header_separator) + sizeof(line_separator);
+            values_count += header.second.size();
+            head_size += header.second.size() * line_size;
+        }
+
+        m_buffers.reserve(2 + 2 * values_count + std::distance(body.begin(), body.end()));
+
+        // Reserved in full, so the buffers pointing into it stay valid while it grows.
+        m_head.reserve(head_size);
+
+        if (auto status_line = find_status_line(response.code, response.reason, response.version)) {
+            m_buffers.emplace_back(boost::asio::buffer(status_line->data(), status_line->size()));
+        } else {
+            m_status_line.append("HTTP/")
+                         .append(std::to_string(response.version.major))
+                         .append(".")
+                         .append(std::to_string(response.version.minor))
+                         .append(" ")
+                         .append(std::to_string(response.code))
+                         .append(" ")
+                         .append(response.reason)
+                         .append(line_separator, sizeof(line_separator));
+
+            m_buffers.emplace_back(boost::asio::buffer(m_status_line));
+        }
+
+        // The Home header goes first, as it's recommended by rfc7230.
+        auto home_it = response.headers.find("home");
+
+        if (home_it != response.headers.end()) {
+            add_header(home_it->first, home_it->second);
+        }
+
+        for (auto header_it = response.headers.begin(); header_it != response.headers.end(); ++header_it) {
+            if (header_it != home_it) {
+                add_header(header_it->first, header_it->second);
+            }
+        }
+
+        // Ends the last header, if any, and the head.
+        std::size_t end_offset = m_head.size();
+
+        if (values_count > 0) {
+            m_head.append(line_separator, sizeof(line_separator));
+        }
+
+        m_head.append(line_separator, sizeof(line_separator));
+        m_buffers.emplace_back(boost::asio::buffer(m_head.data() + end_offset, m_head.size() - end_offset));
+
+        for (auto it = body.begin(); it != body.end(); ++it) {
+            boost::asio::const_buffer buffer(*it);
+
+            if (boost::asio::buffer_size(buffer) > 0) {
+                m_buffers.emplace_back(buffer);
+            }
+        }
+    }
+
+    response_buffers_t(const response_buffers_t &) = delete;
+    response_buffers_t &operator=(const response_buffers_t &) = delete;
+
+    const std::vector<boost::asio::const_buffer> &buffers() const {
+        return m_buffers;
+    }
+
+private:
+    void add_header(const std::string &name, const http_headers_t::header_values_t &values) {
+        for (const auto &value: values) {
+            std::size_t offset = m_head.size();
+
+            // The line separator ends the previous header.
+            if (m_buffers.size() > 1) {
+                m_head.append(line_separator, sizeof(line_separator));
+            }
+
+            m_head.append(name).append(header_separator, sizeof(header_separator));
+
+            m_buffers.emplace_back(boost::asio::buffer(m_head.data() + offset, m_head.size() - offset));
+            m_buffers.emplace_back(boost::asio::buffer(value));
+        }
+    }
+
+private:
+    std::string m_status_line;
+
+    // The header names and the separators.
+    std::string m_head;
+
+    std::vector<boost::asio::const_buffer> m_buffers;
+};
+
+
+template<class Handler>
+struct async_write_response_op {
+    // Shared, since asio requires handlers to be copyable.
+    std::shared_ptr<response_buffers_t> buffers;
+    Handler handler;
+
+    async_write_response_op(std::shared_ptr<response_buffers_t> buffers, Handler handler) :
+        buffers(std::move(buffers)),
+        handler(std::move(handler))
+    { }
+
+    void operator()(boost::system::error_code ec, std::size_t transferred) {
+        buffers.reset();
+        handler(ec, transferred);
+    }
+
+    friend void *asio_handler_allocate(std::size_t size, async_write_response_op *context) {
+        using boost::asio::asio_handler_allocate;
+        return asio_handler_allocate(size, &context->handler);
+    }
+
+    friend void asio_handler_deallocate(void *pointer, std::size_t size, async_write_response_op *context) {
+        using boost::asio::asio_handler_deallocate;
+        asio_handler_deallocate(pointer, size, &context->handler);
+    }
+
+    friend bool asio_handler_is_continuation(async_write_response_op *context) {
+        using boost::asio::asio_handler_is_continuation;
+        return asio_handler_is_continuation(&context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(Callable &function, async_write_response_op *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(const Callable &function, async_write_response_op *context) {
+        using boost::asio::asio_handler_invoke;
+        asio_handler_invoke(function, &context->handler);
+    }
+};
+
+} // namespace detail
+
+
+template<class AsyncWriteStream, class ConstBufferSequence, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type
+>::type
+async_write_response(AsyncWriteStream &stream,
+                     const http_response_t &response,
+                     const ConstBufferSequence &body,
+                     Handler handler)
+{
+    using handler_t = typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type;
+    using op_t = detail::async_write_response_op<handler_t>;
+
+    handler_t concrete_handler = std::move(handler);
+    boost::asio::async_result<handler_t> result(concrete_handler);
+
+    auto buffers = std::make_shared<detail::response_buffers_t>(response, body);
+    const auto &sequence = buffers->buffers();
+
+    boost::asio::async_write(stream, sequence, op_t(std::move(buffers), std::move(concrete_handler)));
+
+    return result.get();
+}
+
+template<class AsyncWriteStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type
+>::type
+async_write_response(AsyncWriteStream &stream, const http_response_t &response, Handler handler) {
+    return async_write_response(stream, response, boost::asio::const_buffers_1(nullptr, 0), std::move(handler));
+}
+
+template<class SyncWriteStream, class ConstBufferSequence>
+std::size_t write_response(SyncWriteStream &stream,
+                           const http_response_t &response,
+                           const ConstBufferSequence &body,
+                           boost::system::error_code &ec)
+{
+    detail::response_buffers_t buffers(response, body);
+    return boost::asio::write(stream, buffers.buffers(), ec);
+}
+
+template<class SyncWriteStream, class ConstBufferSequence>
+std::size_t write_response(SyncWriteStream &stream, const http_response_t &response, const ConstBufferSequence &body) {
+    boost::system::error_code ec;
+    std::size_t result = write_response(stream, response, body, ec);
+
+    if (ec) {
+        throw boost::system::system_error(ec);
+    }
+
+    return result;
+}
+
+template<class SyncWriteStream>
+std::size_t write_response(SyncWriteStream &stream, const http_response_t &response, boost::system::error_code &ec) {
+    return write_response(stream, response, boost::asio::const_buffers_1(nullptr, 0), ec);
+}
+
+template<class SyncWriteStream>
+std::size_t write_response(SyncWriteStream &stream, const http_response_t &response) {
+    return write_response(stream, response, boost::asio::const_buffers_1(nullptr, 0));
+}
+
+HTTPLIB_CLOSE_NAMESPACE
@@ -3,14 +3,66 @@
 #include <httplib/detail/common.hpp>
 #include <httplib/parser/parsing_options.hpp>
 
+#include <algorithm>
 #include <cstdlib>
 
 
 HTTPLIB_OPEN_NAMESPACE
 
+class connection_timeouts_t;
+
 struct read_options_t {
     http_parsing_options_t parsing;
+
+    // The first read of an operation or a body reader prepares read_buffer_size bytes in the buffer.
+    // A read which fills the whole region doubles the size for the next one, up to max_read_buffer_size,
+    // and a read which fills less than a half of it halves the size, down to read_buffer_size.
+    // Set max_read_buffer_size to read_buffer_size to always read by the same amount.
+    // bound_body_reader and eof_body_reader bypass the buffer when the caller's buffers are at least read_buffer_size bytes.
     std::size_t read_buffer_size = 4 * 1024;
+    std::size_t max_read_buffer_size = 64 * 1024;
+
+    // If set, async_read_request(), async_read_request_view(), async_read_requests() and async_read_response()
+    // first wait for the stream to become readable with a null_buffers read and only then prepare the buffer,
+    // so a connection waiting for the next message doesn't hold any buffer memory.
+    // The synchronous functions ignore it: the thread blocked in them holds the connection anyway.
+    // An empty ring_buffer_t releases its memory while waiting.
+    // The stream must support null_buffers reads, e.g. a plain socket does and an SSL stream doesn't.
+    bool probe_before_read = false;
+
+    // If set, async_read_request(), bound_body_reader and chunked_body_reader arm its timeouts
+    // and report boost::asio::error::timed_out when they expire. The synchronous functions ignore it.
+    // It must outlive the operations.
+    connection_timeouts_t *timeouts = nullptr;
+};
+
+
+// Tracks how many bytes the next read should prepare according to read_options_t.
+class read_size_t {
+public:
+    explicit read_size_t(const read_options_t &options = read_options_t()) :
+        m_min(options.read_buffer_size),
+        m_max(std::max(options.read_buffer_size, options.max_read_buffer_size)),
+        m_size(options.read_buffer_size)
+    { }
+
+    std::size_t get() const {
+        return m_size;
+    }
+
+    // Call after every read with the number of bytes it returned.
+    void update(std::size_t transferred) {
+        if (transferred >= m_size) {
+            m_size = std::min(m_size * 2, m_max);
+        } else if (transferred < m_size / 2) {
+            m_size = std::max(m_size / 2, m_min);
+        }
+    }
+
+private:
+    std::size_t m_min;
+    std::size_t m_max;
+    std::size_t m_size;
 };
 
 HTTPLIB_CLOSE_NAMESPACE
@@ -3,6 +3,7 @@
 #include <httplib/detail/common.hpp>
 #include <httplib/http/request.hpp>
 #include <httplib/asio/read_options.hpp>
+#include <httplib/parser/request_parser.hpp>
 
 #include <boost/asio/async_result.hpp>
 
@@ -10,6 +11,8 @@
 HTTPLIB_OPEN_NAMESPACE
 
 
+// The request is moved into the handler, so the handler may take it by value or by rvalue reference
+// without copying.
 template<class BufferedReadStream, class Handler>
 typename boost::asio::async_result<
     typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_request_t&)>::type
@@ -24,6 +27,36 @@ typename boost::asio::async_result<
 async_read_request(BufferedReadStream &stream, Handler handler);
 
 
+// The same, but reuse the parser, e.g. one per connection, instead of creating a new one for every request.
+// The parser is reset before reading, the request passed to the handler is the one stored in the parser.
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_request_t&)>::type
+>::type
+async_read_request(BufferedReadStream &stream,
+                   http_request_parser_t &parser,
+                   read_options_t options,
+                   Handler handler);
+
+
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_request_t&)>::type
+>::type
+async_read_request(BufferedReadStream &stream, http_request_parser_t &parser, Handler handler);
+
+
+template<class BufferedReadStream>
+const http_request_t &read_request(BufferedReadStream &stream,
+                                   http_request_parser_t &parser,
+                                   read_options_t options,
+                                   boost::system::error_code &ec);
+
+
+template<class BufferedReadStream>
+const http_request_t &read_request(BufferedReadStream &stream, http_request_parser_t &parser, read_options_t options);
+
+
 template<class BufferedReadStream>
 http_request_t read_request(BufferedReadStream &stream,
                             read_options_t options,
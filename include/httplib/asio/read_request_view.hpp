@@ -0,0 +1,48 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/request_view.hpp>
+#include <httplib/asio/read_options.hpp>
+#include <httplib/parser/request_view_parser.hpp>
+
+#include <boost/asio/async_result.hpp>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+// These functions read a request head without copying it out of the stream's buffer when the whole head
+// is already there. The view passed to the handler is valid until the handler returns or
+// the next operation on the stream, whichever comes first. Use to_request() to keep it for longer.
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_request_view_t&)>::type
+>::type
+async_read_request_view(BufferedReadStream &stream, read_options_t options, Handler handler);
+
+
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_request_view_t&)>::type
+>::type
+async_read_request_view(BufferedReadStream &stream, Handler handler);
+
+
+// The returned view refers to the parser, so it's valid until the parser is destroyed
+// or the next operation on the stream, whichever comes first.
+template<class BufferedReadStream>
+const http_request_view_t &read_request_view(BufferedReadStream &stream,
+                                             http_request_view_parser_t &parser,
+                                             read_options_t options,
+                                             boost::system::error_code &ec);
+
+
+template<class BufferedReadStream>
+const http_request_view_t &read_request_view(BufferedReadStream &stream,
+                                             http_request_view_parser_t &parser,
+                                             read_options_t options);
+
+
+HTTPLIB_CLOSE_NAMESPACE
+
+#include <httplib/asio/impl/read_request_view.hpp>
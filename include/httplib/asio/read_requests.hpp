@@ -0,0 +1,63 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/request.hpp>
+#include <httplib/asio/read_options.hpp>
+#include <httplib/parser/request_parser.hpp>
+
+#include <boost/asio/async_result.hpp>
+
+#include <vector>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+// Read a batch of pipelined requests.
+// The stream is read until at least one request head is complete, then all the complete request heads already
+// in the buffer are parsed too, without reading the stream and posting to the io_service again.
+// The batch ends after the first request with a body, since the body must be read before the next request,
+// so only the last request of a batch may have a body.
+// The requests are stored into the vector in the order they were received, the previous content is cleared.
+// The parser keeps a partially received head between the calls, so use the same parser for the whole connection.
+// If a request is malformed, the requests before it are returned without an error and
+// the error is reported by the next call.
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code)>::type
+>::type
+async_read_requests(BufferedReadStream &stream,
+                    http_request_parser_t &parser,
+                    std::vector<http_request_t> &requests,
+                    read_options_t options,
+                    Handler handler);
+
+
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code)>::type
+>::type
+async_read_requests(BufferedReadStream &stream,
+                    http_request_parser_t &parser,
+                    std::vector<http_request_t> &requests,
+                    Handler handler);
+
+
+template<class BufferedReadStream>
+void read_requests(BufferedReadStream &stream,
+                   http_request_parser_t &parser,
+                   std::vector<http_request_t> &requests,
+                   read_options_t options,
+                   boost::system::error_code &ec);
+
+
+template<class BufferedReadStream>
+void read_requests(BufferedReadStream &stream,
+                   http_request_parser_t &parser,
+                   std::vector<http_request_t> &requests,
+                   read_options_t options);
+
+
+HTTPLIB_CLOSE_NAMESPACE
+
+#include <httplib/asio/impl/read_requests.hpp>
@@ -10,6 +10,8 @@
 HTTPLIB_OPEN_NAMESPACE
 
 
+// The response is moved into the handler, so the handler may take it by value or by rvalue reference
+// without copying.
 template<class BufferedReadStream, class Handler>
 typename boost::asio::async_result<
     typename boost::asio::handler_type<Handler, void(boost::system::error_code, const http_response_t&)>::type
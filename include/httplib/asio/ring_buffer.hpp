@@ -0,0 +1,156 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/container/static_vector.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+// A fixed-capacity read buffer for buffered_read_stream.
+// Unlike boost::asio::streambuf it never moves the data once it's read: the readable and the writable regions
+// wrap around the end of the memory instead, so data() and prepare() return up to two buffers each.
+// When all the data is consumed, the buffer starts over from the beginning of the memory,
+// so a message read into an empty buffer is contiguous unless it's bigger than the capacity.
+// The memory is allocated on the first prepare() call.
+class ring_buffer_t {
+public:
+    using const_buffers_type = boost::container::static_vector<boost::asio::const_buffer, 2>;
+    using mutable_buffers_type = boost::container::static_vector<boost::asio::mutable_buffer, 2>;
+
+    static constexpr std::size_t default_capacity = 16 * 1024;
+
+public:
+    explicit ring_buffer_t(std::size_t capacity = default_capacity) :
+        m_capacity(capacity),
+        m_begin(0),
+        m_size(0),
+        m_prepared(0)
+    {
+        assert(m_capacity > 0);
+    }
+
+    ring_buffer_t(const ring_buffer_t &) = delete;
+    ring_buffer_t(ring_buffer_t &&) = default;
+
+    ring_buffer_t &operator=(const ring_buffer_t &) = delete;
+    ring_buffer_t &operator=(ring_buffer_t &&) = default;
+
+    std::size_t size() const {
+        return m_size;
+    }
+
+    std::size_t max_size() const {
+        return m_capacity;
+    }
+
+    std::size_t capacity() const {
+        return m_capacity;
+    }
+
+    const_buffers_type data() const {
+        const_buffers_type result;
+
+        if (m_size == 0) {
+            return result;
+        }
+
+        std::size_t first = std::min(m_size, m_capacity - m_begin);
+
+        result.emplace_back(m_data.get() + m_begin, first);
+
+        if (first < m_size) {
+            result.emplace_back(m_data.get(), m_size - first);
+        }
+
+        return result;
+    }
+
+    // Returns at most size bytes of the free space.
+    // Readers only ask for "some" space, so unlike DynamicBuffer::prepare() it returns less than asked
+    // when the buffer is almost full, and throws std::length_error only when it's completely full.
+    mutable_buffers_type prepare(std::size_t size) {
+        if (m_size == m_capacity) {
+            throw std::length_error("httplib::ring_buffer_t is full");
+        }
+
+        if (!m_data) {
+            m_data.reset(new char[m_capacity]);
+        }
+
+        m_prepared = std::min(size, m_capacity - m_size);
+
+        mutable_buffers_type result;
+
+        if (m_prepared == 0) {
+            return result;
+        }
+
+        std::size_t end = (m_begin + m_size) % m_capacity;
+        std::size_t first = std::min(m_prepared, m_capacity - end);
+
+        result.emplace_back(m_data.get() + end, first);
+
+        if (first < m_prepared) {
+            result.emplace_back(m_data.get(), m_prepared - first);
+        }
+
+        return result;
+    }
+
+    void commit(std::size_t size) {
+        m_size += std::min(size, m_prepared);
+        m_prepared = 0;
+    }
+
+    // The consumed data stays in memory until the free space is written to.
+    void consume(std::size_t size) {
+        size = std::min(size, m_size);
+
+        m_begin = (m_begin + size) % m_capacity;
+        m_size -= size;
+
+        if (m_size == 0) {
+            m_begin = 0;
+        }
+    }
+
+    // Frees the memory if the buffer is empty. The next prepare() allocates it again.
+    void release() {
+        if (m_size == 0) {
+            m_data.reset();
+        }
+    }
+
+private:
+    std::unique_ptr<char[]> m_data;
+    std::size_t m_capacity;
+    std::size_t m_begin;
+    std::size_t m_size;
+    std::size_t m_prepared;
+};
+
+
+namespace detail {
+
+// Read operations call it when the stream has nothing to read, to not hold the memory while waiting for data.
+// Buffers other than ring_buffer_t keep their memory.
+template<class Buffer>
+void release_read_buffer(Buffer &) { }
+
+inline void release_read_buffer(ring_buffer_t &buffer) {
+    buffer.release();
+}
+
+} // namespace detail
+
+
+HTTPLIB_CLOSE_NAMESPACE
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/serialize.hpp>
+
+#include <boost/asio/buffer.hpp>
+
+#include <string>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+// Write the head into a DynamicBuffer (e.g. boost::asio::streambuf) and commit it.
+// A head fitting into the first prepared buffer is serialized right there, otherwise it goes through a temporary string.
+template<class DynamicBuffer, class Message>
+void serialize_head(const Message &message, DynamicBuffer &buffer) {
+    const std::size_t size = serialized_size(message);
+    auto buffers = buffer.prepare(size);
+    auto first = buffers.begin();
+
+    if (first != buffers.end() && boost::asio::buffer_size(*first) >= size) {
+        serialize_head(message, boost::asio::buffer_cast<char *>(*first));
+    } else {
+        std::string temporary;
+        serialize_head(message, temporary);
+        boost::asio::buffer_copy(buffers, boost::asio::buffer(temporary));
+    }
+
+    buffer.commit(size);
+}
+
+
+HTTPLIB_CLOSE_NAMESPACE
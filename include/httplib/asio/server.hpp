@@ -0,0 +1,140 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/request.hpp>
+#include <httplib/http/status_code.hpp>
+#include <httplib/asio/connection_timeouts.hpp>
+#include <httplib/asio/read_options.hpp>
+#include <httplib/response_builder.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/socket_base.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+// A minute to wait for a request, ten seconds to send its head and at least 1 KiB/s for its body.
+inline connection_timeout_options_t default_server_timeouts() {
+    connection_timeout_options_t result;
+    result.idle = std::chrono::seconds(60);
+    result.head = std::chrono::seconds(10);
+    result.min_body_rate = 1024;
+    result.body_rate_interval = std::chrono::seconds(10);
+    return result;
+}
+
+
+struct server_options_t {
+    // The number of threads, each running its own io_service. 0 means one per CPU available to the process.
+    std::size_t threads = 0;
+
+    // Pin the threads to the CPUs available to the process, one per CPU. Linux only, ignored elsewhere.
+    bool pin_threads = true;
+
+    // Give every thread its own SO_REUSEPORT acceptor, so the kernel spreads the connections among the threads
+    // and a connection is served by the thread which accepted it.
+    // Without it, or where SO_REUSEPORT is not supported, the first thread accepts all the connections
+    // and hands them out to the threads in turn.
+    bool reuse_port = true;
+
+    // The length of the queue of pending connections of each acceptor.
+    int backlog = boost::asio::socket_base::max_connections;
+
+    // The timeouts field is set by the server for every connection.
+    read_options_t read_options;
+
+    // A connection which times out is closed. Each thread keeps the timeouts of its connections in a timer_wheel_t
+    // ticking every timeout_resolution.
+    connection_timeout_options_t timeouts = default_server_timeouts();
+    std::chrono::milliseconds timeout_resolution{100};
+
+    // A request with a bigger body is answered with 413 and the connection is closed.
+    std::size_t max_body_size = 1024 * 1024;
+
+    // How long an acceptor waits after a failed accept, e.g. with EMFILE, before accepting again.
+    // Such an error usually persists for a while, and accepting right away would spin the thread.
+    std::chrono::milliseconds accept_error_delay{100};
+};
+
+
+// What a request handler of server_t fills in.
+// The server sets Content-Length, and Connection when it closes the connection after the response.
+struct server_response_t {
+    // Prepared for the request by prepare_response().
+    http_response_builder_t builder;
+
+    status_code_t status = STATUS_200_OK;
+
+    std::string body;
+};
+
+
+// Called in the thread of the connection for every request once its body is read.
+// An exception thrown by the handler is answered with 500 and the connection is closed.
+using server_handler_t = std::function<void(const http_request_t &request,
+                                            const std::string &body,
+                                            server_response_t &response)>;
+
+
+namespace detail {
+
+class server_worker_t;
+
+} // namespace detail
+
+
+// A multi-threaded HTTP/1.1 server with one io_service per thread and keep-alive connections.
+// A connection stays in the thread it's started in for its whole lifetime, reading the requests one after another.
+class server_t {
+public:
+    explicit server_t(server_handler_t handler, server_options_t options = {});
+
+    server_t(const server_t &) = delete;
+    server_t &operator=(const server_t &) = delete;
+
+    // Stops the server and waits for the threads.
+    ~server_t();
+
+    // Binds the acceptors and starts the threads.
+    // Throws boost::system::system_error if the endpoint can't be bound.
+    void start(const boost::asio::ip::tcp::endpoint &endpoint);
+
+    // Gracefully stops the server and returns right away: the acceptors are closed,
+    // the connections waiting for a request are closed and the requests in progress are answered
+    // with Connection: close. Each thread exits when all its connections are closed.
+    // May be called from any thread.
+    void stop();
+
+    // Waits for the threads to exit after stop().
+    void join();
+
+    // The endpoint the server listens on, e.g. to find out the port chosen for port 0.
+    boost::asio::ip::tcp::endpoint local_endpoint() const;
+
+    // The number of failed accepts since the start, e.g. because the process ran out of descriptors.
+    // May be called from any thread.
+    std::size_t accept_errors() const;
+
+private:
+    friend class detail::server_worker_t;
+
+    server_handler_t m_handler;
+    server_options_t m_options;
+    std::vector<std::unique_ptr<detail::server_worker_t>> m_workers;
+    std::atomic<std::size_t> m_accept_errors;
+};
+
+
+HTTPLIB_CLOSE_NAMESPACE
+
+#include <httplib/asio/impl/server.hpp>
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+
+#ifdef __linux__
+
+#include <httplib/http/misc.hpp>
+#include <httplib/http/request.hpp>
+#include <httplib/http/response.hpp>
+#include <httplib/asio/read_options.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/system/error_code.hpp>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+// These functions move the message body from the stream into the file descriptor, e.g. a file or another socket.
+// The part of the body already in the stream's buffer is written first. The rest of a body with Content-Length
+// is moved with splice() through a pipe, so it never gets copied into the user space.
+// Other bodies (chunked, until EOF) are copied through body_reader.
+// The stream must be a socket, since its native_handle() is spliced.
+// The synchronous functions wait for the descriptor while it's full, whatever its mode.
+// The number of body bytes written to the descriptor is returned or passed to the handler.
+template<class BufferedReadStream>
+content_length_int_t splice_body(const http_request_t &request,
+                                 BufferedReadStream &stream,
+                                 int fd,
+                                 read_options_t options,
+                                 boost::system::error_code &ec);
+
+
+template<class BufferedReadStream>
+content_length_int_t splice_body(const http_request_t &request,
+                                 BufferedReadStream &stream,
+                                 int fd,
+                                 read_options_t options = {});
+
+
+template<class BufferedReadStream>
+content_length_int_t splice_body(const http_response_t &response,
+                                 BufferedReadStream &stream,
+                                 int fd,
+                                 read_options_t options,
+                                 boost::system::error_code &ec);
+
+
+template<class BufferedReadStream>
+content_length_int_t splice_body(const http_response_t &response,
+                                 BufferedReadStream &stream,
+                                 int fd,
+                                 read_options_t options = {});
+
+
+// The asynchronous functions never block the thread. The socket and the descriptor are switched to the non-blocking
+// mode for the time of the operation, and both are waited for in the io_service, so the descriptor may be a pipe
+// or another socket as well as a file. Their modes are restored before the handler is called.
+// Nothing else may use the descriptor until then.
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, content_length_int_t)>::type
+>::type
+async_splice_body(const http_request_t &request,
+                  BufferedReadStream &stream,
+                  int fd,
+                  read_options_t options,
+                  Handler handler);
+
+
+template<class BufferedReadStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, content_length_int_t)>::type
+>::type
+async_splice_body(const http_response_t &response,
+                  BufferedReadStream &stream,
+                  int fd,
+                  read_options_t options,
+                  Handler handler);
+
+
+HTTPLIB_CLOSE_NAMESPACE
+
+#include <httplib/asio/impl/splice_body.hpp>
+
+#endif // __linux__
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+namespace detail {
+
+// A node of a circular doubly linked list. An unlinked node points to itself.
+struct timer_link_t {
+    timer_link_t *prev;
+    timer_link_t *next;
+
+    timer_link_t() :
+        prev(this),
+        next(this)
+    { }
+
+    timer_link_t(const timer_link_t &) = delete;
+    timer_link_t &operator=(const timer_link_t &) = delete;
+
+    bool empty() const {
+        return next == this;
+    }
+
+    void link_before(timer_link_t &node) {
+        prev = node.prev;
+        next = &node;
+        node.prev->next = this;
+        node.prev = this;
+    }
+
+    void unlink() {
+        prev->next = next;
+        next->prev = prev;
+        prev = this;
+        next = this;
+    }
+};
+
+} // namespace detail
+
+
+// Timeouts for many connections with one steady_timer.
+// A hashed timer wheel: a timer is armed into the slot the wheel reaches when it expires,
+// with the number of full turns to wait, so arming, rearming and canceling are O(1) and allocate nothing.
+// The wheel ticks every resolution while any timer is armed and expires the timers of the slot it reaches,
+// so a timer expires no earlier than its timeout and at most two ticks later.
+// Not thread-safe: use it and its timers in the thread running the io_service.
+// The wheel must outlive the handlers of the io_service, e.g. be destroyed after io_service::run() returns.
+class timer_wheel_t {
+public:
+    class timer_t;
+
+    static constexpr std::size_t default_slots = 512;
+
+public:
+    explicit timer_wheel_t(boost::asio::io_service &io_service,
+                           std::chrono::milliseconds resolution = std::chrono::milliseconds(100),
+                           std::size_t slots = default_slots) :
+        m_timer(io_service),
+        m_resolution(resolution),
+        m_slots(slots),
+        m_current(0),
+        m_armed(0),
+        m_ticking(false)
+    {
+        assert(m_resolution.count() > 0);
+        assert(slots > 0);
+    }
+
+    timer_wheel_t(const timer_wheel_t &) = delete;
+    timer_wheel_t &operator=(const timer_wheel_t &) = delete;
+
+    // Cancels the timers still armed.
+    ~timer_wheel_t();
+
+    std::chrono::milliseconds resolution() const {
+        return m_resolution;
+    }
+
+    // The number of armed timers.
+    std::size_t armed() const {
+        return m_armed;
+    }
+
+    // Arms the timer, or rearms it if it's already armed in this or another wheel.
+    void arm(timer_t &timer, std::chrono::milliseconds timeout);
+
+private:
+    void start_ticking();
+    void tick();
+
+private:
+    boost::asio::steady_timer m_timer;
+    std::chrono::milliseconds m_resolution;
+    std::vector<detail::timer_link_t> m_slots;
+    std::size_t m_current;
+    std::size_t m_armed;
+    bool m_ticking;
+};
+
+
+// A timer of a timer_wheel_t. It's meant to be a member of the object it times out, e.g. a connection.
+class timer_wheel_t::timer_t : private detail::timer_link_t {
+public:
+    // on_expiry is called by the wheel when the timer expires. It may arm and cancel timers, this one included.
+    explicit timer_t(std::function<void()> on_expiry) :
+        m_wheel(nullptr),
+        m_rounds(0),
+        m_on_expiry(std::move(on_expiry))
+    { }
+
+    timer_t(const timer_t &) = delete;
+    timer_t &operator=(const timer_t &) = delete;
+
+    ~timer_t() {
+        cancel();
+    }
+
+    bool armed() const {
+        return m_wheel != nullptr;
+    }
+
+    void cancel() {
+        if (m_wheel) {
+            unlink();
+            --m_wheel->m_armed;
+            m_wheel = nullptr;
+        }
+    }
+
+private:
+    friend class timer_wheel_t;
+
+    // The wheel the timer is armed in.
+    timer_wheel_t *m_wheel;
+
+    // How many more times the wheel reaches the slot of the timer before it expires.
+    std::size_t m_rounds;
+
+    std::function<void()> m_on_expiry;
+};
+
+
+inline timer_wheel_t::~timer_wheel_t() {
+    for (auto &slot: m_slots) {
+        while (!slot.empty()) {
+            static_cast<timer_t *>(slot.next)->cancel();
+        }
+    }
+}
+
+inline void timer_wheel_t::arm(timer_t &timer, std::chrono::milliseconds timeout) {
+    timer.cancel();
+
+    // The next tick comes in up to one resolution, so one more tick makes sure the timeout passes.
+    auto ticks = static_cast<std::size_t>((timeout.count() + m_resolution.count() - 1) / m_resolution.count()) + 1;
+
+    timer.m_rounds = (ticks - 1) / m_slots.size();
+    timer.link_before(m_slots[(m_current + ticks) % m_slots.size()]);
+    timer.m_wheel = this;
+    ++m_armed;
+
+    if (!m_ticking) {
+        start_ticking();
+    }
+}
+
+inline void timer_wheel_t::start_ticking() {
+    m_ticking = true;
+    m_timer.expires_from_now(m_resolution);
+
+    m_timer.async_wait([this](boost::system::error_code ec) {
+        if (!ec) {
+            this->tick();
+        }
+    });
+}
+
+inline void timer_wheel_t::tick() {
+    m_current = (m_current + 1) % m_slots.size();
+
+    auto &slot = m_slots[m_current];
+
+    // Take the slot's timers out, so the ones armed again by the callbacks don't expire in this tick.
+    detail::timer_link_t due;
+
+    if (!slot.empty()) {
+        due.next = slot.next;
+        due.prev = slot.prev;
+        due.next->prev = &due;
+        due.prev->next = &due;
+        slot.next = &slot;
+        slot.prev = &slot;
+    }
+
+    try {
+        while (!due.empty()) {
+            auto *timer = static_cast<timer_t *>(due.next);
+            timer->unlink();
+
+            if (timer->m_rounds > 0) {
+                --timer->m_rounds;
+                timer->link_before(slot);
+                continue;
+            }
+
+            timer->m_wheel = nullptr;
+            --m_armed;
+            timer->m_on_expiry();
+        }
+    } catch (...) {
+        // Put back the timers which haven't been checked yet.
+        while (!due.empty()) {
+            auto *timer = static_cast<timer_t *>(due.next);
+            timer->unlink();
+            timer->link_before(slot);
+        }
+
+        m_ticking = false;
+
+        if (m_armed > 0) {
+            start_ticking();
+        }
+
+        throw;
+    }
+
+    if (m_armed == 0) {
+        m_ticking = false;
+        return;
+    }
+
+    // Count from the previous expiry, so the ticks don't drift.
+    m_timer.expires_at(m_timer.expires_at() + m_resolution);
+
+    m_timer.async_wait([this](boost::system::error_code ec) {
+        if (!ec) {
+            this->tick();
+        }
+    });
+}
+
+
+HTTPLIB_CLOSE_NAMESPACE
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#define HTTPLIB_HAS_COROUTINES 1
+
+#include <httplib/asio/handler_memory.hpp>
+
+#include <boost/asio/async_result.hpp>
+
+#include <cassert>
+#include <coroutine>
+#include <cstdlib>
+#include <exception>
+#include <optional>
+#include <tuple>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+// A coroutine started right away and running on its own, e.g. one per connection:
+//     httplib::detached_task_t serve(tcp::socket socket) {
+//         ...
+//         auto [ec, request] = co_await httplib::async_read_request(stream, parser, {}, httplib::use_awaitable);
+//     }
+// The frame holds all the state of the connection and the memory of its operations,
+// so awaiting an operation allocates nothing. The coroutine must not let exceptions escape.
+class detached_task_t {
+public:
+    class promise_type;
+};
+
+
+// The completion token which makes the asynchronous functions of the library return an awaitable.
+// An operation may be awaited only in a detached_task_t coroutine.
+// The awaitable returns the arguments of the handler as a tuple, or the only argument as is.
+// References among them (e.g. the request read with a reused parser) are valid until the next co_await.
+// The coroutine is resumed by the completion handler, so it runs in the thread running the io_service,
+// and its operations must not complete in another thread before it's suspended,
+// i.e. the io_service of a connection must be run by one thread.
+struct use_awaitable_t { };
+
+inline constexpr use_awaitable_t use_awaitable{};
+
+
+namespace detail {
+
+// The state of a detached_task_t shared with the handlers of the operations it awaits.
+struct awaitable_frame_t {
+    std::coroutine_handle<> coroutine;
+
+    // The awaiter of the pending operation.
+    void *awaiter = nullptr;
+
+    handler_memory_t memory;
+
+    // The frame which was running when this one was resumed.
+    awaitable_frame_t *previous = nullptr;
+
+    // The frame running in this thread. The handlers of the operations it starts resume it.
+    static awaitable_frame_t *&current() {
+        static thread_local awaitable_frame_t *frame = nullptr;
+        return frame;
+    }
+
+    void enter() {
+        previous = current();
+        current() = this;
+    }
+
+    void leave() {
+        current() = previous;
+        previous = nullptr;
+    }
+};
+
+
+template<class... Args>
+class awaiter_t {
+public:
+    using result_type = std::conditional_t<
+        sizeof...(Args) == 1,
+        std::tuple_element_t<0, std::tuple<Args..., void>>,
+        std::tuple<Args...>
+    >;
+
+    explicit awaiter_t(awaitable_frame_t *frame) :
+        m_frame(frame)
+    { }
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> coroutine) noexcept {
+        m_frame->coroutine = coroutine;
+        m_frame->awaiter = this;
+        m_frame->leave();
+    }
+
+    result_type await_resume() {
+        m_frame->enter();
+        return result(std::index_sequence_for<Args...>());
+    }
+
+    void complete(Args... args) {
+        m_result.emplace(std::forward<Args>(args)...);
+    }
+
+private:
+    template<std::size_t... Indices>
+    result_type result(std::index_sequence<Indices...>) {
+        return result_type(std::get<Indices>(std::move(*m_result))...);
+    }
+
+private:
+    awaitable_frame_t *m_frame;
+    std::optional<std::tuple<Args...>> m_result;
+};
+
+
+template<class... Args>
+class awaitable_handler {
+public:
+    awaitable_handler(use_awaitable_t) :
+        m_frame(awaitable_frame_t::current())
+    {
+        // Awaited outside of a detached_task_t.
+        assert(m_frame);
+    }
+
+    awaitable_frame_t *frame() const {
+        return m_frame;
+    }
+
+    void operator()(Args... args) {
+        // The operation has completed before the coroutine is suspended, i.e. in another thread.
+        assert(m_frame->awaiter);
+
+        auto *awaiter = static_cast<awaiter_t<Args...> *>(m_frame->awaiter);
+        m_frame->awaiter = nullptr;
+
+        awaiter->complete(std::forward<Args>(args)...);
+        m_frame->coroutine.resume();
+    }
+
+    friend void *asio_handler_allocate(std::size_t size, awaitable_handler *context) {
+        return context->m_frame->memory.allocate(size);
+    }
+
+    friend void asio_handler_deallocate(void *pointer, std::size_t size, awaitable_handler *context) {
+        context->m_frame->memory.deallocate(pointer, size);
+    }
+
+private:
+    awaitable_frame_t *m_frame;
+};
+
+} // namespace detail
+
+
+class detached_task_t::promise_type {
+public:
+    detached_task_t get_return_object() noexcept {
+        return {};
+    }
+
+    auto initial_suspend() noexcept {
+        struct enter_t {
+            awaitable_frame_t &frame;
+
+            bool await_ready() const noexcept {
+                return true;
+            }
+
+            void await_suspend(std::coroutine_handle<>) const noexcept { }
+
+            void await_resume() const noexcept {
+                frame.enter();
+            }
+        };
+
+        return enter_t{m_frame};
+    }
+
+    auto final_suspend() noexcept {
+        struct leave_t {
+            awaitable_frame_t &frame;
+
+            bool await_ready() const noexcept {
+                frame.leave();
+                return true;
+            }
+
+            void await_suspend(std::coroutine_handle<>) const noexcept { }
+
+            void await_resume() const noexcept { }
+        };
+
+        return leave_t{m_frame};
+    }
+
+    void return_void() noexcept { }
+
+    void unhandled_exception() noexcept {
+        std::terminate();
+    }
+
+private:
+    using awaitable_frame_t = detail::awaitable_frame_t;
+
+    awaitable_frame_t m_frame;
+};
+
+
+HTTPLIB_CLOSE_NAMESPACE
+
+
+namespace boost {
+namespace asio {
+
+template<class R, class... Args>
+struct handler_type<HTTPLIB_NAMESPACE::use_awaitable_t, R(Args...)> {
+    using type = HTTPLIB_NAMESPACE::detail::awaitable_handler<Args...>;
+};
+
+
+template<class... Args>
+class async_result<HTTPLIB_NAMESPACE::detail::awaitable_handler<Args...>> {
+public:
+    using type = HTTPLIB_NAMESPACE::detail::awaiter_t<Args...>;
+
+    explicit async_result(HTTPLIB_NAMESPACE::detail::awaitable_handler<Args...> &handler) :
+        m_frame(handler.frame())
+    { }
+
+    type get() {
+        return type(m_frame);
+    }
+
+private:
+    HTTPLIB_NAMESPACE::detail::awaitable_frame_t *m_frame;
+};
+
+} // namespace asio
+} // namespace boost
+
+#endif
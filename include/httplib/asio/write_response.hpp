@@ -0,0 +1,59 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/response.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+// Write the response head followed by the body with a single gathering write.
+// The header values are not copied: the buffers point directly to them and to the body,
+// so the response and the body must stay alive and unchanged until the operation completes.
+// Each header name is copied along with the separators around it, so a header value takes two buffers.
+// asio passes at most 64 buffers to a single writev(), so a response with more than about 30 header values
+// and body buffers is sent with several system calls.
+
+
+template<class AsyncWriteStream, class ConstBufferSequence, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type
+>::type
+async_write_response(AsyncWriteStream &stream,
+                     const http_response_t &response,
+                     const ConstBufferSequence &body,
+                     Handler handler);
+
+
+template<class AsyncWriteStream, class Handler>
+typename boost::asio::async_result<
+    typename boost::asio::handler_type<Handler, void(boost::system::error_code, std::size_t)>::type
+>::type
+async_write_response(AsyncWriteStream &stream, const http_response_t &response, Handler handler);
+
+
+template<class SyncWriteStream, class ConstBufferSequence>
+std::size_t write_response(SyncWriteStream &stream,
+                           const http_response_t &response,
+                           const ConstBufferSequence &body,
+                           boost::system::error_code &ec);
+
+
+template<class SyncWriteStream, class ConstBufferSequence>
+std::size_t write_response(SyncWriteStream &stream, const http_response_t &response, const ConstBufferSequence &body);
+
+
+template<class SyncWriteStream>
+std::size_t write_response(SyncWriteStream &stream, const http_response_t &response, boost::system::error_code &ec);
+
+
+template<class SyncWriteStream>
+std::size_t write_response(SyncWriteStream &stream, const http_response_t &response);
+
+
+HTTPLIB_CLOSE_NAMESPACE
+
+#include <httplib/asio/impl/write_response.hpp>
@@ -37,6 +37,18 @@ boost::system::error_condition make_error_condition(reader_errc_t e) noexcept;
 const boost::system::error_category &reader_category() noexcept;
 
 
+enum class client_errc_t {
+    bad_response = 1,
+    body_too_large
+};
+
+
+boost::system::error_code make_error_code(client_errc_t e) noexcept;
+boost::system::error_condition make_error_condition(client_errc_t e) noexcept;
+
+const boost::system::error_category &client_category() noexcept;
+
+
 HTTPLIB_CLOSE_NAMESPACE
 
 
@@ -48,4 +60,7 @@ struct is_error_condition_enum<httplib::parser_errc_t> : std::true_type { };
 template<>
 struct is_error_code_enum<httplib::reader_errc_t> : std::true_type { };
 
+template<>
+struct is_error_code_enum<httplib::client_errc_t> : std::true_type { };
+
 }} // namespace boost::system
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+
+#include <boost/utility/string_view.hpp>
+
+#include <cstdlib>
+#include <ctime>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+// Size of an IMF-fixdate (rfc7231), e.g. "Sun, 06 Nov 1994 08:49:37 GMT".
+constexpr std::size_t http_date_size = 29;
+
+
+// Writes exactly http_date_size characters.
+void format_http_date(std::time_t time, char *output);
+
+
+// The current time as an IMF-fixdate.
+// The string is formatted at most once per second and shared by all threads, reading it takes no locks.
+// The result stays valid for at least several seconds (until the cache wraps around), copy it to keep it longer.
+boost::string_view current_http_date();
+
+
+HTTPLIB_CLOSE_NAMESPACE
@@ -1,16 +1,20 @@
 #pragma once
 
 #include <httplib/detail/common.hpp>
+#include <httplib/http/known_headers.hpp>
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/container/small_vector.hpp>
 #include <boost/optional.hpp>
 #include <boost/utility/string_view.hpp>
 
+#include <array>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
-#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 
 HTTPLIB_OPEN_NAMESPACE
@@ -30,14 +34,20 @@ namespace detail {
 } // namespace detail
 
 
+// Headers are kept in a flat array in the order they were added.
+// Typical messages have a couple dozen headers at most, so a linear scan is faster than any tree.
+// If there are more distinct names than index_threshold, a hash index over the case-folded names is built.
+// Positions of the known headers are tracked separately, so looking them up costs a perfect hash or nothing.
 class http_headers_t {
 public:
     using header_name_t = std::string;
     using header_value_t = std::string;
     using header_values_t = boost::container::small_vector<header_value_t, 3>;
 
+    static constexpr std::size_t index_threshold = 16;
+
 private:
-    using container_t = std::map<header_name_t, header_values_t, detail::ilexicographical_less_t>;
+    using container_t = std::vector<std::pair<header_name_t, header_values_t>>;
 
 public:
     using const_iterator = container_t::const_iterator;
@@ -45,7 +55,8 @@ public:
 
 public:
     http_headers_t() :
-        m_size(0)
+        m_size(0),
+        m_known()
     { }
 
     template<class It>
@@ -83,24 +94,65 @@ public:
         return m_headers.end();
     }
 
-    const_iterator find(boost::string_view name) const {
-        return m_headers.find(name);
+    const_iterator find(boost::string_view name) const;
+
+    const_iterator find(known_header_t name) const {
+        std::uint32_t position = m_known[static_cast<std::size_t>(name)];
+        return position == 0 ? m_headers.end() : m_headers.begin() + (position - 1);
     }
 
     bool has(boost::string_view name) const {
         return static_cast<bool>(get_header_values(name));
     }
 
+    bool has(known_header_t name) const {
+        return find(name) != end();
+    }
+
     boost::optional<const header_value_t &> get_header(boost::string_view name) const;
+    boost::optional<const header_value_t &> get_header(known_header_t name) const;
     boost::optional<const header_values_t &> get_header_values(boost::string_view name) const;
+    boost::optional<const header_values_t &> get_header_values(known_header_t name) const;
 
     void set_header(boost::string_view name, const header_values_t &values);
     void add_header_values(boost::string_view name, const header_values_t &values);
     void remove_header(boost::string_view name);
 
+    void set_header(known_header_t name, const header_values_t &values) {
+        set_header(known_header_name(name), values);
+    }
+
+    void add_header_values(known_header_t name, const header_values_t &values) {
+        add_header_values(known_header_name(name), values);
+    }
+
+    void remove_header(known_header_t name) {
+        remove_header(known_header_name(name));
+    }
+
+    // Remove all headers, but keep the allocated memory.
+    void clear() {
+        m_size = 0;
+        m_headers.clear();
+        m_known.fill(0);
+        m_index.clear();
+    }
+
+private:
+    container_t::iterator find_mutable(boost::string_view name);
+    void rebuild_index();
+    void add_to_index(std::size_t position);
+
 private:
     size_t m_size;
     container_t m_headers;
+
+    // Positions in m_headers plus one, zero means there is no such header.
+    std::array<std::uint32_t, known_headers_count> m_known;
+
+    // Open addressing table of positions of the other headers, the same encoding.
+    // Empty while there are few headers.
+    std::vector<std::uint32_t> m_index;
 };
 
 
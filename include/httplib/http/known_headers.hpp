@@ -0,0 +1,90 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+
+#include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+#define HTTPLIB_KNOWN_HEADERS(X) \
+    X(accept, "Accept") \
+    X(accept_charset, "Accept-Charset") \
+    X(accept_encoding, "Accept-Encoding") \
+    X(accept_language, "Accept-Language") \
+    X(accept_ranges, "Accept-Ranges") \
+    X(age, "Age") \
+    X(allow, "Allow") \
+    X(authorization, "Authorization") \
+    X(cache_control, "Cache-Control") \
+    X(connection, "Connection") \
+    X(content_disposition, "Content-Disposition") \
+    X(content_encoding, "Content-Encoding") \
+    X(content_language, "Content-Language") \
+    X(content_length, "Content-Length") \
+    X(content_location, "Content-Location") \
+    X(content_range, "Content-Range") \
+    X(content_type, "Content-Type") \
+    X(cookie, "Cookie") \
+    X(date, "Date") \
+    X(etag, "ETag") \
+    X(expect, "Expect") \
+    X(expires, "Expires") \
+    X(from, "From") \
+    X(host, "Host") \
+    X(if_match, "If-Match") \
+    X(if_modified_since, "If-Modified-Since") \
+    X(if_none_match, "If-None-Match") \
+    X(if_range, "If-Range") \
+    X(if_unmodified_since, "If-Unmodified-Since") \
+    X(keep_alive, "Keep-Alive") \
+    X(last_modified, "Last-Modified") \
+    X(location, "Location") \
+    X(max_forwards, "Max-Forwards") \
+    X(origin, "Origin") \
+    X(pragma, "Pragma") \
+    X(proxy_authenticate, "Proxy-Authenticate") \
+    X(proxy_authorization, "Proxy-Authorization") \
+    X(range, "Range") \
+    X(referer, "Referer") \
+    X(retry_after, "Retry-After") \
+    X(server, "Server") \
+    X(set_cookie, "Set-Cookie") \
+    X(te, "TE") \
+    X(trailer, "Trailer") \
+    X(transfer_encoding, "Transfer-Encoding") \
+    X(upgrade, "Upgrade") \
+    X(user_agent, "User-Agent") \
+    X(vary, "Vary") \
+    X(via, "Via") \
+    X(www_authenticate, "WWW-Authenticate") \
+    X(x_forwarded_for, "X-Forwarded-For")
+
+
+// Headers the library knows by name. They can be looked up in http_headers_t in constant time.
+enum class known_header_t : std::uint8_t {
+#define HTTPLIB_KNOWN_HEADER_ENUM(id, name) id,
+    HTTPLIB_KNOWN_HEADERS(HTTPLIB_KNOWN_HEADER_ENUM)
+#undef HTTPLIB_KNOWN_HEADER_ENUM
+};
+
+
+constexpr std::size_t known_headers_count = 0
+#define HTTPLIB_KNOWN_HEADER_COUNT(id, name) + 1
+    HTTPLIB_KNOWN_HEADERS(HTTPLIB_KNOWN_HEADER_COUNT)
+#undef HTTPLIB_KNOWN_HEADER_COUNT
+;
+
+
+// Case-insensitive. Uses a perfect hash, so it costs one hash and one comparison.
+boost::optional<known_header_t> find_known_header(boost::string_view name);
+
+boost::string_view known_header_name(known_header_t header);
+
+
+HTTPLIB_CLOSE_NAMESPACE
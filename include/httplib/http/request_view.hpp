@@ -0,0 +1,81 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/request.hpp>
+#include <httplib/http/version.hpp>
+
+#include <boost/container/small_vector.hpp>
+#include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
+
+#include <cstdlib>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+struct http_header_view_t {
+    boost::string_view name;
+    boost::string_view value;
+};
+
+
+// Non-owning list of headers in the order they were received.
+// Repeated headers are not merged, so lookups are linear. It's ok for the typical number of headers.
+class http_header_views_t {
+    using container_t = boost::container::small_vector<http_header_view_t, 16>;
+
+public:
+    using const_iterator = container_t::const_iterator;
+
+public:
+    bool empty() const {
+        return m_headers.empty();
+    }
+
+    size_t size() const {
+        return m_headers.size();
+    }
+
+    const_iterator begin() const {
+        return m_headers.begin();
+    }
+
+    const_iterator end() const {
+        return m_headers.end();
+    }
+
+    bool has(boost::string_view name) const;
+
+    // Returns the value only if there is exactly one header with this name.
+    boost::optional<boost::string_view> get_header(boost::string_view name) const;
+
+    void add_header(boost::string_view name, boost::string_view value) {
+        m_headers.push_back(http_header_view_t{name, value});
+    }
+
+    void clear() {
+        m_headers.clear();
+    }
+
+private:
+    container_t m_headers;
+};
+
+
+// The same as http_request_t, but refers to memory owned by someone else (usually the read buffer and the parser).
+struct http_request_view_t {
+    boost::string_view method;
+    boost::string_view target;
+    http_version_t version;
+    http_header_views_t headers;
+};
+
+
+http_request_t to_request(const http_request_view_t &view);
+
+
+std::ostream &operator<<(std::ostream &stream, const http_request_view_t &request);
+
+
+HTTPLIB_CLOSE_NAMESPACE
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/headers.hpp>
+#include <httplib/http/request.hpp>
+#include <httplib/http/response.hpp>
+
+#include <cstdlib>
+#include <string>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+// Serialization of message heads without std::ostream.
+// The output is the same as of the output operators, but it's written in a single pass into memory
+// of the exact size computed beforehand.
+
+
+// Exact size of the serialized head.
+std::size_t serialized_size(const http_request_t &request);
+std::size_t serialized_size(const http_response_t &response);
+
+
+// Write the head to the output, which must have at least serialized_size() bytes.
+// Return the pointer past the last written byte.
+char *serialize_head(const http_request_t &request, char *output);
+char *serialize_head(const http_response_t &response, char *output);
+
+
+// Append the head to the string.
+void serialize_head(const http_request_t &request, std::string &output);
+void serialize_head(const http_response_t &response, std::string &output);
+
+
+// Chunked transfer coding.
+
+// The longest chunk size line: 16 hex digits and CRLF.
+constexpr std::size_t max_chunk_size_line_size = 2 * sizeof(std::size_t) + 2;
+
+
+// Write the chunk size line (e.g. "1f40\r\n") to the output, which must have at least max_chunk_size_line_size bytes.
+// Return the pointer past the last written byte.
+char *serialize_chunk_size_line(std::size_t size, char *output);
+
+
+// Append the last chunk, the trailer headers and the final empty line to the string.
+void serialize_last_chunk(const http_headers_t &trailers, std::string &output);
+
+
+HTTPLIB_CLOSE_NAMESPACE
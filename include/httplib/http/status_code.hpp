@@ -1,101 +1,134 @@
 #pragma once
 
 #include <httplib/detail/common.hpp>
+#include <httplib/http/version.hpp>
 
+#include <boost/optional.hpp>
 #include <boost/utility/string_view.hpp>
 
+#include <cstdlib>
 #include <string>
 
 
 HTTPLIB_OPEN_NAMESPACE
 
 
+// The description is not copied, so it must outlive the status code.
+// Usually it's a string literal.
 class status_code_t {
 public:
-    status_code_t(unsigned int code, boost::string_view description) :
+    // Explicit, so a view of a temporary isn't taken by accident.
+    constexpr explicit status_code_t(unsigned int code, boost::string_view description) :
         m_code(code),
-        m_description(description.to_string())
+        m_description(description)
     { }
 
-    status_code_t(const status_code_t &) = default;
-    status_code_t(status_code_t &&) = default;
+    // A string literal, without the terminating zero.
+    template<std::size_t Size>
+    constexpr status_code_t(unsigned int code, const char (&description)[Size]) :
+        m_code(code),
+        m_description(description, Size - 1)
+    { }
+
+    // The description would dangle.
+    status_code_t(unsigned int code, std::string &&description) = delete;
+
+    constexpr status_code_t(const status_code_t &) = default;
+    constexpr status_code_t(status_code_t &&) = default;
 
     status_code_t &operator=(const status_code_t &) = default;
     status_code_t &operator=(status_code_t &&) = default;
 
-    unsigned int code() const {
+    constexpr unsigned int code() const {
         return m_code;
     }
 
-    boost::string_view description() const {
+    constexpr boost::string_view description() const {
         return m_description;
     }
 
 private:
     unsigned int m_code;
-    std::string m_description;
+    boost::string_view m_description;
 };
 
 
-extern status_code_t STATUS_100_CONTINUE;
-extern status_code_t STATUS_101_SWITCHING_PROTOCOLS;
-extern status_code_t STATUS_102_PROCESSING;
-extern status_code_t STATUS_200_OK;
-extern status_code_t STATUS_201_CREATED;
-extern status_code_t STATUS_202_ACCEPTED;
-extern status_code_t STATUS_203_NON_AUTHORITATIVE_INFORMATION;
-extern status_code_t STATUS_204_NO_CONTENT;
-extern status_code_t STATUS_205_RESET_CONTENT;
-extern status_code_t STATUS_206_PARTIAL_CONTENT;
-extern status_code_t STATUS_207_MULTI_STATUS;
-extern status_code_t STATUS_208_ALREADY_REPORTED;
-extern status_code_t STATUS_226_IM_USED;
-extern status_code_t STATUS_300_MULTIPLE_CHOICES;
-extern status_code_t STATUS_301_MOVED_PERMANENTLY;
-extern status_code_t STATUS_302_FOUND;
-extern status_code_t STATUS_303_SEE_OTHER;
-extern status_code_t STATUS_304_NOT_MODIFIED;
-extern status_code_t STATUS_305_USE_PROXY;
-extern status_code_t STATUS_307_TEMPORARY_REDIRECT;
-extern status_code_t STATUS_308_PERMANENT_REDIRECT;
-extern status_code_t STATUS_400_BAD_REQUEST;
-extern status_code_t STATUS_401_UNAUTHORIZED;
-extern status_code_t STATUS_402_PAYMENT_REQUIRED;
-extern status_code_t STATUS_403_FORBIDDEN;
-extern status_code_t STATUS_404_NOT_FOUND;
-extern status_code_t STATUS_405_METHOD_NOT_ALLOWED;
-extern status_code_t STATUS_406_NOT_ACCEPTABLE;
-extern status_code_t STATUS_407_PROXY_AUTHENTICATION_REQUIRED;
-extern status_code_t STATUS_408_REQUEST_TIMEOUT;
-extern status_code_t STATUS_409_CONFLICT;
-extern status_code_t STATUS_410_GONE;
-extern status_code_t STATUS_411_LENGTH_REQUIRED;
-extern status_code_t STATUS_412_PRECONDITION_FAILED;
-extern status_code_t STATUS_413_PAYLOAD_TOO_LARGE;
-extern status_code_t STATUS_414_URI_TOO_LONG;
-extern status_code_t STATUS_415_UNSUPPORTED_MEDIA_TYPE;
-extern status_code_t STATUS_416_RANGE_NOT_SATISFIABLE;
-extern status_code_t STATUS_417_EXPECTATION_FAILED;
-extern status_code_t STATUS_421_MISDIRECTED_REQUEST;
-extern status_code_t STATUS_422_UNPROCESSABLE_ENTITY;
-extern status_code_t STATUS_423_LOCKED;
-extern status_code_t STATUS_424_FAILED_DEPENDENCY;
-extern status_code_t STATUS_426_UPGRADE_REQUIRED;
-extern status_code_t STATUS_428_PRECONDITION_REQUIRED;
-extern status_code_t STATUS_429_TOO_MANY_REQUESTS;
-extern status_code_t STATUS_431_REQUEST_HEADER_FIELDS_TOO_LARGE;
-extern status_code_t STATUS_451_UNAVAILABLE_FOR_LEGAL_REASONS;
-extern status_code_t STATUS_500_INTERNAL_SERVER_ERROR;
-extern status_code_t STATUS_501_NOT_IMPLEMENTED;
-extern status_code_t STATUS_502_BAD_GATEWAY;
-extern status_code_t STATUS_503_SERVICE_UNAVAILABLE;
-extern status_code_t STATUS_504_GATEWAY_TIMEOUT;
-extern status_code_t STATUS_505_HTTP_VERSION_NOT_SUPPORTED;
-extern status_code_t STATUS_506_VARIANT_ALSO_NEGOTIATES;
-extern status_code_t STATUS_507_INSUFFICIENT_STORAGE;
-extern status_code_t STATUS_508_LOOP_DETECTED;
-extern status_code_t STATUS_510_NOT_EXTENDED;
-extern status_code_t STATUS_511_NETWORK_AUTHENTICATION_REQUIRED;
+// X(code, name, description)
+#define HTTPLIB_STATUS_CODES(X) \
+    X(100, CONTINUE, "Continue")                                               \
+    X(101, SWITCHING_PROTOCOLS, "Switching Protocols")                         \
+    X(102, PROCESSING, "Processing")                                           \
+    X(200, OK, "OK")                                                           \
+    X(201, CREATED, "Created")                                                 \
+    X(202, ACCEPTED, "Accepted")                                               \
+    X(203, NON_AUTHORITATIVE_INFORMATION, "Non-Authoritative Information")     \
+    X(204, NO_CONTENT, "No Content")                                           \
+    X(205, RESET_CONTENT, "Reset Content")                                     \
+    X(206, PARTIAL_CONTENT, "Partial Content")                                 \
+    X(207, MULTI_STATUS, "Multi-Status")                                       \
+    X(208, ALREADY_REPORTED, "Already Reported")                               \
+    X(226, IM_USED, "IM Used")                                                 \
+    X(300, MULTIPLE_CHOICES, "Multiple Choices")                               \
+    X(301, MOVED_PERMANENTLY, "Moved Permanently")                             \
+    X(302, FOUND, "Found")                                                     \
+    X(303, SEE_OTHER, "See Other")                                             \
+    X(304, NOT_MODIFIED, "Not Modified")                                       \
+    X(305, USE_PROXY, "Use Proxy")                                             \
+    X(307, TEMPORARY_REDIRECT, "Temporary Redirect")                           \
+    X(308, PERMANENT_REDIRECT, "Permanent Redirect")                           \
+    X(400, BAD_REQUEST, "Bad Request")                                         \
+    X(401, UNAUTHORIZED, "Unauthorized")                                       \
+    X(402, PAYMENT_REQUIRED, "Payment Required")                               \
+    X(403, FORBIDDEN, "Forbidden")                                             \
+    X(404, NOT_FOUND, "Not Found")                                             \
+    X(405, METHOD_NOT_ALLOWED, "Method Not Allowed")                           \
+    X(406, NOT_ACCEPTABLE, "Not Acceptable")                                   \
+    X(407, PROXY_AUTHENTICATION_REQUIRED, "Proxy Authentication Required")     \
+    X(408, REQUEST_TIMEOUT, "Request Timeout")                                 \
+    X(409, CONFLICT, "Conflict")                                               \
+    X(410, GONE, "Gone")                                                       \
+    X(411, LENGTH_REQUIRED, "Length Required")                                 \
+    X(412, PRECONDITION_FAILED, "Precondition Failed")                         \
+    X(413, PAYLOAD_TOO_LARGE, "Payload Too Large")                             \
+    X(414, URI_TOO_LONG, "URI Too Long")                                       \
+    X(415, UNSUPPORTED_MEDIA_TYPE, "Unsupported Media Type")                   \
+    X(416, RANGE_NOT_SATISFIABLE, "Range Not Satisfiable")                     \
+    X(417, EXPECTATION_FAILED, "Expectation Failed")                           \
+    X(421, MISDIRECTED_REQUEST, "Misdirected Request")                         \
+    X(422, UNPROCESSABLE_ENTITY, "Unprocessable Entity")                       \
+    X(423, LOCKED, "Locked")                                                   \
+    X(424, FAILED_DEPENDENCY, "Failed Dependency")                             \
+    X(426, UPGRADE_REQUIRED, "Upgrade Required")                               \
+    X(428, PRECONDITION_REQUIRED, "Precondition Required")                     \
+    X(429, TOO_MANY_REQUESTS, "Too Many Requests")                             \
+    X(431, REQUEST_HEADER_FIELDS_TOO_LARGE, "Request Header Fields Too Large") \
+    X(451, UNAVAILABLE_FOR_LEGAL_REASONS, "Unavailable For Legal Reasons")     \
+    X(500, INTERNAL_SERVER_ERROR, "Internal Server Error")                     \
+    X(501, NOT_IMPLEMENTED, "Not Implemented")                                 \
+    X(502, BAD_GATEWAY, "Bad Gateway")                                         \
+    X(503, SERVICE_UNAVAILABLE, "Service Unavailable")                         \
+    X(504, GATEWAY_TIMEOUT, "Gateway Timeout")                                 \
+    X(505, HTTP_VERSION_NOT_SUPPORTED, "HTTP Version Not Supported")           \
+    X(506, VARIANT_ALSO_NEGOTIATES, "Variant Also Negotiates")                 \
+    X(507, INSUFFICIENT_STORAGE, "Insufficient Storage")                       \
+    X(508, LOOP_DETECTED, "Loop Detected")                                     \
+    X(510, NOT_EXTENDED, "Not Extended")                                       \
+    X(511, NETWORK_AUTHENTICATION_REQUIRED, "Network Authentication Required")
+
+
+#define HTTPLIB_DEFINE_STATUS_CODE(code, name, description) \
+    constexpr status_code_t STATUS_ ## code ## _ ## name(code, description);
+
+HTTPLIB_STATUS_CODES(HTTPLIB_DEFINE_STATUS_CODE)
+
+#undef HTTPLIB_DEFINE_STATUS_CODE
+
+
+// Returns the pre-rendered status line, e.g. "HTTP/1.1 200 OK\r\n", if the status code is one of the above
+// with its standard description and the version is either HTTP/1.0 or HTTP/1.1.
+boost::optional<boost::string_view> find_status_line(unsigned int code,
+                                                     boost::string_view description,
+                                                     http_version_t version);
 
 
 HTTPLIB_CLOSE_NAMESPACE
@@ -46,6 +46,10 @@ public:
 
     void set_options(http_parsing_options_t options);
 
+    // Prepare the parser for the next message.
+    // The options are kept, and so is the memory allocated so far where possible.
+    void reset();
+
     result_t parse(const char *data, std::size_t size);
 
     bool done() const;
@@ -6,6 +6,7 @@
 #include <boost/system/error_code.hpp>
 #include <boost/utility/string_view.hpp>
 
+#include <cstdint>
 #include <string>
 
 
@@ -14,23 +15,61 @@ HTTPLIB_OPEN_NAMESPACE
 
 namespace detail {
 
-// tchar = "!" / "#" / "$" / "%" / "&" / "'" / "*" / "+" / "-" / "." / "^" / "_" / "`" / "|" / "~" / DIGIT / ALPHA
-bool is_tchar(char ch);
+enum char_class_t : std::uint8_t {
+    // tchar = "!" / "#" / "$" / "%" / "&" / "'" / "*" / "+" / "-" / "." / "^" / "_" / "`" / "|" / "~" / DIGIT / ALPHA
+    tchar_class = 1 << 0,
 
-// qdtext = HTAB / SP /%x21 / %x23-5B / %x5D-7E / %x80-FF
-bool is_qdtext(char ch);
+    // qdtext = HTAB / SP /%x21 / %x23-5B / %x5D-7E / %x80-FF
+    qdtext_class = 1 << 1,
 
-// HTAB / SP / %x21-7E (VCHAR) / %x80-FF
-bool is_quoted_pair_char(char ch);
+    // HTAB / SP / %x21-7E (VCHAR) / %x80-FF
+    quoted_pair_char_class = 1 << 2,
 
-// %x20 (SP) / %x09 (HTAB)
-bool is_whitespace(char ch);
+    // %x20 (SP) / %x09 (HTAB)
+    whitespace_class = 1 << 3,
 
-// %x41-5A / %x61-7A   ; A-Z / a-z
-bool is_alpha(char ch);
+    // %x41-5A / %x61-7A   ; A-Z / a-z
+    alpha_class = 1 << 4,
 
-// %x30-39  ; 0-9
-bool is_digit(char ch);
+    // %x30-39  ; 0-9
+    digit_class = 1 << 5
+};
+
+// Classes of every octet, a combination of char_class_t bits.
+extern const std::uint8_t char_classes[256];
+
+inline bool has_char_class(char ch, char_class_t char_class) {
+    return (char_classes[static_cast<unsigned char>(ch)] & char_class) != 0;
+}
+
+inline bool is_tchar(char ch) {
+    return has_char_class(ch, tchar_class);
+}
+
+inline bool is_qdtext(char ch) {
+    return has_char_class(ch, qdtext_class);
+}
+
+inline bool is_quoted_pair_char(char ch) {
+    return has_char_class(ch, quoted_pair_char_class);
+}
+
+inline bool is_whitespace(char ch) {
+    return has_char_class(ch, whitespace_class);
+}
+
+inline bool is_alpha(char ch) {
+    return has_char_class(ch, alpha_class);
+}
+
+inline bool is_digit(char ch) {
+    return has_char_class(ch, digit_class);
+}
+
+// Return the length of the longest prefix of the data consisting of tchars or qdtext respectively.
+// Long inputs are scanned 16 or 32 bytes at a time when the CPU supports SSE4.2 or AVX2.
+std::size_t count_tchars(boost::string_view data);
+std::size_t count_qdtext(boost::string_view data);
 
 boost::optional<std::string> parse_token(boost::string_view &data);
 boost::optional<std::string> parse_quoted_string(boost::string_view &data);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <httplib/detail/common.hpp>
+#include <httplib/http/request_view.hpp>
+#include <httplib/parser/parsing_options.hpp>
+
+#include <boost/system/error_code.hpp>
+
+#include <cstdlib>
+#include <memory>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+// Parses a request head without copying it when possible.
+// If the whole head is passed in a single parse() call, the resulting view points into that data,
+// so the data must stay alive and unchanged for as long as the view is used.
+// Parts of the head received in previous parse() calls are copied into the parser's own storage,
+// since the caller is free to reuse that memory.
+class http_request_view_parser_t {
+public:
+    http_request_view_parser_t();
+    http_request_view_parser_t(const http_request_view_parser_t &other);
+    http_request_view_parser_t(http_request_view_parser_t &&other);
+
+    ~http_request_view_parser_t();
+
+    http_request_view_parser_t &operator=(const http_request_view_parser_t &other);
+    http_request_view_parser_t &operator=(http_request_view_parser_t &&other);
+
+    void set_options(http_parsing_options_t options);
+
+    // Prepare the parser for the next message.
+    // The options are kept, and so is the memory allocated so far where possible.
+    void reset();
+
+    std::size_t parse(const char *data, std::size_t size);
+
+    bool done() const;
+    boost::system::error_code error() const;
+    const http_request_view_t &request() const;
+
+private:
+    class implementation_t;
+
+    std::unique_ptr<implementation_t> m_implementation;
+};
+
+
+HTTPLIB_CLOSE_NAMESPACE
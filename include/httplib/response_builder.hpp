@@ -8,6 +8,7 @@
 #include <httplib/result.hpp>
 
 #include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
 
 
 HTTPLIB_OPEN_NAMESPACE
@@ -24,8 +25,11 @@ public:
     http_response_builder_t &content_length(std::size_t length);
     http_response_builder_t &chunked_encoding();
 
+    // Add the Date header with the current time when the response is built.
+    http_response_builder_t &date();
+
     http_response_t build(const status_code_t &status) const;
-    http_response_t build(unsigned int code, const std::string &reason) const;
+    http_response_t build(unsigned int code, boost::string_view reason) const;
 
     http_version_t version() const;
     http_headers_t headers() const;
@@ -37,6 +41,7 @@ private:
     http_headers_t m_headers;
     boost::optional<body_size_t> m_body_size;
     boost::optional<connection_status_t> m_connection_status;
+    bool m_date;
 };
 
 
@@ -119,4 +119,41 @@ const boost::system::error_category &reader_category() noexcept {
 }
 
 
+namespace {
+
+class client_error_category_t : public boost::system::error_category {
+public:
+    const char *name() const noexcept override {
+        return "http_client";
+    }
+
+    std::string message(int code) const override {
+        switch (code) {
+            case static_cast<int>(client_errc_t::bad_response):
+                return "Bad response";
+            case static_cast<int>(client_errc_t::body_too_large):
+                return "Too large response body";
+            default:
+                return "HTTP client error";
+        }
+    }
+};
+
+} // namespace
+
+boost::system::error_code make_error_code(client_errc_t e) noexcept {
+    return boost::system::error_code(static_cast<int>(e), client_category());
+}
+
+boost::system::error_condition make_error_condition(client_errc_t e) noexcept {
+    return boost::system::error_condition(static_cast<int>(e), client_category());
+}
+
+const boost::system::error_category &client_category() noexcept {
+    static client_error_category_t category;
+
+    return category;
+}
+
+
 HTTPLIB_CLOSE_NAMESPACE
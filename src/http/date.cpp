@@ -0,0 +1,125 @@
+#include <httplib/http/date.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+namespace {
+
+struct cached_date_t {
+    std::time_t time = -1;
+    char text[http_date_size];
+};
+
+
+// A date is never modified while it's published. Readers get a pointer to the latest one and
+// the slot is reused only after all the others have been published, so a pointer obtained by a reader
+// stays valid for at least slots_count - 1 seconds.
+class date_cache_t {
+    static constexpr std::size_t slots_count = 16;
+
+public:
+    date_cache_t() :
+        m_current(nullptr),
+        m_next_slot(0)
+    { }
+
+    boost::string_view get() {
+        std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        const cached_date_t *current = m_current.load(std::memory_order_acquire);
+
+        if (!current || current->time != now) {
+            current = refresh(now, current);
+        }
+
+        return boost::string_view(current->text, http_date_size);
+    }
+
+private:
+    const cached_date_t *refresh(std::time_t now, const cached_date_t *current) {
+        std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+
+        // Someone is already formatting the new date, the old one is good enough for now.
+        if (!lock.owns_lock() && current) {
+            return current;
+        }
+
+        if (!lock.owns_lock()) {
+            lock.lock();
+        }
+
+        current = m_current.load(std::memory_order_relaxed);
+
+        if (current && current->time == now) {
+            return current;
+        }
+
+        cached_date_t &slot = m_slots[m_next_slot];
+        m_next_slot = (m_next_slot + 1) % slots_count;
+
+        slot.time = now;
+        format_http_date(now, slot.text);
+
+        m_current.store(&slot, std::memory_order_release);
+
+        return &slot;
+    }
+
+private:
+    std::atomic<const cached_date_t *> m_current;
+
+    std::mutex m_mutex;
+    std::array<cached_date_t, slots_count> m_slots;
+    std::size_t m_next_slot;
+};
+
+
+void write_number(unsigned int number, std::size_t digits, char *output) {
+    for (std::size_t i = digits; i > 0; --i) {
+        output[i - 1] = static_cast<char>('0' + number % 10);
+        number /= 10;
+    }
+}
+
+} // namespace
+
+
+void format_http_date(std::time_t time, char *output) {
+    static const char *const days[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    static const char *const months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+    std::tm tm;
+    gmtime_r(&time, &tm);
+
+    // "Sun, 06 Nov 1994 08:49:37 GMT"
+    std::copy(days[tm.tm_wday], days[tm.tm_wday] + 3, output);
+    output[3] = ',';
+    output[4] = ' ';
+    write_number(tm.tm_mday, 2, output + 5);
+    output[7] = ' ';
+    std::copy(months[tm.tm_mon], months[tm.tm_mon] + 3, output + 8);
+    output[11] = ' ';
+    write_number(tm.tm_year + 1900, 4, output + 12);
+    output[16] = ' ';
+    write_number(tm.tm_hour, 2, output + 17);
+    output[19] = ':';
+    write_number(tm.tm_min, 2, output + 20);
+    output[22] = ':';
+    write_number(tm.tm_sec, 2, output + 23);
+    std::copy_n(" GMT", 4, output + 25);
+}
+
+
+boost::string_view current_http_date() {
+    static date_cache_t cache;
+    return cache.get();
+}
+
+
+HTTPLIB_CLOSE_NAMESPACE
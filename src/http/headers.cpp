@@ -1,12 +1,90 @@
 #include <httplib/http/headers.hpp>
 
+#include <algorithm>
+
 
 HTTPLIB_OPEN_NAMESPACE
 
 
+namespace {
+
+// Header names are tokens, so ASCII case folding is enough.
+char fold_case(char ch) {
+    return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+}
+
+bool names_equal(boost::string_view one, boost::string_view another) {
+    if (one.size() != another.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < one.size(); ++i) {
+        if (fold_case(one[i]) != fold_case(another[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// FNV-1a over the case-folded name.
+std::uint32_t name_hash(boost::string_view name) {
+    std::uint32_t hash = 2166136261u;
+
+    for (char ch: name) {
+        hash ^= static_cast<unsigned char>(fold_case(ch));
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+} // namespace
+
+
+constexpr std::size_t http_headers_t::index_threshold;
+
+
+http_headers_t::const_iterator http_headers_t::find(boost::string_view name) const {
+    if (auto known = find_known_header(name)) {
+        return find(*known);
+    }
+
+    if (m_index.empty()) {
+        return std::find_if(m_headers.begin(), m_headers.end(), [&name](const auto &header) {
+            return names_equal(header.first, name);
+        });
+    }
+
+    std::size_t mask = m_index.size() - 1;
+
+    for (std::size_t slot = name_hash(name) & mask; m_index[slot] != 0; slot = (slot + 1) & mask) {
+        auto header_it = m_headers.begin() + (m_index[slot] - 1);
+
+        if (names_equal(header_it->first, name)) {
+            return header_it;
+        }
+    }
+
+    return m_headers.end();
+}
+
+
 boost::optional<const http_headers_t::header_value_t &>
 http_headers_t::get_header(boost::string_view name) const {
-    auto header_it = m_headers.find(name);
+    auto header_it = find(name);
+
+    if (header_it != m_headers.end() && header_it->second.size() == 1) {
+        return header_it->second.front();
+    } else {
+        return boost::none;
+    }
+}
+
+
+boost::optional<const http_headers_t::header_value_t &>
+http_headers_t::get_header(known_header_t name) const {
+    auto header_it = find(name);
 
     if (header_it != m_headers.end() && header_it->second.size() == 1) {
         return header_it->second.front();
@@ -18,7 +96,19 @@ http_headers_t::get_header(boost::string_view name) const {
 
 boost::optional<const http_headers_t::header_values_t &>
 http_headers_t::get_header_values(boost::string_view name) const {
-    auto header_it = m_headers.find(name);
+    auto header_it = find(name);
+
+    if (header_it != m_headers.end()) {
+        return header_it->second;
+    } else {
+        return boost::none;
+    }
+}
+
+
+boost::optional<const http_headers_t::header_values_t &>
+http_headers_t::get_header_values(known_header_t name) const {
+    auto header_it = find(name);
 
     if (header_it != m_headers.end()) {
         return header_it->second;
@@ -31,15 +121,20 @@ http_headers_t::get_header_values(boost::string_view name) const {
 void http_headers_t::set_header(boost::string_view name, const header_values_t &values) {
     if (values.empty()) {
         remove_header(name);
-    } else {
-        auto result = m_headers.emplace(name.to_string(), header_values_t());
-        size_t headers_to_replace = result.first->second.size();
+        return;
+    }
 
-        result.first->second = values;
+    auto header_it = find_mutable(name);
 
-        m_size -= headers_to_replace;
-        m_size += result.first->second.size();
+    if (header_it != m_headers.end()) {
+        m_size -= header_it->second.size();
+        header_it->second = values;
+    } else {
+        m_headers.emplace_back(name.to_string(), values);
+        add_to_index(m_headers.size() - 1);
     }
+
+    m_size += values.size();
 }
 
 
@@ -48,34 +143,90 @@ void http_headers_t::add_header_values(boost::string_view name, const header_val
         return;
     }
 
-    auto result = m_headers.emplace(name.to_string(), header_values_t());
+    auto header_it = find_mutable(name);
 
-    if (result.first->second.empty()) {
-        result.first->second = values;
-        m_size += result.first->second.size();
-    } else {
-        result.first->second.reserve(result.first->second.size() + values.size());
+    if (header_it != m_headers.end()) {
+        header_it->second.reserve(header_it->second.size() + values.size());
 
         for (auto &value: values) {
-            result.first->second.emplace_back(value);
-            ++m_size;
+            header_it->second.emplace_back(value);
         }
+    } else {
+        m_headers.emplace_back(name.to_string(), values);
+        add_to_index(m_headers.size() - 1);
     }
+
+    m_size += values.size();
 }
 
 
 void http_headers_t::remove_header(boost::string_view name) {
-    auto header_it = m_headers.find(name);
+    auto header_it = find_mutable(name);
 
     if (header_it != m_headers.end()) {
         size_t headers_to_remove = header_it->second.size();
 
         m_headers.erase(header_it);
         m_size -= headers_to_remove;
+
+        // Positions have shifted.
+        rebuild_index();
     }
 }
 
 
+http_headers_t::container_t::iterator http_headers_t::find_mutable(boost::string_view name) {
+    return m_headers.begin() + (find(name) - m_headers.cbegin());
+}
+
+
+void http_headers_t::rebuild_index() {
+    m_known.fill(0);
+    m_index.clear();
+
+    if (m_headers.size() > index_threshold) {
+        // Keep the load factor at most 1/2.
+        std::size_t index_size = 1;
+
+        while (index_size < 2 * m_headers.size()) {
+            index_size *= 2;
+        }
+
+        m_index.resize(index_size, 0);
+    }
+
+    for (std::size_t position = 0; position < m_headers.size(); ++position) {
+        add_to_index(position);
+    }
+}
+
+
+void http_headers_t::add_to_index(std::size_t position) {
+    if (auto known = find_known_header(m_headers[position].first)) {
+        m_known[static_cast<std::size_t>(*known)] = static_cast<std::uint32_t>(position + 1);
+        return;
+    }
+
+    if (m_index.empty() || 2 * m_headers.size() > m_index.size()) {
+        // Either the index is not needed yet, or it's built from scratch including this position.
+        if (m_headers.size() > index_threshold) {
+            rebuild_index();
+        }
+
+        return;
+    }
+
+    std::size_t mask = m_index.size() - 1;
+    std::size_t slot = name_hash(m_headers[position].first) & mask;
+
+    while (m_index[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+
+    m_index[slot] = static_cast<std::uint32_t>(position + 1);
+}
+
+
 std::ostream &operator<<(std::ostream &stream, const http_headers_t &headers) {
     auto home_it = headers.find("home");
 
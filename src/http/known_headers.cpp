@@ -0,0 +1,107 @@
+#include <httplib/http/known_headers.hpp>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+namespace {
+
+struct known_name_t {
+    const char *data;
+    std::size_t size;
+};
+
+constexpr known_name_t known_header_names[] = {
+#define HTTPLIB_KNOWN_HEADER_NAME(id, name) {name, sizeof(name) - 1},
+    HTTPLIB_KNOWN_HEADERS(HTTPLIB_KNOWN_HEADER_NAME)
+#undef HTTPLIB_KNOWN_HEADER_NAME
+};
+
+constexpr char fold_case(char ch) {
+    return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+}
+
+// The first character, the last character and the length are unique among the known headers,
+// and the multiplier spreads them over the table without collisions.
+// If you add a header and the static_assert below fires, pick another multiplier (or enlarge the table).
+constexpr std::size_t slots_bits = 7;
+constexpr std::size_t slots_count = std::size_t(1) << slots_bits;
+constexpr std::uint32_t hash_multiplier = 0xe1f25e87u;
+
+constexpr std::size_t header_slot(const char *data, std::size_t size) {
+    std::uint32_t key = (std::uint32_t(static_cast<unsigned char>(fold_case(data[0]))) << 16) |
+                        (std::uint32_t(static_cast<unsigned char>(fold_case(data[size - 1]))) << 8) |
+                        std::uint32_t(size & 0xff);
+
+    return static_cast<std::uint32_t>(key * hash_multiplier) >> (32 - slots_bits);
+}
+
+struct slots_t {
+    // Index in known_header_names plus one, zero for empty slots.
+    std::uint8_t headers[slots_count];
+};
+
+constexpr slots_t make_slots() {
+    slots_t result {};
+
+    for (std::size_t i = 0; i < known_headers_count; ++i) {
+        result.headers[header_slot(known_header_names[i].data, known_header_names[i].size)] =
+            static_cast<std::uint8_t>(i + 1);
+    }
+
+    return result;
+}
+
+constexpr slots_t slots = make_slots();
+
+constexpr bool slots_are_unique() {
+    for (std::size_t i = 0; i < known_headers_count; ++i) {
+        if (slots.headers[header_slot(known_header_names[i].data, known_header_names[i].size)] != i + 1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static_assert(sizeof(known_header_names) / sizeof(known_header_names[0]) == known_headers_count,
+              "Every known header must have a name");
+static_assert(slots_are_unique(), "The known headers hash is not perfect anymore");
+
+} // namespace
+
+
+boost::optional<known_header_t> find_known_header(boost::string_view name) {
+    if (name.empty()) {
+        return boost::none;
+    }
+
+    std::uint8_t candidate = slots.headers[header_slot(name.data(), name.size())];
+
+    if (candidate == 0) {
+        return boost::none;
+    }
+
+    const known_name_t &candidate_name = known_header_names[candidate - 1];
+
+    if (candidate_name.size != name.size()) {
+        return boost::none;
+    }
+
+    for (std::size_t i = 0; i < name.size(); ++i) {
+        if (fold_case(candidate_name.data[i]) != fold_case(name[i])) {
+            return boost::none;
+        }
+    }
+
+    return static_cast<known_header_t>(candidate - 1);
+}
+
+
+boost::string_view known_header_name(known_header_t header) {
+    const known_name_t &name = known_header_names[static_cast<std::size_t>(header)];
+    return boost::string_view(name.data, name.size);
+}
+
+
+HTTPLIB_CLOSE_NAMESPACE
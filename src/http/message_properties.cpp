@@ -49,14 +49,14 @@ bool parse_content_length(const std::string &str, content_length_int_t &result)
 
 boost::optional<body_size_t> body_size(const http_request_t &request) {
     if (request.version >= http_version_t{1, 1}) {
-        if (auto transfer_encoding = request.headers.get_header_values("Transfer-Encoding")) {
+        if (auto transfer_encoding = request.headers.get_header_values(known_header_t::transfer_encoding)) {
             if (!transfer_encoding->empty()) {
                 return body_size_t{body_size_t::type_t::transfer_encoding, 0};
             }
         }
     }
 
-    if (auto content_length = request.headers.get_header_values("Content-Length")) {
+    if (auto content_length = request.headers.get_header_values(known_header_t::content_length)) {
         if (content_length->size() != 1) {
             return boost::none;
         }
@@ -80,14 +80,14 @@ boost::optional<body_size_t> body_size(const http_response_t &response) {
     }
 
     if (response.version >= http_version_t{1, 1}) {
-        if (auto transfer_encoding = response.headers.get_header_values("Transfer-Encoding")) {
+        if (auto transfer_encoding = response.headers.get_header_values(known_header_t::transfer_encoding)) {
             if (!transfer_encoding->empty()) {
                 return body_size_t{body_size_t::type_t::transfer_encoding, 0};
             }
         }
     }
 
-    if (auto content_length = response.headers.get_header_values("Content-Length")) {
+    if (auto content_length = response.headers.get_header_values(known_header_t::content_length)) {
         if (content_length->size() != 1) {
             return boost::none;
         }
@@ -121,14 +121,14 @@ boost::optional<body_size_t> body_size(const http_response_t &response,
     }
 
     if (response.version >= http_version_t{1, 1}) {
-        if (auto transfer_encoding = response.headers.get_header_values("Transfer-Encoding")) {
+        if (auto transfer_encoding = response.headers.get_header_values(known_header_t::transfer_encoding)) {
             if (!transfer_encoding->empty()) {
                 return body_size_t{body_size_t::type_t::transfer_encoding, 0};
             }
         }
     }
 
-    if (auto content_length = response.headers.get_header_values("Content-Length")) {
+    if (auto content_length = response.headers.get_header_values(known_header_t::content_length)) {
         if (content_length->size() != 1) {
             return boost::none;
         }
@@ -153,7 +153,7 @@ boost::optional<connection_status_t> connection_status_impl(const MessageHead &m
     bool has_close = false;
     bool has_keep_alive = false;
 
-    if (auto connection = message.headers.get_header_values("Connection")) {
+    if (auto connection = message.headers.get_header_values(known_header_t::connection)) {
         auto tokens = parse_token_list(connection->begin(), connection->end());
 
         if (!tokens) {
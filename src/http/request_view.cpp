@@ -0,0 +1,66 @@
+#include <httplib/http/request_view.hpp>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+bool http_header_views_t::has(boost::string_view name) const {
+    for (const auto &header: m_headers) {
+        if (boost::algorithm::iequals(header.name, name)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+boost::optional<boost::string_view> http_header_views_t::get_header(boost::string_view name) const {
+    boost::optional<boost::string_view> result;
+
+    for (const auto &header: m_headers) {
+        if (boost::algorithm::iequals(header.name, name)) {
+            if (result) {
+                return boost::none;
+            }
+
+            result = header.value;
+        }
+    }
+
+    return result;
+}
+
+
+http_request_t to_request(const http_request_view_t &view) {
+    http_request_t request;
+
+    request.method = view.method.to_string();
+    request.target = view.target.to_string();
+    request.version = view.version;
+
+    for (const auto &header: view.headers) {
+        request.headers.add_header_values(header.name, {header.value.to_string()});
+    }
+
+    return request;
+}
+
+
+std::ostream &operator<<(std::ostream &stream, const http_request_view_t &request) {
+    stream << request.method << " " << request.target
+           << " HTTP/" << request.version.major << "." << request.version.minor << "\r\n";
+
+    for (const auto &header: request.headers) {
+        stream << header.name << ": " << header.value << "\r\n";
+    }
+
+    stream << "\r\n";
+
+    return stream;
+}
+
+
+HTTPLIB_CLOSE_NAMESPACE
@@ -0,0 +1,220 @@
+#include <httplib/http/serialize.hpp>
+#include <httplib/http/status_code.hpp>
+
+#include <cstring>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+namespace {
+
+std::size_t decimal_size(unsigned int number) {
+    std::size_t size = 1;
+
+    while (number >= 10) {
+        number /= 10;
+        ++size;
+    }
+
+    return size;
+}
+
+
+char *write_decimal(unsigned int number, char *output) {
+    char *end = output + decimal_size(number);
+    char *it = end;
+
+    do {
+        *--it = static_cast<char>('0' + number % 10);
+        number /= 10;
+    } while (number > 0);
+
+    return end;
+}
+
+
+char *write_string(boost::string_view string, char *output) {
+    if (!string.empty()) {
+        std::memcpy(output, string.data(), string.size());
+    }
+
+    return output + string.size();
+}
+
+
+// "HTTP/x.y"
+std::size_t version_size(const http_version_t &version) {
+    return 5 + decimal_size(version.major) + 1 + decimal_size(version.minor);
+}
+
+
+char *write_version(const http_version_t &version, char *output) {
+    output = write_string("HTTP/", output);
+    output = write_decimal(version.major, output);
+    *output++ = '.';
+    return write_decimal(version.minor, output);
+}
+
+
+// Every header line followed by the empty line.
+std::size_t headers_size(const http_headers_t &headers) {
+    std::size_t size = 2;
+
+    for (const auto &header: headers) {
+        for (const auto &value: header.second) {
+            size += header.first.size() + 2 + value.size() + 2;
+        }
+    }
+
+    return size;
+}
+
+
+char *write_header(boost::string_view name, const http_headers_t::header_values_t &values, char *output) {
+    for (const auto &value: values) {
+        output = write_string(name, output);
+        output = write_string(": ", output);
+        output = write_string(value, output);
+        output = write_string("\r\n", output);
+    }
+
+    return output;
+}
+
+
+// The same order as the output operator of http_headers_t: the Home header goes first, as it's recommended by rfc7230.
+char *write_headers(const http_headers_t &headers, char *output) {
+    auto home_it = headers.find("home");
+
+    if (home_it != headers.end()) {
+        output = write_header(home_it->first, home_it->second, output);
+    }
+
+    for (auto header_it = headers.begin(); header_it != headers.end(); ++header_it) {
+        if (header_it != home_it) {
+            output = write_header(header_it->first, header_it->second, output);
+        }
+    }
+
+    return write_string("\r\n", output);
+}
+
+
+// "00", "01", ..., "ff" for every byte, so a chunk size is formatted a byte at a time.
+struct hex_pairs_t {
+    char data[512];
+
+    constexpr hex_pairs_t() :
+        data()
+    {
+        constexpr char digits[] = "0123456789abcdef";
+
+        for (std::size_t i = 0; i < 256; ++i) {
+            data[2 * i] = digits[i / 16];
+            data[2 * i + 1] = digits[i % 16];
+        }
+    }
+};
+
+constexpr hex_pairs_t hex_pairs;
+
+
+template<class Message>
+void append_head(const Message &message, std::string &output) {
+    std::size_t offset = output.size();
+    output.resize(offset + serialized_size(message));
+    serialize_head(message, &output[offset]);
+}
+
+} // namespace
+
+
+std::size_t serialized_size(const http_request_t &request) {
+    return request.method.size() + 1 + request.target.size() + 1 + version_size(request.version) + 2 +
+           headers_size(request.headers);
+}
+
+
+std::size_t serialized_size(const http_response_t &response) {
+    if (auto status_line = find_status_line(response.code, response.reason, response.version)) {
+        return status_line->size() + headers_size(response.headers);
+    }
+
+    return version_size(response.version) + 1 + decimal_size(response.code) + 1 + response.reason.size() + 2 +
+           headers_size(response.headers);
+}
+
+
+char *serialize_head(const http_request_t &request, char *output) {
+    output = write_string(request.method, output);
+    *output++ = ' ';
+    output = write_string(request.target, output);
+    *output++ = ' ';
+    output = write_version(request.version, output);
+    output = write_string("\r\n", output);
+    return write_headers(request.headers, output);
+}
+
+
+char *serialize_head(const http_response_t &response, char *output) {
+    if (auto status_line = find_status_line(response.code, response.reason, response.version)) {
+        return write_headers(response.headers, write_string(*status_line, output));
+    }
+
+    output = write_version(response.version, output);
+    *output++ = ' ';
+    output = write_decimal(response.code, output);
+    *output++ = ' ';
+    output = write_string(response.reason, output);
+    output = write_string("\r\n", output);
+    return write_headers(response.headers, output);
+}
+
+
+void serialize_head(const http_request_t &request, std::string &output) {
+    append_head(request, output);
+}
+
+
+void serialize_head(const http_response_t &response, std::string &output) {
+    append_head(response, output);
+}
+
+
+char *serialize_chunk_size_line(std::size_t size, char *output) {
+    unsigned char bytes[sizeof(std::size_t)];
+    std::size_t count = 0;
+
+    do {
+        bytes[count++] = static_cast<unsigned char>(size & 0xff);
+        size >>= 8;
+    } while (size > 0);
+
+    // No leading zero in the most significant byte.
+    const char *pair = hex_pairs.data + 2 * bytes[--count];
+
+    if (pair[0] != '0') {
+        *output++ = pair[0];
+    }
+
+    *output++ = pair[1];
+
+    while (count > 0) {
+        pair = hex_pairs.data + 2 * bytes[--count];
+        *output++ = pair[0];
+        *output++ = pair[1];
+    }
+
+    return write_string("\r\n", output);
+}
+
+
+void serialize_last_chunk(const http_headers_t &trailers, std::string &output) {
+    std::size_t offset = output.size();
+    output.resize(offset + 3 + headers_size(trailers));
+    write_headers(trailers, write_string("0\r\n", &output[offset]));
+}
+
+
+HTTPLIB_CLOSE_NAMESPACE
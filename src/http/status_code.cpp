@@ -4,65 +4,66 @@
 HTTPLIB_OPEN_NAMESPACE
 
 
-status_code_t STATUS_100_CONTINUE(100, "Continue");
-status_code_t STATUS_101_SWITCHING_PROTOCOLS(101, "Switching Protocols");
-status_code_t STATUS_102_PROCESSING(102, "Processing");
-status_code_t STATUS_200_OK(200, "OK");
-status_code_t STATUS_201_CREATED(201, "Created");
-status_code_t STATUS_202_ACCEPTED(202, "Accepted");
-status_code_t STATUS_203_NON_AUTHORITATIVE_INFORMATION(203, "Non-Authoritative Information");
-status_code_t STATUS_204_NO_CONTENT(204, "No Content");
-status_code_t STATUS_205_RESET_CONTENT(205, "Reset Content");
-status_code_t STATUS_206_PARTIAL_CONTENT(206, "Partial Content");
-status_code_t STATUS_207_MULTI_STATUS(207, "Multi-Status");
-status_code_t STATUS_208_ALREADY_REPORTED(208, "Already Reported");
-status_code_t STATUS_226_IM_USED(226, "IM Used");
-status_code_t STATUS_300_MULTIPLE_CHOICES(300, "Multiple Choices");
-status_code_t STATUS_301_MOVED_PERMANENTLY(301, "Moved Permanently");
-status_code_t STATUS_302_FOUND(302, "Found");
-status_code_t STATUS_303_SEE_OTHER(303, "See Other");
-status_code_t STATUS_304_NOT_MODIFIED(304, "Not Modified");
-status_code_t STATUS_305_USE_PROXY(305, "Use Proxy");
-status_code_t STATUS_307_TEMPORARY_REDIRECT(307, "Temporary Redirect");
-status_code_t STATUS_308_PERMANENT_REDIRECT(308, "Permanent Redirect");
-status_code_t STATUS_400_BAD_REQUEST(400, "Bad Request");
-status_code_t STATUS_401_UNAUTHORIZED(401, "Unauthorized");
-status_code_t STATUS_402_PAYMENT_REQUIRED(402, "Payment Required");
-status_code_t STATUS_403_FORBIDDEN(403, "Forbidden");
-status_code_t STATUS_404_NOT_FOUND(404, "Not Found");
-status_code_t STATUS_405_METHOD_NOT_ALLOWED(405, "Method Not Allowed");
-status_code_t STATUS_406_NOT_ACCEPTABLE(406, "Not Acceptable");
-status_code_t STATUS_407_PROXY_AUTHENTICATION_REQUIRED(407, "Proxy Authentication Required");
-status_code_t STATUS_408_REQUEST_TIMEOUT(408, "Request Timeout");
-status_code_t STATUS_409_CONFLICT(409, "Conflict");
-status_code_t STATUS_410_GONE(410, "Gone");
-status_code_t STATUS_411_LENGTH_REQUIRED(411, "Length Required");
-status_code_t STATUS_412_PRECONDITION_FAILED(412, "Precondition Failed");
-status_code_t STATUS_413_PAYLOAD_TOO_LARGE(413, "Payload Too Large");
-status_code_t STATUS_414_URI_TOO_LONG(414, "URI Too Long");
-status_code_t STATUS_415_UNSUPPORTED_MEDIA_TYPE(415, "Unsupported Media Type");
-status_code_t STATUS_416_RANGE_NOT_SATISFIABLE(416, "Range Not Satisfiable");
-status_code_t STATUS_417_EXPECTATION_FAILED(417, "Expectation Failed");
-status_code_t STATUS_421_MISDIRECTED_REQUEST(421, "Misdirected Request");
-status_code_t STATUS_422_UNPROCESSABLE_ENTITY(422, "Unprocessable Entity");
-status_code_t STATUS_423_LOCKED(423, "Locked");
-status_code_t STATUS_424_FAILED_DEPENDENCY(424, "Failed Dependency");
-status_code_t STATUS_426_UPGRADE_REQUIRED(426, "Upgrade Required");
-status_code_t STATUS_428_PRECONDITION_REQUIRED(428, "Precondition Required");
-status_code_t STATUS_429_TOO_MANY_REQUESTS(429, "Too Many Requests");
-status_code_t STATUS_431_REQUEST_HEADER_FIELDS_TOO_LARGE(431, "Request Header Fields Too Large");
-status_code_t STATUS_451_UNAVAILABLE_FOR_LEGAL_REASONS(451, "Unavailable For Legal Reasons");
-status_code_t STATUS_500_INTERNAL_SERVER_ERROR(500, "Internal Server Error");
-status_code_t STATUS_501_NOT_IMPLEMENTED(501, "Not Implemented");
-status_code_t STATUS_502_BAD_GATEWAY(502, "Bad Gateway");
-status_code_t STATUS_503_SERVICE_UNAVAILABLE(503, "Service Unavailable");
-status_code_t STATUS_504_GATEWAY_TIMEOUT(504, "Gateway Timeout");
-status_code_t STATUS_505_HTTP_VERSION_NOT_SUPPORTED(505, "HTTP Version Not Supported");
-status_code_t STATUS_506_VARIANT_ALSO_NEGOTIATES(506, "Variant Also Negotiates");
-status_code_t STATUS_507_INSUFFICIENT_STORAGE(507, "Insufficient Storage");
-status_code_t STATUS_508_LOOP_DETECTED(508, "Loop Detected");
-status_code_t STATUS_510_NOT_EXTENDED(510, "Not Extended");
-status_code_t STATUS_511_NETWORK_AUTHENTICATION_REQUIRED(511, "Network Authentication Required");
+namespace {
+
+struct status_lines_t {
+    boost::string_view http_1_0;
+    boost::string_view http_1_1;
+};
+
+
+template<std::size_t Size1, std::size_t Size2>
+constexpr status_lines_t make_status_lines(const char (&http_1_0)[Size1], const char (&http_1_1)[Size2]) {
+    return status_lines_t{boost::string_view(http_1_0, Size1 - 1), boost::string_view(http_1_1, Size2 - 1)};
+}
+
+
+#define HTTPLIB_STATUS_LINES_CASE(code, name, description) \
+    case code: { \
+        static constexpr status_lines_t lines = make_status_lines( \
+            "HTTP/1.0 " #code " " description "\r\n", \
+            "HTTP/1.1 " #code " " description "\r\n" \
+        ); \
+        \
+        return &lines; \
+    }
+
+const status_lines_t *find_status_lines(unsigned int code) {
+    switch (code) {
+        HTTPLIB_STATUS_CODES(HTTPLIB_STATUS_LINES_CASE)
+    }
+
+    return nullptr;
+}
+
+#undef HTTPLIB_STATUS_LINES_CASE
+
+} // namespace
+
+
+boost::optional<boost::string_view> find_status_line(unsigned int code,
+                                                     boost::string_view description,
+                                                     http_version_t version)
+{
+    if (version.major != 1 || version.minor > 1) {
+        return boost::none;
+    }
+
+    const status_lines_t *lines = find_status_lines(code);
+
+    if (!lines) {
+        return boost::none;
+    }
+
+    boost::string_view line = version.minor == 0 ? lines->http_1_0 : lines->http_1_1;
+
+    // "HTTP/1.x NNN " + description + "\r\n"
+    if (line.substr(13, line.size() - 15) != description) {
+        return boost::none;
+    }
+
+    return line;
+}
 
 
 HTTPLIB_CLOSE_NAMESPACE
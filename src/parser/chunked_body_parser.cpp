@@ -61,6 +61,17 @@ public:
 
     implementation_t(const implementation_t &other) = default;
 
+    void reset() {
+        error.clear();
+        body_part = nullptr;
+        body_part_size = 0;
+        headers.clear();
+        current_header_name.clear();
+        current_header_value.clear();
+        state = state_t::start;
+        joyent::http_parser_init(&parser, joyent::HTTP_CHUNKED_BODY);
+    }
+
     chunked_body_parser_t::result_t parse(const char *data, size_t size) {
         if (state == state_t::done) {
             error = make_error_code(parser_errc_t::invalid_parser);
@@ -195,6 +206,10 @@ void chunked_body_parser_t::set_options(http_parsing_options_t options) {
     m_implementation->options = options;
 }
 
+void chunked_body_parser_t::reset() {
+    m_implementation->reset();
+}
+
 chunked_body_parser_t::result_t chunked_body_parser_t::parse(const char *data, std::size_t size) {
     return m_implementation->parse(data, size);
 }
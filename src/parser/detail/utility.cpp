@@ -1,819 +1,261 @@
 #include <httplib/parser/detail/utility.hpp>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+
 
 HTTPLIB_OPEN_NAMESPACE
 
 
-bool detail::is_tchar(char ch) {
-    switch (static_cast<unsigned char>(ch)) {
-        case 0: return false;
-        case 1: return false;
-        case 2: return false;
-        case 3: return false;
-        case 4: return false;
-        case 5: return false;
-        case 6: return false;
-        case 7: return false;
-        case 8: return false;
-        case 9: return false;
-        case 10: return false;
-        case 11: return false;
-        case 12: return false;
-        case 13: return false;
-        case 14: return false;
-        case 15: return false;
-        case 16: return false;
-        case 17: return false;
-        case 18: return false;
-        case 19: return false;
-        case 20: return false;
-        case 21: return false;
-        case 22: return false;
-        case 23: return false;
-        case 24: return false;
-        case 25: return false;
-        case 26: return false;
-        case 27: return false;
-        case 28: return false;
-        case 29: return false;
-        case 30: return false;
-        case 31: return false;
-        case 32: return false;
-        case 33: return true;
-        case 34: return false;
-        case 35: return true;
-        case 36: return true;
-        case 37: return true;
-        case 38: return true;
-        case 39: return true;
-        case 40: return false;
-        case 41: return false;
-        case 42: return true;
-        case 43: return true;
-        case 44: return false;
-        case 45: return true;
-        case 46: return true;
-        case 47: return false;
-        case 48: return true;
-        case 49: return true;
-        case 50: return true;
-        case 51: return true;
-        case 52: return true;
-        case 53: return true;
-        case 54: return true;
-        case 55: return true;
-        case 56: return true;
-        case 57: return true;
-        case 58: return false;
-        case 59: return false;
-        case 60: return false;
-        case 61: return false;
-        case 62: return false;
-        case 63: return false;
-        case 64: return false;
-        case 65: return true;
-        case 66: return true;
-        case 67: return true;
-        case 68: return true;
-        case 69: return true;
-        case 70: return true;
-        case 71: return true;
-        case 72: return true;
-        case 73: return true;
-        case 74: return true;
-        case 75: return true;
-        case 76: return true;
-        case 77: return true;
-        case 78: return true;
-        case 79: return true;
-        case 80: return true;
-        case 81: return true;
-        case 82: return true;
-        case 83: return true;
-        case 84: return true;
-        case 85: return true;
-        case 86: return true;
-        case 87: return true;
-        case 88: return true;
-        case 89: return true;
-        case 90: return true;
-        case 91: return false;
-        case 92: return false;
-        case 93: return false;
-        case 94: return true;
-        case 95: return true;
-        case 96: return true;
-        case 97: return true;
-        case 98: return true;
-        case 99: return true;
-        case 100: return true;
-        case 101: return true;
-        case 102: return true;
-        case 103: return true;
-        case 104: return true;
-        case 105: return true;
-        case 106: return true;
-        case 107: return true;
-        case 108: return true;
-        case 109: return true;
-        case 110: return true;
-        case 111: return true;
-        case 112: return true;
-        case 113: return true;
-        case 114: return true;
-        case 115: return true;
-        case 116: return true;
-        case 117: return true;
-        case 118: return true;
-        case 119: return true;
-        case 120: return true;
-        case 121: return true;
-        case 122: return true;
-        case 123: return false;
-        case 124: return true;
-        case 125: return false;
-        case 126: return true;
-        case 127: return false;
-        case 128: return false;
-        case 129: return false;
-        case 130: return false;
-        case 131: return false;
-        case 132: return false;
-        case 133: return false;
-        case 134: return false;
-        case 135: return false;
-        case 136: return false;
-        case 137: return false;
-        case 138: return false;
-        case 139: return false;
-        case 140: return false;
-        case 141: return false;
-        case 142: return false;
-        case 143: return false;
-        case 144: return false;
-        case 145: return false;
-        case 146: return false;
-        case 147: return false;
-        case 148: return false;
-        case 149: return false;
-        case 150: return false;
-        case 151: return false;
-        case 152: return false;
-        case 153: return false;
-        case 154: return false;
-        case 155: return false;
-        case 156: return false;
-        case 157: return false;
-        case 158: return false;
-        case 159: return false;
-        case 160: return false;
-        case 161: return false;
-        case 162: return false;
-        case 163: return false;
-        case 164: return false;
-        case 165: return false;
-        case 166: return false;
-        case 167: return false;
-        case 168: return false;
-        case 169: return false;
-        case 170: return false;
-        case 171: return false;
-        case 172: return false;
-        case 173: return false;
-        case 174: return false;
-        case 175: return false;
-        case 176: return false;
-        case 177: return false;
-        case 178: return false;
-        case 179: return false;
-        case 180: return false;
-        case 181: return false;
-        case 182: return false;
-        case 183: return false;
-        case 184: return false;
-        case 185: return false;
-        case 186: return false;
-        case 187: return false;
-        case 188: return false;
-        case 189: return false;
-        case 190: return false;
-        case 191: return false;
-        case 192: return false;
-        case 193: return false;
-        case 194: return false;
-        case 195: return false;
-        case 196: return false;
-        case 197: return false;
-        case 198: return false;
-        case 199: return false;
-        case 200: return false;
-        case 201: return false;
-        case 202: return false;
-        case 203: return false;
-        case 204: return false;
-        case 205: return false;
-        case 206: return false;
-        case 207: return false;
-        case 208: return false;
-        case 209: return false;
-        case 210: return false;
-        case 211: return false;
-        case 212: return false;
-        case 213: return false;
-        case 214: return false;
-        case 215: return false;
-        case 216: return false;
-        case 217: return false;
-        case 218: return false;
-        case 219: return false;
-        case 220: return false;
-        case 221: return false;
-        case 222: return false;
-        case 223: return false;
-        case 224: return false;
-        case 225: return false;
-        case 226: return false;
-        case 227: return false;
-        case 228: return false;
-        case 229: return false;
-        case 230: return false;
-        case 231: return false;
-        case 232: return false;
-        case 233: return false;
-        case 234: return false;
-        case 235: return false;
-        case 236: return false;
-        case 237: return false;
-        case 238: return false;
-        case 239: return false;
-        case 240: return false;
-        case 241: return false;
-        case 242: return false;
-        case 243: return false;
-        case 244: return false;
-        case 245: return false;
-        case 246: return false;
-        case 247: return false;
-        case 248: return false;
-        case 249: return false;
-        case 250: return false;
-        case 251: return false;
-        case 252: return false;
-        case 253: return false;
-        case 254: return false;
-        case 255: return false;
-        default: return false;
+namespace {
+
+constexpr bool in_range(unsigned int ch, unsigned int first, unsigned int last) {
+    return ch >= first && ch <= last;
+}
+
+constexpr std::uint8_t classify(unsigned int ch) {
+    bool alpha = in_range(ch, 0x41, 0x5a) || in_range(ch, 0x61, 0x7a);
+    bool digit = in_range(ch, 0x30, 0x39);
+    bool whitespace = ch == 0x20 || ch == 0x09;
+    bool tchar = alpha || digit;
+
+    for (const char *special = "!#$%&'*+-.^_`|~"; *special; ++special) {
+        tchar = tchar || static_cast<unsigned char>(*special) == ch;
     }
+
+    bool qdtext = whitespace || ch == 0x21 || in_range(ch, 0x23, 0x5b) || in_range(ch, 0x5d, 0x7e) || ch >= 0x80;
+    bool quoted_pair_char = whitespace || in_range(ch, 0x21, 0x7e) || ch >= 0x80;
+
+    return (tchar ? detail::tchar_class : 0) |
+           (qdtext ? detail::qdtext_class : 0) |
+           (quoted_pair_char ? detail::quoted_pair_char_class : 0) |
+           (whitespace ? detail::whitespace_class : 0) |
+           (alpha ? detail::alpha_class : 0) |
+           (digit ? detail::digit_class : 0);
 }
 
-bool detail::is_qdtext(char ch) {
-    switch (static_cast<unsigned char>(ch)) {
-        case 0: return false;
-        case 1: return false;
-        case 2: return false;
-        case 3: return false;
-        case 4: return false;
-        case 5: return false;
-        case 6: return false;
-        case 7: return false;
-        case 8: return false;
-        case 9: return true;
-        case 10: return false;
-        case 11: return false;
-        case 12: return false;
-        case 13: return false;
-        case 14: return false;
-        case 15: return false;
-        case 16: return false;
-        case 17: return false;
-        case 18: return false;
-        case 19: return false;
-        case 20: return false;
-        case 21: return false;
-        case 22: return false;
-        case 23: return false;
-        case 24: return false;
-        case 25: return false;
-        case 26: return false;
-        case 27: return false;
-        case 28: return false;
-        case 29: return false;
-        case 30: return false;
-        case 31: return false;
-        case 32: return true;
-        case 33: return true;
-        case 34: return false;
-        case 35: return true;
-        case 36: return true;
-        case 37: return true;
-        case 38: return true;
-        case 39: return true;
-        case 40: return true;
-        case 41: return true;
-        case 42: return true;
-        case 43: return true;
-        case 44: return true;
-        case 45: return true;
-        case 46: return true;
-        case 47: return true;
-        case 48: return true;
-        case 49: return true;
-        case 50: return true;
-        case 51: return true;
-        case 52: return true;
-        case 53: return true;
-        case 54: return true;
-        case 55: return true;
-        case 56: return true;
-        case 57: return true;
-        case 58: return true;
-        case 59: return true;
-        case 60: return true;
-        case 61: return true;
-        case 62: return true;
-        case 63: return true;
-        case 64: return true;
-        case 65: return true;
-        case 66: return true;
-        case 67: return true;
-        case 68: return true;
-        case 69: return true;
-        case 70: return true;
-        case 71: return true;
-        case 72: return true;
-        case 73: return true;
-        case 74: return true;
-        case 75: return true;
-        case 76: return true;
-        case 77: return true;
-        case 78: return true;
-        case 79: return true;
-        case 80: return true;
-        case 81: return true;
-        case 82: return true;
-        case 83: return true;
-        case 84: return true;
-        case 85: return true;
-        case 86: return true;
-        case 87: return true;
-        case 88: return true;
-        case 89: return true;
-        case 90: return true;
-        case 91: return true;
-        case 92: return false;
-        case 93: return true;
-        case 94: return true;
-        case 95: return true;
-        case 96: return true;
-        case 97: return true;
-        case 98: return true;
-        case 99: return true;
-        case 100: return true;
-        case 101: return true;
-        case 102: return true;
-        case 103: return true;
-        case 104: return true;
-        case 105: return true;
-        case 106: return true;
-        case 107: return true;
-        case 108: return true;
-        case 109: return true;
-        case 110: return true;
-        case 111: return true;
-        case 112: return true;
-        case 113: return true;
-        case 114: return true;
-        case 115: return true;
-        case 116: return true;
-        case 117: return true;
-        case 118: return true;
-        case 119: return true;
-        case 120: return true;
-        case 121: return true;
-        case 122: return true;
-        case 123: return true;
-        case 124: return true;
-        case 125: return true;
-        case 126: return true;
-        case 127: return false;
-        case 128: return true;
-        case 129: return true;
-        case 130: return true;
-        case 131: return true;
-        case 132: return true;
-        case 133: return true;
-        case 134: return true;
-        case 135: return true;
-        case 136: return true;
-        case 137: return true;
-        case 138: return true;
-        case 139: return true;
-        case 140: return true;
-        case 141: return true;
-        case 142: return true;
-        case 143: return true;
-        case 144: return true;
-        case 145: return true;
-        case 146: return true;
-        case 147: return true;
-        case 148: return true;
-        case 149: return true;
-        case 150: return true;
-        case 151: return true;
-        case 152: return true;
-        case 153: return true;
-        case 154: return true;
-        case 155: return true;
-        case 156: return true;
-        case 157: return true;
-        case 158: return true;
-        case 159: return true;
-        case 160: return true;
-        case 161: return true;
-        case 162: return true;
-        case 163: return true;
-        case 164: return true;
-        case 165: return true;
-        case 166: return true;
-        case 167: return true;
-        case 168: return true;
-        case 169: return true;
-        case 170: return true;
-        case 171: return true;
-        case 172: return true;
-        case 173: return true;
-        case 174: return true;
-        case 175: return true;
-        case 176: return true;
-        case 177: return true;
-        case 178: return true;
-        case 179: return true;
-        case 180: return true;
-        case 181: return true;
-        case 182: return true;
-        case 183: return true;
-        case 184: return true;
-        case 185: return true;
-        case 186: return true;
-        case 187: return true;
-        case 188: return true;
-        case 189: return true;
-        case 190: return true;
-        case 191: return true;
-        case 192: return true;
-        case 193: return true;
-        case 194: return true;
-        case 195: return true;
-        case 196: return true;
-        case 197: return true;
-        case 198: return true;
-        case 199: return true;
-        case 200: return true;
-        case 201: return true;
-        case 202: return true;
-        case 203: return true;
-        case 204: return true;
-        case 205: return true;
-        case 206: return true;
-        case 207: return true;
-        case 208: return true;
-        case 209: return true;
-        case 210: return true;
-        case 211: return true;
-        case 212: return true;
-        case 213: return true;
-        case 214: return true;
-        case 215: return true;
-        case 216: return true;
-        case 217: return true;
-        case 218: return true;
-        case 219: return true;
-        case 220: return true;
-        case 221: return true;
-        case 222: return true;
-        case 223: return true;
-        case 224: return true;
-        case 225: return true;
-        case 226: return true;
-        case 227: return true;
-        case 228: return true;
-        case 229: return true;
-        case 230: return true;
-        case 231: return true;
-        case 232: return true;
-        case 233: return true;
-        case 234: return true;
-        case 235: return true;
-        case 236: return true;
-        case 237: return true;
-        case 238: return true;
-        case 239: return true;
-        case 240: return true;
-        case 241: return true;
-        case 242: return true;
-        case 243: return true;
-        case 244: return true;
-        case 245: return true;
-        case 246: return true;
-        case 247: return true;
-        case 248: return true;
-        case 249: return true;
-        case 250: return true;
-        case 251: return true;
-        case 252: return true;
-        case 253: return true;
-        case 254: return true;
-        case 255: return true;
-        default: return false;
+
+// Everything a vectorized scan needs to know about a character class.
+struct class_scanner_t {
+    detail::char_class_t char_class;
+
+    // Splits the 256 octets into 16 rows by the high nibble.
+    // An octet belongs to the class iff low[its low nibble] & high[its high nibble] != 0.
+    // Every distinct row gets its own bit, so it works for classes made of up to 8 distinct rows.
+    std::uint8_t low[16];
+    std::uint8_t high[16];
+
+    // Up to 8 ranges of octets for PCMPESTRI which cover all octets outside the class.
+    // They may cover some octets of the class too, so every match is checked against the table.
+    std::uint8_t ranges[16];
+    int ranges_size;
+};
+
+constexpr class_scanner_t make_scanner(detail::char_class_t char_class) {
+    class_scanner_t scanner{char_class, {}, {}, {}, 0};
+
+    std::uint16_t rows[8] = {};
+    std::size_t rows_count = 0;
+
+    for (unsigned int high = 0; high < 16; ++high) {
+        std::uint16_t row = 0;
+
+        for (unsigned int low = 0; low < 16; ++low) {
+            if (classify(high << 4 | low) & char_class) {
+                row |= 1 << low;
+            }
+        }
+
+        if (row == 0) {
+            continue;
+        }
+
+        std::size_t bit = 0;
+
+        while (bit < rows_count && rows[bit] != row) {
+            ++bit;
+        }
+
+        if (bit == rows_count) {
+            rows[rows_count++] = row;
+        }
+
+        scanner.high[high] |= 1 << bit;
+
+        for (unsigned int low = 0; low < 16; ++low) {
+            if (row & (1 << low)) {
+                scanner.low[low] |= 1 << bit;
+            }
+        }
+    }
+
+    // Collect ranges of octets outside the class. When there are too many of them, the last range is extended.
+    unsigned int first = 0;
+
+    while (first < 256) {
+        if (classify(first) & char_class) {
+            ++first;
+            continue;
+        }
+
+        unsigned int last = first;
+
+        while (last + 1 < 256 && !(classify(last + 1) & char_class)) {
+            ++last;
+        }
+
+        if (scanner.ranges_size == 16) {
+            scanner.ranges[15] = static_cast<std::uint8_t>(last);
+        } else {
+            scanner.ranges[scanner.ranges_size++] = static_cast<std::uint8_t>(first);
+            scanner.ranges[scanner.ranges_size++] = static_cast<std::uint8_t>(last);
+        }
+
+        first = last + 1;
     }
+
+    return scanner;
 }
 
-bool detail::is_quoted_pair_char(char ch) {
-    switch (static_cast<unsigned char>(ch)) {
-        case 0: return false;
-        case 1: return false;
-        case 2: return false;
-        case 3: return false;
-        case 4: return false;
-        case 5: return false;
-        case 6: return false;
-        case 7: return false;
-        case 8: return false;
-        case 9: return true;
-        case 10: return false;
-        case 11: return false;
-        case 12: return false;
-        case 13: return false;
-        case 14: return false;
-        case 15: return false;
-        case 16: return false;
-        case 17: return false;
-        case 18: return false;
-        case 19: return false;
-        case 20: return false;
-        case 21: return false;
-        case 22: return false;
-        case 23: return false;
-        case 24: return false;
-        case 25: return false;
-        case 26: return false;
-        case 27: return false;
-        case 28: return false;
-        case 29: return false;
-        case 30: return false;
-        case 31: return false;
-        case 32: return true;
-        case 33: return true;
-        case 34: return true;
-        case 35: return true;
-        case 36: return true;
-        case 37: return true;
-        case 38: return true;
-        case 39: return true;
-        case 40: return true;
-        case 41: return true;
-        case 42: return true;
-        case 43: return true;
-        case 44: return true;
-        case 45: return true;
-        case 46: return true;
-        case 47: return true;
-        case 48: return true;
-        case 49: return true;
-        case 50: return true;
-        case 51: return true;
-        case 52: return true;
-        case 53: return true;
-        case 54: return true;
-        case 55: return true;
-        case 56: return true;
-        case 57: return true;
-        case 58: return true;
-        case 59: return true;
-        case 60: return true;
-        case 61: return true;
-        case 62: return true;
-        case 63: return true;
-        case 64: return true;
-        case 65: return true;
-        case 66: return true;
-        case 67: return true;
-        case 68: return true;
-        case 69: return true;
-        case 70: return true;
-        case 71: return true;
-        case 72: return true;
-        case 73: return true;
-        case 74: return true;
-        case 75: return true;
-        case 76: return true;
-        case 77: return true;
-        case 78: return true;
-        case 79: return true;
-        case 80: return true;
-        case 81: return true;
-        case 82: return true;
-        case 83: return true;
-        case 84: return true;
-        case 85: return true;
-        case 86: return true;
-        case 87: return true;
-        case 88: return true;
-        case 89: return true;
-        case 90: return true;
-        case 91: return true;
-        case 92: return true;
-        case 93: return true;
-        case 94: return true;
-        case 95: return true;
-        case 96: return true;
-        case 97: return true;
-        case 98: return true;
-        case 99: return true;
-        case 100: return true;
-        case 101: return true;
-        case 102: return true;
-        case 103: return true;
-        case 104: return true;
-        case 105: return true;
-        case 106: return true;
-        case 107: return true;
-        case 108: return true;
-        case 109: return true;
-        case 110: return true;
-        case 111: return true;
-        case 112: return true;
-        case 113: return true;
-        case 114: return true;
-        case 115: return true;
-        case 116: return true;
-        case 117: return true;
-        case 118: return true;
-        case 119: return true;
-        case 120: return true;
-        case 121: return true;
-        case 122: return true;
-        case 123: return true;
-        case 124: return true;
-        case 125: return true;
-        case 126: return true;
-        case 127: return false;
-        case 128: return true;
-        case 129: return true;
-        case 130: return true;
-        case 131: return true;
-        case 132: return true;
-        case 133: return true;
-        case 134: return true;
-        case 135: return true;
-        case 136: return true;
-        case 137: return true;
-        case 138: return true;
-        case 139: return true;
-        case 140: return true;
-        case 141: return true;
-        case 142: return true;
-        case 143: return true;
-        case 144: return true;
-        case 145: return true;
-        case 146: return true;
-        case 147: return true;
-        case 148: return true;
-        case 149: return true;
-        case 150: return true;
-        case 151: return true;
-        case 152: return true;
-        case 153: return true;
-        case 154: return true;
-        case 155: return true;
-        case 156: return true;
-        case 157: return true;
-        case 158: return true;
-        case 159: return true;
-        case 160: return true;
-        case 161: return true;
-        case 162: return true;
-        case 163: return true;
-        case 164: return true;
-        case 165: return true;
-        case 166: return true;
-        case 167: return true;
-        case 168: return true;
-        case 169: return true;
-        case 170: return true;
-        case 171: return true;
-        case 172: return true;
-        case 173: return true;
-        case 174: return true;
-        case 175: return true;
-        case 176: return true;
-        case 177: return true;
-        case 178: return true;
-        case 179: return true;
-        case 180: return true;
-        case 181: return true;
-        case 182: return true;
-        case 183: return true;
-        case 184: return true;
-        case 185: return true;
-        case 186: return true;
-        case 187: return true;
-        case 188: return true;
-        case 189: return true;
-        case 190: return true;
-        case 191: return true;
-        case 192: return true;
-        case 193: return true;
-        case 194: return true;
-        case 195: return true;
-        case 196: return true;
-        case 197: return true;
-        case 198: return true;
-        case 199: return true;
-        case 200: return true;
-        case 201: return true;
-        case 202: return true;
-        case 203: return true;
-        case 204: return true;
-        case 205: return true;
-        case 206: return true;
-        case 207: return true;
-        case 208: return true;
-        case 209: return true;
-        case 210: return true;
-        case 211: return true;
-        case 212: return true;
-        case 213: return true;
-        case 214: return true;
-        case 215: return true;
-        case 216: return true;
-        case 217: return true;
-        case 218: return true;
-        case 219: return true;
-        case 220: return true;
-        case 221: return true;
-        case 222: return true;
-        case 223: return true;
-        case 224: return true;
-        case 225: return true;
-        case 226: return true;
-        case 227: return true;
-        case 228: return true;
-        case 229: return true;
-        case 230: return true;
-        case 231: return true;
-        case 232: return true;
-        case 233: return true;
-        case 234: return true;
-        case 235: return true;
-        case 236: return true;
-        case 237: return true;
-        case 238: return true;
-        case 239: return true;
-        case 240: return true;
-        case 241: return true;
-        case 242: return true;
-        case 243: return true;
-        case 244: return true;
-        case 245: return true;
-        case 246: return true;
-        case 247: return true;
-        case 248: return true;
-        case 249: return true;
-        case 250: return true;
-        case 251: return true;
-        case 252: return true;
-        case 253: return true;
-        case 254: return true;
-        case 255: return true;
-        default: return false;
+
+constexpr class_scanner_t tchar_scanner = make_scanner(detail::tchar_class);
+constexpr class_scanner_t qdtext_scanner = make_scanner(detail::qdtext_class);
+
+
+std::size_t count_scalar(const char *data, std::size_t size, const class_scanner_t &scanner) {
+    std::size_t count = 0;
+
+    while (count < size && detail::has_char_class(data[count], scanner.char_class)) {
+        ++count;
     }
+
+    return count;
 }
 
-bool detail::is_whitespace(char ch) {
-    unsigned char uch = ch;
-    return uch == 0x20 || uch == 0x09;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#define HTTPLIB_HAS_X86_SCANNERS
+
+__attribute__((target("sse4.2")))
+std::size_t count_sse42(const char *data, std::size_t size, const class_scanner_t &scanner) {
+    const __m128i ranges = _mm_loadu_si128(reinterpret_cast<const __m128i *>(scanner.ranges));
+
+    std::size_t offset = 0;
+
+    while (offset + 16 <= size) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + offset));
+
+        int index = _mm_cmpestri(
+            ranges,
+            scanner.ranges_size,
+            chunk,
+            16,
+            _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT
+        );
+
+        offset += index;
+
+        if (index < 16) {
+            if (!detail::has_char_class(data[offset], scanner.char_class)) {
+                return offset;
+            }
+
+            // A false positive from a merged range.
+            ++offset;
+        }
+    }
+
+    return offset + count_scalar(data + offset, size - offset, scanner);
 }
 
-bool detail::is_alpha(char ch) {
-    unsigned char uch = ch;
-    return (uch >= 0x41 && uch <= 0x5a) || (uch >= 0x61 && uch <= 0x7a);
+
+__attribute__((target("avx2")))
+std::size_t count_avx2(const char *data, std::size_t size, const class_scanner_t &scanner) {
+    const __m256i low_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(scanner.low)));
+    const __m256i high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(scanner.high)));
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+    const __m256i zero = _mm256_setzero_si256();
+
+    std::size_t offset = 0;
+
+    for (; offset + 32 <= size; offset += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + offset));
+        __m256i low = _mm256_shuffle_epi8(low_table, _mm256_and_si256(chunk, nibble_mask));
+        __m256i high = _mm256_shuffle_epi8(high_table, _mm256_and_si256(_mm256_srli_epi16(chunk, 4), nibble_mask));
+        __m256i outside = _mm256_cmpeq_epi8(_mm256_and_si256(low, high), zero);
+
+        auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(outside));
+
+        if (mask != 0) {
+            return offset + static_cast<std::size_t>(__builtin_ctz(mask));
+        }
+    }
+
+    return offset + count_scalar(data + offset, size - offset, scanner);
 }
 
-bool detail::is_digit(char ch) {
-    unsigned char uch = ch;
-    return uch >= 0x30 && uch <= 0x39;
+#endif
+
+
+using count_function_t = std::size_t (*)(const char *, std::size_t, const class_scanner_t &);
+
+count_function_t select_count_function() {
+#ifdef HTTPLIB_HAS_X86_SCANNERS
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return &count_avx2;
+    }
+
+    if (__builtin_cpu_supports("sse4.2")) {
+        return &count_sse42;
+    }
+#endif
+
+    return &count_scalar;
 }
 
-boost::optional<std::string> detail::parse_token(boost::string_view &data) {
-    std::size_t token_size = 0;
 
-    for (; token_size < data.size(); ++token_size) {
-        if (!is_tchar(data[token_size])) {
-            break;
-        }
+std::size_t count(boost::string_view data, const class_scanner_t &scanner) {
+    // Typical tokens are short, it's not worth the indirect call.
+    if (data.size() < 16) {
+        return count_scalar(data.data(), data.size(), scanner);
     }
 
+    static const count_function_t function = select_count_function();
+
+    return function(data.data(), data.size(), scanner);
+}
+
+} // namespace
+
+
+#define HTTPLIB_CLASSIFY_4(ch) classify(ch), classify(ch + 1), classify(ch + 2), classify(ch + 3)
+#define HTTPLIB_CLASSIFY_16(ch) HTTPLIB_CLASSIFY_4(ch), HTTPLIB_CLASSIFY_4(ch + 4), HTTPLIB_CLASSIFY_4(ch + 8), HTTPLIB_CLASSIFY_4(ch + 12)
+#define HTTPLIB_CLASSIFY_64(ch) HTTPLIB_CLASSIFY_16(ch), HTTPLIB_CLASSIFY_16(ch + 16), HTTPLIB_CLASSIFY_16(ch + 32), HTTPLIB_CLASSIFY_16(ch + 48)
+
+const std::uint8_t detail::char_classes[256] = {
+    HTTPLIB_CLASSIFY_64(0), HTTPLIB_CLASSIFY_64(64), HTTPLIB_CLASSIFY_64(128), HTTPLIB_CLASSIFY_64(192)
+};
+
+#undef HTTPLIB_CLASSIFY_64
+#undef HTTPLIB_CLASSIFY_16
+#undef HTTPLIB_CLASSIFY_4
+
+
+std::size_t detail::count_tchars(boost::string_view data) {
+    return count(data, tchar_scanner);
+}
+
+std::size_t detail::count_qdtext(boost::string_view data) {
+    return count(data, qdtext_scanner);
+}
+
+boost::optional<std::string> detail::parse_token(boost::string_view &data) {
+    std::size_t token_size = count_tchars(data);
+
     if (token_size == 0) {
         return boost::none;
     } else {
@@ -833,29 +275,23 @@ boost::optional<std::string> detail::parse_quoted_string(boost::string_view &dat
     }
 
     std::string result;
+    std::size_t position = 1;
 
-    auto it = data.begin();
-    auto end = data.end();
-    ++it;
+    while (position < data.size()) {
+        std::size_t text_size = count_qdtext(data.substr(position));
+        result.append(data.data() + position, text_size);
+        position += text_size;
 
-    bool in_quoted_pair = false;
+        if (position == data.size()) {
+            break;
+        }
 
-    for (; it != end; ++it) {
-        if (in_quoted_pair) {
-            if (is_quoted_pair_char(*it)) {
-                result.push_back(*it);
-                in_quoted_pair = false;
-            } else {
-                return boost::none;
-            }
-        } else if (*it == '"') {
-            ++it;
-            data = data.substr(it - data.begin());
+        if (data[position] == '"') {
+            data = data.substr(position + 1);
             return result;
-        } else if (*it == '\\') {
-            in_quoted_pair = true;
-        } else if (is_qdtext(*it)) {
-            result.push_back(*it);
+        } else if (data[position] == '\\' && position + 1 < data.size() && is_quoted_pair_char(data[position + 1])) {
+            result.push_back(data[position + 1]);
+            position += 2;
         } else {
             return boost::none;
         }
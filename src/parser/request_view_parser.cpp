@@ -0,0 +1,369 @@
+#include <httplib/parser/request_view_parser.hpp>
+
+#include <httplib/error.hpp>
+#include <httplib/parser/detail/utility.hpp>
+
+#include <boost/container/small_vector.hpp>
+
+#include <http_parser.h>
+
+#include <string>
+
+
+HTTPLIB_OPEN_NAMESPACE
+
+
+class http_request_view_parser_t::implementation_t {
+public:
+    // A part of the head.
+    // It points either to the data passed to the current parse() call or, if data is nullptr, into the storage.
+    struct span_t {
+        const char *data = nullptr;
+        std::size_t offset = 0;
+        std::size_t size = 0;
+    };
+
+    struct header_t {
+        span_t name;
+        span_t value;
+    };
+
+    http_parsing_options_t options;
+
+    boost::system::error_code error;
+    http_request_view_t request;
+
+    // Parts of the head which didn't fit into a single parse() call.
+    std::string storage;
+
+    span_t method;
+    span_t target;
+    boost::container::small_vector<header_t, 16> headers;
+
+    span_t current_header_name;
+    span_t current_header_value;
+
+    enum class state_t {
+        start,
+        parsing_header_name,
+        parsing_header_value,
+        waiting_last_lf,
+        done
+    };
+
+    state_t state;
+
+    joyent::http_parser parser;
+    joyent::http_parser_settings settings;
+
+    implementation_t() :
+        state(state_t::start)
+    {
+        joyent::http_parser_init(&parser, joyent::HTTP_REQUEST);
+        joyent::http_parser_settings_init(&settings);
+
+        settings.on_method = [](joyent::http_parser *parser, const char *data, size_t size) {
+            return static_cast<implementation_t *>(parser->data)->handle_method(data, size);
+        };
+
+        settings.on_url = [](joyent::http_parser *parser, const char *data, size_t size) {
+            return static_cast<implementation_t *>(parser->data)->handle_url(data, size);
+        };
+
+        settings.on_header_field = [](joyent::http_parser *parser, const char *data, size_t size) {
+            return static_cast<implementation_t *>(parser->data)->handle_header_field(data, size);
+        };
+
+        settings.on_header_value = [](joyent::http_parser *parser, const char *data, size_t size) {
+            return static_cast<implementation_t *>(parser->data)->handle_header_value(data, size);
+        };
+
+        settings.on_headers_complete = [](joyent::http_parser *parser) {
+            return static_cast<implementation_t *>(parser->data)->handle_headers_complete();
+        };
+
+        settings.on_body = [](joyent::http_parser *parser, const char *data, size_t size) {
+            return static_cast<implementation_t *>(parser->data)->handle_body(data, size);
+        };
+
+        settings.on_message_complete = [](joyent::http_parser *parser) {
+            return static_cast<implementation_t *>(parser->data)->handle_message_complete();
+        };
+    }
+
+    // The copy must refer to its own storage.
+    implementation_t(const implementation_t &other) :
+        options(other.options),
+        error(other.error),
+        storage(other.storage),
+        method(other.method),
+        target(other.target),
+        headers(other.headers),
+        current_header_name(other.current_header_name),
+        current_header_value(other.current_header_value),
+        state(other.state),
+        parser(other.parser),
+        settings(other.settings)
+    {
+        if (state == state_t::done && !error) {
+            make_view();
+        }
+    }
+
+    void reset() {
+        error.clear();
+        request = http_request_view_t();
+        storage.clear();
+        method = span_t();
+        target = span_t();
+        headers.clear();
+        current_header_name = span_t();
+        current_header_value = span_t();
+        state = state_t::start;
+        joyent::http_parser_init(&parser, joyent::HTTP_REQUEST);
+    }
+
+    size_t parse(const char *data, size_t size) {
+        if (state == state_t::done) {
+            error = make_error_code(parser_errc_t::invalid_parser);
+            return 0;
+        }
+
+        if (size == 0) {
+            return 0;
+        }
+
+        std::size_t parsed = 0;
+
+        if (state != state_t::waiting_last_lf) {
+            parser.data = this;
+
+            parsed = joyent::http_parser_execute(&parser, &settings, data, size);
+
+            if (!error &&
+                parser.http_errno != joyent::HPE_OK &&
+                parser.http_errno != joyent::HPE_PAUSED)
+            {
+                error = boost::system::error_code(parser.http_errno, underlying_parser_category());
+            }
+        }
+
+        if (!error && parsed < size && state == state_t::waiting_last_lf) {
+            if (data[parsed] != '\n') {
+                error = boost::system::error_code(joyent::HPE_LF_EXPECTED, underlying_parser_category());
+            } else {
+                ++parsed;
+                state = state_t::done;
+            }
+        }
+
+        if (error) {
+            state = state_t::done;
+        } else if (state == state_t::done) {
+            make_view();
+        } else {
+            // The caller may reuse the data after this call, so we have to save the parts we refer to.
+            own_all();
+        }
+
+        return parsed;
+    }
+
+private:
+    const char *resolve(const span_t &span) const {
+        return span.data ? span.data : storage.data() + span.offset;
+    }
+
+    boost::string_view to_view(const span_t &span) const {
+        return boost::string_view(resolve(span), span.size);
+    }
+
+    void own(span_t &span) {
+        if (span.data) {
+            span.offset = storage.size();
+            storage.append(span.data, span.size);
+            span.data = nullptr;
+        }
+    }
+
+    // Spans are copied in the order they appear in the head, so the span being parsed always ends up
+    // at the end of the storage and may be continued in-place by the next parse() call.
+    void own_all() {
+        own(method);
+        own(target);
+
+        for (auto &header: headers) {
+            own(header.name);
+            own(header.value);
+        }
+
+        own(current_header_name);
+        own(current_header_value);
+    }
+
+    void append(span_t &span, const char *data, size_t size) {
+        if (span.size == 0) {
+            span.data = data;
+            span.size = size;
+        } else if (span.data && span.data + span.size == data) {
+            span.size += size;
+        } else {
+            own(span);
+            storage.append(data, size);
+            span.size += size;
+        }
+    }
+
+    void finish_header() {
+        const char *value = resolve(current_header_value);
+
+        while (current_header_value.size > 0 && detail::is_whitespace(value[current_header_value.size - 1])) {
+            --current_header_value.size;
+        }
+
+        headers.push_back(header_t{current_header_name, current_header_value});
+        current_header_name = span_t();
+        current_header_value = span_t();
+    }
+
+    void make_view() {
+        request.method = to_view(method);
+        request.target = to_view(target);
+        request.version.major = parser.http_major;
+        request.version.minor = parser.http_minor;
+
+        request.headers.clear();
+
+        for (const auto &header: headers) {
+            request.headers.add_header(to_view(header.name), to_view(header.value));
+        }
+    }
+
+    int handle_method(const char *data, size_t size) {
+        append(method, data, size);
+        return 0;
+    }
+
+    int handle_url(const char *data, size_t size) {
+        append(target, data, size);
+
+        if (target.size > options.max_url_size) {
+            error = make_error_code(parser_errc_t::too_long_url);
+            return -1;
+        }
+
+        return 0;
+    }
+
+    int handle_header_field(const char *data, size_t size) {
+        if (state == state_t::parsing_header_value) {
+            finish_header();
+        }
+
+        state = state_t::parsing_header_name;
+
+        append(current_header_name, data, size);
+
+        if (headers.size() >= options.max_headers_number) {
+            error = make_error_code(parser_errc_t::too_many_headers);
+            return -1;
+        }
+
+        if (current_header_name.size > options.max_header_size) {
+            error = make_error_code(parser_errc_t::too_long_header);
+            return -1;
+        }
+
+        return 0;
+    }
+
+    int handle_header_value(const char *data, size_t size) {
+        state = state_t::parsing_header_value;
+
+        append(current_header_value, data, size);
+
+        if (current_header_name.size + current_header_value.size > options.max_header_size) {
+            error = make_error_code(parser_errc_t::too_long_header);
+            return -1;
+        }
+
+        return 0;
+    }
+
+    int handle_headers_complete() {
+        if (state == state_t::parsing_header_value) {
+            finish_header();
+        }
+
+        state = state_t::waiting_last_lf;
+
+        joyent::http_parser_pause(&parser, 1);
+        return 0;
+    }
+
+    int handle_body(const char *, size_t) {
+        // We should not be here.
+        // It seems handle_headers_complete() has not been called for some reason.
+        assert(false);
+        return 0;
+    }
+
+    int handle_message_complete() {
+        // We should not be here.
+        // It seems handle_headers_complete() has not been called for some reason.
+        assert(false);
+        return 0;
+    }
+};
+
+
+http_request_view_parser_t::http_request_view_parser_t() :
+    m_implementation(std::make_unique<implementation_t>())
+{ }
+
+http_request_view_parser_t::http_request_view_parser_t(const http_request_view_parser_t &other) :
+    m_implementation(std::make_unique<implementation_t>(*other.m_implementation))
+{ }
+
+http_request_view_parser_t::http_request_view_parser_t(http_request_view_parser_t &&other) :
+    m_implementation(std::move(other.m_implementation))
+{ }
+
+http_request_view_parser_t::~http_request_view_parser_t() { }
+
+http_request_view_parser_t &http_request_view_parser_t::operator=(const http_request_view_parser_t &other) {
+    m_implementation = std::make_unique<implementation_t>(*other.m_implementation);
+    return *this;
+}
+
+http_request_view_parser_t &http_request_view_parser_t::operator=(http_request_view_parser_t &&other) {
+    m_implementation = std::move(other.m_implementation);
+    return *this;
+}
+
+void http_request_view_parser_t::set_options(http_parsing_options_t options) {
+    m_implementation->options = options;
+}
+
+void http_request_view_parser_t::reset() {
+    m_implementation->reset();
+}
+
+std::size_t http_request_view_parser_t::parse(const char *data, std::size_t size) {
+    return m_implementation->parse(data, size);
+}
+
+bool http_request_view_parser_t::done() const {
+    return m_implementation->state == implementation_t::state_t::done;
+}
+
+boost::system::error_code http_request_view_parser_t::error() const {
+    return m_implementation->error;
+}
+
+const http_request_view_t &http_request_view_parser_t::request() const {
+    return m_implementation->request;
+}
+
+
+HTTPLIB_CLOSE_NAMESPACE
@@ -65,6 +65,18 @@ public:
 
     implementation_t(const implementation_t &other) = default;
 
+    void reset() {
+        error.clear();
+        response.code = 0;
+        response.reason.clear();
+        response.version = http_version_t();
+        response.headers.clear();
+        current_header_name.clear();
+        current_header_value.clear();
+        state = state_t::start;
+        joyent::http_parser_init(&parser, joyent::HTTP_RESPONSE);
+    }
+
     size_t parse(const char *data, size_t size) {
         if (state == state_t::done) {
             error = make_error_code(parser_errc_t::invalid_parser);
@@ -217,6 +229,10 @@ void http_response_parser_t::set_options(http_parsing_options_t options) {
     m_implementation->options = options;
 }
 
+void http_response_parser_t::reset() {
+    m_implementation->reset();
+}
+
 std::size_t http_response_parser_t::parse(const char *data, std::size_t size) {
     return m_implementation->parse(data, size);
 }
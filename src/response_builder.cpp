@@ -1,5 +1,6 @@
 #include <httplib/response_builder.hpp>
 
+#include <httplib/http/date.hpp>
 #include <httplib/http/message_properties.hpp>
 
 #include <boost/lexical_cast.hpp>
@@ -9,7 +10,8 @@ HTTPLIB_OPEN_NAMESPACE
 
 
 http_response_builder_t::http_response_builder_t() :
-    m_version({1, 1})
+    m_version({1, 1}),
+    m_date(false)
 { }
 
 
@@ -46,26 +48,31 @@ http_response_builder_t &http_response_builder_t::chunked_encoding() {
     return *this;
 }
 
+http_response_builder_t &http_response_builder_t::date() {
+    m_date = true;
+    return *this;
+}
+
 
 http_response_t http_response_builder_t::build(const status_code_t &status) const {
-    return build(status.code(), status.description().to_string());
+    return build(status.code(), status.description());
 }
 
-http_response_t http_response_builder_t::build(unsigned int code, const std::string &reason) const {
+http_response_t http_response_builder_t::build(unsigned int code, boost::string_view reason) const {
     http_response_t response;
 
     response.code = code;
-    response.reason = reason;
+    response.reason.assign(reason.data(), reason.size());
     response.version = m_version;
     response.headers = m_headers;
 
     if (m_body_size) {
         switch (m_body_size->type) {
             case body_size_t::type_t::content_length: {
-                response.headers.set_header("Content-Length", {std::to_string(m_body_size->content_length)});
+                response.headers.set_header(known_header_t::content_length, {std::to_string(m_body_size->content_length)});
             } break;
             case body_size_t::type_t::transfer_encoding: {
-                response.headers.add_header_values("Transfer-Encoding", {"chunked"});
+                response.headers.add_header_values(known_header_t::transfer_encoding, {"chunked"});
             } break;
             default: {
                 assert(false);
@@ -73,16 +80,20 @@ http_response_t http_response_builder_t::build(unsigned int code, const std::str
         }
     }
 
+    if (m_date) {
+        response.headers.set_header(known_header_t::date, {current_http_date().to_string()});
+    }
+
     if (m_connection_status) {
         switch (*m_connection_status) {
             case connection_status_t::close: {
                 if (response.version >= http_version_t{1, 1}) {
-                    response.headers.set_header("Connection", {"close"});
+                    response.headers.set_header(known_header_t::connection, {"close"});
                 }
             } break;
             case connection_status_t::keep_alive: {
                 if (response.version <= http_version_t{1, 0}) {
-                    response.headers.set_header("Connection", {"keep-alive"});
+                    response.headers.set_header(known_header_t::connection, {"keep-alive"});
                 }
             } break;
         }
@@ -0,0 +1,148 @@
+#include <catch.hpp>
+
+#include <httplib/asio/bound_body_reader.hpp>
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/read_request.hpp>
+#include <httplib/error.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <functional>
+#include <string>
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+using stream_t = httplib::buffered_read_stream<socket_t &, boost::asio::streambuf &>;
+using reader_t = httplib::bound_body_reader<stream_t>;
+
+
+struct connection_t {
+    boost::asio::io_service io_service;
+    socket_t client{io_service};
+    socket_t server{io_service};
+    boost::asio::streambuf buffer;
+    stream_t stream{server, buffer};
+
+    connection_t() {
+        boost::asio::local::connect_pair(client, server);
+    }
+
+    void send(const std::string &data) {
+        boost::asio::write(client, boost::asio::buffer(data));
+    }
+};
+
+
+// Smaller than the caller's buffers in the tests, so the reader reads right into them.
+httplib::read_options_t direct_reads() {
+    httplib::read_options_t options;
+    options.read_buffer_size = 64;
+    options.max_read_buffer_size = 64;
+    return options;
+}
+
+
+const std::string next_request = "GET /next HTTP/1.1\r\nHost: localhost\r\n\r\n";
+
+} // namespace
+
+
+TEST_CASE("bound body reader reads directly into big buffers up to Content-Length", "[bound_body_reader]") {
+    connection_t connection;
+
+    const std::string body(300, 'x');
+    connection.send(body + next_request);
+
+    reader_t reader(connection.stream, body.size(), direct_reads());
+
+    std::string read;
+    char part[1024];
+
+    SECTION("synchronously") {
+        while (true) {
+            boost::system::error_code ec;
+            std::size_t transferred = reader.read_some(boost::asio::buffer(part), ec);
+            read.append(part, transferred);
+
+            // Nothing goes through the stream's buffer.
+            REQUIRE(connection.buffer.size() == 0);
+
+            if (ec == httplib::reader_errc_t::eof) {
+                break;
+            }
+
+            REQUIRE(!ec);
+        }
+    }
+
+    SECTION("asynchronously") {
+        bool eof = false;
+
+        std::function<void()> read_some;
+        read_some = [&] {
+            reader.async_read_some(boost::asio::buffer(part), [&](boost::system::error_code ec, std::size_t transferred) {
+                read.append(part, transferred);
+                REQUIRE(connection.buffer.size() == 0);
+
+                if (ec == httplib::reader_errc_t::eof) {
+                    eof = true;
+                } else {
+                    REQUIRE(!ec);
+                    read_some();
+                }
+            });
+        };
+
+        read_some();
+        connection.io_service.run();
+
+        REQUIRE(eof);
+    }
+
+    REQUIRE(read == body);
+
+    // The next request is left in the socket, not read into the caller's buffers.
+    REQUIRE(connection.server.available() == next_request.size());
+
+    httplib::http_request_parser_t parser;
+
+    REQUIRE(httplib::read_request(connection.stream, parser, {}).target == "/next");
+}
+
+
+TEST_CASE("bound body reader reads through the buffer into small buffers", "[bound_body_reader]") {
+    connection_t connection;
+
+    const std::string body(300, 'x');
+    connection.send(body + next_request);
+
+    reader_t reader(connection.stream, body.size(), direct_reads());
+
+    std::string read;
+    char part[32];
+
+    while (true) {
+        boost::system::error_code ec;
+        std::size_t transferred = reader.read_some(boost::asio::buffer(part), ec);
+        read.append(part, transferred);
+
+        if (ec == httplib::reader_errc_t::eof) {
+            break;
+        }
+
+        REQUIRE(!ec);
+    }
+
+    REQUIRE(read == body);
+
+    // The next request follows the body in the stream.
+    httplib::http_request_parser_t parser;
+
+    REQUIRE(httplib::read_request(connection.stream, parser, {}).target == "/next");
+}
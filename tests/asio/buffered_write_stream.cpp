@@ -0,0 +1,249 @@
+#include <catch.hpp>
+
+#include <httplib/asio/buffered_write_stream.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+using stream_t = httplib::buffered_write_stream<socket_t &>;
+
+
+struct connection_t {
+    boost::asio::io_service io_service;
+    socket_t client{io_service};
+    socket_t server{io_service};
+    stream_t stream{server, 1024};
+
+    connection_t() {
+        boost::asio::local::connect_pair(client, server);
+    }
+
+    // What the peer has received so far.
+    std::string received() {
+        std::string result(client.available(), '\0');
+
+        if (!result.empty()) {
+            boost::asio::read(client, boost::asio::buffer(&result[0], result.size()));
+        }
+
+        return result;
+    }
+};
+
+
+std::string make_data(std::size_t size, char first) {
+    std::string result;
+
+    for (std::size_t i = 0; i < size; ++i) {
+        result.push_back(static_cast<char>(first + i % 26));
+    }
+
+    return result;
+}
+
+
+// Passes the buffers it owns along with itself, like async_write() of asio 1.61 passes its consuming_buffers.
+struct owning_write_op {
+    stream_t &stream;
+    std::vector<boost::asio::const_buffer> buffers;
+    std::size_t &written;
+
+    void start() {
+        stream.async_write_some(buffers, std::move(*this));
+    }
+
+    void operator()(boost::system::error_code ec, std::size_t transferred) {
+        REQUIRE(!ec);
+        written = transferred;
+    }
+};
+
+} // namespace
+
+
+TEST_CASE("buffered write stream coalesces a chain of small writes", "[buffered_write_stream]") {
+    connection_t connection;
+
+    const std::vector<std::string> parts = {"first ", "second ", "third"};
+    std::size_t completed = 0;
+    std::size_t sent_before_end = 1;
+
+    std::function<void(boost::system::error_code, std::size_t)> on_write;
+    on_write = [&](boost::system::error_code ec, std::size_t transferred) {
+        REQUIRE(!ec);
+        REQUIRE(transferred == parts[completed].size());
+
+        ++completed;
+
+        if (completed < parts.size()) {
+            connection.stream.async_write_some(boost::asio::buffer(parts[completed]), on_write);
+        } else {
+            // Nothing has reached the socket while the handlers kept writing.
+            sent_before_end = connection.client.available();
+            REQUIRE(connection.stream.buffered_size() == std::string("first second third").size());
+        }
+    };
+
+    connection.stream.async_write_some(boost::asio::buffer(parts[0]), on_write);
+    connection.io_service.run();
+
+    REQUIRE(completed == 3);
+    REQUIRE(sent_before_end == 0);
+    REQUIRE(connection.stream.buffered_size() == 0);
+    REQUIRE(connection.received() == "first second third");
+}
+
+
+TEST_CASE("buffered write stream flushes at the end of a handler", "[buffered_write_stream]") {
+    connection_t connection;
+    bool completed = false;
+
+    connection.stream.async_write_some(boost::asio::buffer(std::string("small")), [&](auto ec, std::size_t) {
+        REQUIRE(!ec);
+        REQUIRE(connection.stream.buffered_size() == 5);
+        completed = true;
+    });
+
+    // The write completes without touching the socket.
+    REQUIRE(connection.stream.buffered_size() == 5);
+
+    connection.io_service.run();
+
+    REQUIRE(completed);
+    REQUIRE(connection.stream.buffered_size() == 0);
+    REQUIRE(connection.received() == "small");
+}
+
+
+TEST_CASE("buffered write stream gathers the buffer with a large write", "[buffered_write_stream]") {
+    connection_t connection;
+
+    const std::string head = "head ";
+    const auto body = make_data(4000, 'a');
+
+    SECTION("async_write_some") {
+        connection.stream.async_write_some(boost::asio::buffer(head), [&](auto ec, std::size_t) {
+            REQUIRE(!ec);
+
+            // Doesn't fit below the threshold, so it's sent along with the buffered head.
+            connection.stream.async_write_some(boost::asio::buffer(body), [&](auto ec, std::size_t transferred) {
+                REQUIRE(!ec);
+                REQUIRE(transferred == body.size());
+                REQUIRE(connection.stream.buffered_size() == 0);
+            });
+        });
+    }
+
+    SECTION("async_write with a buffer sequence") {
+        std::vector<boost::asio::const_buffer> buffers = {
+            boost::asio::buffer(head),
+            boost::asio::buffer(body.data(), 1000),
+            boost::asio::buffer(body.data() + 1000, body.size() - 1000)
+        };
+
+        boost::asio::async_write(connection.stream, buffers, [&](auto ec, std::size_t transferred) {
+            REQUIRE(!ec);
+            REQUIRE(transferred == head.size() + body.size());
+        });
+    }
+
+    SECTION("a handler owning the buffers") {
+        std::size_t written = 0;
+
+        owning_write_op{
+            connection.stream,
+            {boost::asio::buffer(head), boost::asio::buffer(body)},
+            written
+        }.start();
+
+        connection.io_service.run();
+
+        REQUIRE(written == head.size() + body.size());
+    }
+
+    connection.io_service.run();
+
+    REQUIRE(connection.stream.buffered_size() == 0);
+    REQUIRE(connection.received() == head + body);
+}
+
+
+TEST_CASE("buffered write stream queues a write behind a background flush", "[buffered_write_stream]") {
+    connection_t connection;
+
+    const auto body = make_data(4000, 'A');
+    std::vector<std::string> events;
+
+    connection.stream.async_write_some(boost::asio::buffer(std::string("first")), [&](auto ec, std::size_t) {
+        REQUIRE(!ec);
+        events.push_back("first");
+    });
+
+    // Runs the handler of the first write, which starts a background flush.
+    REQUIRE(connection.io_service.run_one() == 1);
+    REQUIRE(events.size() == 1);
+
+    // Doesn't fit, so it waits for the background flush.
+    connection.stream.async_write_some(boost::asio::buffer(body), [&](auto ec, std::size_t transferred) {
+        REQUIRE(!ec);
+        REQUIRE(transferred == body.size());
+        events.push_back("second");
+    });
+
+    // The first write is still being sent.
+    REQUIRE(connection.stream.buffered_size() == 5);
+
+    connection.io_service.run();
+
+    REQUIRE(events == (std::vector<std::string> {"first", "second"}));
+    REQUIRE(connection.stream.buffered_size() == 0);
+    REQUIRE(connection.received() == "first" + body);
+}
+
+
+TEST_CASE("buffered write stream reports an error of a background flush", "[buffered_write_stream]") {
+    connection_t connection;
+    connection.client.close();
+
+    bool completed = false;
+
+    connection.stream.async_write_some(boost::asio::buffer(std::string("lost")), [&](auto ec, std::size_t) {
+        // The write itself only went to the buffer.
+        REQUIRE(!ec);
+        completed = true;
+    });
+
+    connection.io_service.run();
+
+    REQUIRE(completed);
+
+    boost::system::error_code error;
+
+    connection.stream.async_write_some(boost::asio::buffer(std::string("next")), [&](auto ec, std::size_t transferred) {
+        error = ec;
+        REQUIRE(transferred == 0);
+    });
+
+    connection.io_service.reset();
+    connection.io_service.run();
+
+    REQUIRE(error == boost::asio::error::broken_pipe);
+
+    // The error sticks, for the synchronous functions too.
+    boost::system::error_code flush_error;
+    connection.stream.flush(flush_error);
+
+    REQUIRE(flush_error == boost::asio::error::broken_pipe);
+    REQUIRE_THROWS_AS(connection.stream.write_some(boost::asio::buffer(std::string("x"))), boost::system::system_error);
+}
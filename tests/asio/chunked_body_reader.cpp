@@ -0,0 +1,286 @@
+#include <catch.hpp>
+
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/chunked_body_reader.hpp>
+#include <httplib/asio/read_request.hpp>
+#include <httplib/error.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <functional>
+#include <string>
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+using stream_t = httplib::buffered_read_stream<socket_t &, boost::asio::streambuf &>;
+using reader_t = httplib::chunked_body_reader<stream_t>;
+
+
+struct connection_t {
+    boost::asio::io_service io_service;
+    socket_t client{io_service};
+    socket_t server{io_service};
+    boost::asio::streambuf buffer;
+    stream_t stream{server, buffer};
+
+    connection_t() {
+        boost::asio::local::connect_pair(client, server);
+    }
+
+    void send(const std::string &data) {
+        boost::asio::write(client, boost::asio::buffer(data));
+    }
+};
+
+
+std::string read_all(reader_t &reader) {
+    std::string result;
+    char buffer[7];
+
+    while (true) {
+        boost::system::error_code ec;
+        std::size_t transferred = reader.read_some(boost::asio::buffer(buffer), ec);
+
+        result.append(buffer, transferred);
+
+        if (ec == httplib::reader_errc_t::eof) {
+            return result;
+        }
+
+        REQUIRE(!ec);
+    }
+}
+
+
+std::string async_read_all(connection_t &connection, reader_t &reader) {
+    std::string result;
+    char buffer[7];
+    boost::system::error_code error;
+
+    std::function<void(boost::system::error_code, std::size_t)> on_read;
+    on_read = [&](boost::system::error_code ec, std::size_t transferred) {
+        result.append(buffer, transferred);
+
+        if (ec) {
+            error = ec;
+        } else {
+            reader.async_read_some(boost::asio::buffer(buffer), on_read);
+        }
+    };
+
+    reader.async_read_some(boost::asio::buffer(buffer), on_read);
+
+    connection.io_service.reset();
+    connection.io_service.run();
+
+    REQUIRE(error == httplib::reader_errc_t::eof);
+
+    return result;
+}
+
+
+// Reads the stream by read_size bytes, so the body is split across several reads.
+httplib::read_options_t small_reads(std::size_t read_size) {
+    httplib::read_options_t options;
+    options.read_buffer_size = read_size;
+    options.max_read_buffer_size = read_size;
+    return options;
+}
+
+
+std::string view_to_string(boost::asio::const_buffer view) {
+    return std::string(boost::asio::buffer_cast<const char *>(view), boost::asio::buffer_size(view));
+}
+
+} // namespace
+
+
+TEST_CASE("chunked body reader stops at the end of the body", "[chunked_body_reader]") {
+    connection_t connection;
+
+    // The whole body and the next pipelined request arrive with the same read.
+    connection.send("5\r\nhello\r\n"
+                    "11\r\n, chunked world!!\r\n"
+                    "0\r\n"
+                    "Trailer: value\r\n"
+                    "\r\n"
+                    "GET /next HTTP/1.1\r\nHost: a\r\n\r\n");
+
+    reader_t reader(connection.stream);
+
+    REQUIRE(read_all(reader) == "hello, chunked world!!");
+    REQUIRE(reader.trailer_headers().get_header("Trailer"));
+    REQUIRE(*reader.trailer_headers().get_header("Trailer") == "value");
+
+    auto request = httplib::read_request(connection.stream);
+
+    REQUIRE(request.method == "GET");
+    REQUIRE(request.target == "/next");
+}
+
+
+TEST_CASE("async chunked body reader stops at the end of the body", "[chunked_body_reader]") {
+    connection_t connection;
+
+    connection.send("5\r\nhello\r\n"
+                    "0\r\n\r\n"
+                    "GET /next HTTP/1.1\r\nHost: a\r\n\r\n");
+
+    reader_t reader(connection.stream);
+
+    REQUIRE(async_read_all(connection, reader) == "hello");
+
+    auto request = httplib::read_request(connection.stream);
+
+    REQUIRE(request.target == "/next");
+}
+
+
+TEST_CASE("chunked body reader returns the rest of a partially consumed view", "[chunked_body_reader]") {
+    connection_t connection;
+
+    // A chunk of 10 bytes, only 4 of them have arrived.
+    connection.send("a\r\n0123");
+
+    reader_t reader(connection.stream);
+
+    auto view = reader.read_some_view();
+    std::size_t buffered = connection.stream.buffer().size();
+
+    REQUIRE(view_to_string(view) == "0123");
+    REQUIRE(buffered >= 4);
+
+    // The view points into the stream's buffer, which is consumed only after the whole view is consumed.
+    reader.consume(1);
+
+    auto rest = reader.read_some_view();
+
+    REQUIRE(view_to_string(rest) == "123");
+    REQUIRE(boost::asio::buffer_cast<const char *>(rest) == boost::asio::buffer_cast<const char *>(view) + 1);
+    REQUIRE(connection.stream.buffer().size() == buffered);
+
+    reader.consume(2);
+
+    REQUIRE(view_to_string(reader.read_some_view()) == "3");
+    REQUIRE(connection.stream.buffer().size() == buffered);
+
+    reader.consume(1);
+
+    // Everything parsed along with the view, the chunk size included.
+    REQUIRE(connection.stream.buffer().size() == 0);
+
+    // The rest of the chunk and the next ones arrive later.
+    connection.send("456789\r\n5\r\nhello\r\n0\r\n\r\n");
+
+    view = reader.read_some_view();
+
+    REQUIRE(view_to_string(view) == "456789");
+
+    // Consuming more than the view is the same as consuming the whole view.
+    reader.consume(100);
+
+    REQUIRE(view_to_string(reader.read_some_view()) == "hello");
+
+    reader.consume(5);
+
+    boost::system::error_code ec;
+    view = reader.read_some_view(ec);
+
+    REQUIRE(ec == httplib::reader_errc_t::eof);
+    REQUIRE(boost::asio::buffer_size(view) == 0);
+    REQUIRE(connection.stream.buffer().size() == 0);
+}
+
+
+TEST_CASE("chunked body reader views a body split across reads and chunks", "[chunked_body_reader]") {
+    connection_t connection;
+
+    connection.send("5\r\nhello\r\n"
+                    "11\r\n, chunked world!!\r\n"
+                    "0\r\n\r\n");
+
+    reader_t reader(connection.stream, small_reads(4));
+
+    SECTION("synchronously") {
+        std::string body;
+
+        while (true) {
+            boost::system::error_code ec;
+            auto view = reader.read_some_view(ec);
+
+            if (ec == httplib::reader_errc_t::eof) {
+                break;
+            }
+
+            REQUIRE(!ec);
+            REQUIRE(boost::asio::buffer_size(view) > 0);
+            REQUIRE(boost::asio::buffer_size(view) <= 4);
+
+            // Take the view by one byte at a time.
+            body.push_back(*boost::asio::buffer_cast<const char *>(view));
+            reader.consume(1);
+        }
+
+        REQUIRE(body == "hello, chunked world!!");
+    }
+
+    SECTION("asynchronously") {
+        std::string body;
+        boost::system::error_code error;
+        std::size_t views = 0;
+
+        std::function<void(boost::system::error_code, boost::asio::const_buffer)> on_view;
+        on_view = [&](boost::system::error_code ec, boost::asio::const_buffer view) {
+            if (ec) {
+                error = ec;
+                return;
+            }
+
+            ++views;
+
+            // Take a half of the view, the next call returns the rest of it.
+            std::size_t size = (boost::asio::buffer_size(view) + 1) / 2;
+            body += view_to_string(boost::asio::buffer(view, size));
+            reader.consume(size);
+
+            reader.async_read_some_view(on_view);
+        };
+
+        reader.async_read_some_view(on_view);
+        connection.io_service.run();
+
+        REQUIRE(error == httplib::reader_errc_t::eof);
+        REQUIRE(body == "hello, chunked world!!");
+        REQUIRE(views > 6);
+    }
+
+    REQUIRE(connection.stream.buffer().size() == 0);
+}
+
+
+TEST_CASE("chunked body reader copies a body split across reads and chunks", "[chunked_body_reader]") {
+    connection_t connection;
+
+    connection.send("5\r\nhello\r\n"
+                    "11\r\n, chunked world!!\r\n"
+                    "0\r\n\r\n"
+                    "GET /next HTTP/1.1\r\nHost: a\r\n\r\n");
+
+    reader_t reader(connection.stream, small_reads(3));
+
+    SECTION("synchronously") {
+        REQUIRE(read_all(reader) == "hello, chunked world!!");
+    }
+
+    SECTION("asynchronously") {
+        REQUIRE(async_read_all(connection, reader) == "hello, chunked world!!");
+    }
+
+    REQUIRE(httplib::read_request(connection.stream).target == "/next");
+}
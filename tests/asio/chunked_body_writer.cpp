@@ -0,0 +1,269 @@
+#include <catch.hpp>
+
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/chunked_body_reader.hpp>
+#include <httplib/asio/chunked_body_writer.hpp>
+#include <httplib/error.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <string>
+#include <vector>
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+using writer_t = httplib::chunked_body_writer<socket_t>;
+
+
+struct connection_t {
+    boost::asio::io_service io_service;
+    socket_t client{io_service};
+    socket_t server{io_service};
+
+    connection_t() {
+        boost::asio::local::connect_pair(client, server);
+    }
+
+    // What the peer has received so far.
+    std::string received() {
+        std::string result(client.available(), '\0');
+
+        if (!result.empty()) {
+            boost::asio::read(client, boost::asio::buffer(&result[0], result.size()));
+        }
+
+        return result;
+    }
+};
+
+
+struct body_t {
+    std::string data;
+    httplib::http_headers_t trailers;
+};
+
+
+// Parses the chunked body back.
+body_t read_back(const std::string &encoded) {
+    connection_t connection;
+    boost::asio::write(connection.server, boost::asio::buffer(encoded));
+
+    boost::asio::streambuf buffer;
+    httplib::buffered_read_stream<socket_t &, boost::asio::streambuf &> stream(connection.client, buffer);
+    httplib::chunked_body_reader<decltype(stream)> reader(stream);
+
+    body_t result;
+    char part[16];
+
+    while (true) {
+        boost::system::error_code ec;
+        std::size_t transferred = reader.read_some(boost::asio::buffer(part), ec);
+        result.data.append(part, transferred);
+
+        if (ec == httplib::reader_errc_t::eof) {
+            break;
+        }
+
+        REQUIRE(!ec);
+    }
+
+    result.trailers = reader.trailer_headers();
+
+    // Nothing follows the body.
+    REQUIRE(buffer.size() == 0);
+
+    return result;
+}
+
+} // namespace
+
+
+TEST_CASE("chunked body writer sends a chunk per write", "[chunked_body_writer]") {
+    connection_t connection;
+    writer_t writer(connection.server);
+
+    const std::string hello = "hello";
+    const std::string comma = ", ";
+    const std::string world = "world!";
+    const std::vector<boost::asio::const_buffer> gathered = {
+        boost::asio::buffer(comma),
+        boost::asio::const_buffer(),
+        boost::asio::buffer(world)
+    };
+
+    SECTION("synchronously") {
+        REQUIRE(writer.write(boost::asio::buffer(hello)) == 5);
+        REQUIRE(connection.received() == "5\r\nhello\r\n");
+
+        // Empty buffers are skipped, a write without data sends nothing, since an empty chunk would end the body.
+        REQUIRE(writer.write(gathered) == 8);
+        REQUIRE(writer.write(boost::asio::buffer(hello, 0)) == 0);
+        REQUIRE(connection.received() == "8\r\n, world!\r\n");
+
+        REQUIRE(writer.finish() == 0);
+        REQUIRE(connection.received() == "0\r\n\r\n");
+    }
+
+    SECTION("asynchronously") {
+        std::vector<std::size_t> taken;
+
+        auto on_write = [&](boost::system::error_code ec, std::size_t transferred) {
+            REQUIRE(!ec);
+            taken.push_back(transferred);
+        };
+
+        writer.async_write(boost::asio::buffer(hello), [&](boost::system::error_code ec, std::size_t transferred) {
+            on_write(ec, transferred);
+
+            writer.async_write(gathered, [&](boost::system::error_code ec, std::size_t transferred) {
+                on_write(ec, transferred);
+
+                writer.async_write(boost::asio::buffer(hello, 0), [&](boost::system::error_code ec, std::size_t n) {
+                    on_write(ec, n);
+                    writer.async_finish(on_write);
+                });
+            });
+        });
+
+        connection.io_service.run();
+
+        REQUIRE(taken == (std::vector<std::size_t> {5, 8, 0, 0}));
+        REQUIRE(connection.received() == "5\r\nhello\r\n8\r\n, world!\r\n0\r\n\r\n");
+    }
+}
+
+
+TEST_CASE("chunked body writer coalesces small writes", "[chunked_body_writer]") {
+    connection_t connection;
+    writer_t writer(connection.server, 16);
+
+    SECTION("synchronously") {
+        // Below the threshold, so kept in the writer.
+        REQUIRE(writer.write(boost::asio::buffer("abc", 3)) == 3);
+        REQUIRE(writer.write(boost::asio::buffer("defg", 4)) == 4);
+        REQUIRE(connection.received().empty());
+
+        // Reaches the threshold, so the collected data goes out as a single chunk.
+        REQUIRE(writer.write(boost::asio::buffer("hijklmnop", 9)) == 9);
+        REQUIRE(connection.received() == "10\r\nabcdefghijklmnop\r\n");
+
+        // A big write sends the collected data first, then its own chunk, in one gathering write.
+        REQUIRE(writer.write(boost::asio::buffer("qr", 2)) == 2);
+        REQUIRE(writer.write(boost::asio::buffer(std::string(20, 'x'))) == 20);
+        REQUIRE(connection.received() == "2\r\nqr\r\n14\r\n" + std::string(20, 'x') + "\r\n");
+
+        // flush() sends what's collected, and nothing if there's nothing.
+        REQUIRE(writer.write(boost::asio::buffer("st", 2)) == 2);
+        REQUIRE(writer.flush() == 2);
+        REQUIRE(connection.received() == "2\r\nst\r\n");
+        REQUIRE(writer.flush() == 0);
+        REQUIRE(connection.received().empty());
+
+        // finish() sends what's collected before the last chunk.
+        REQUIRE(writer.write(boost::asio::buffer("uv", 2)) == 2);
+        REQUIRE(writer.finish() == 2);
+        REQUIRE(connection.received() == "2\r\nuv\r\n0\r\n\r\n");
+    }
+
+    SECTION("asynchronously") {
+        std::vector<std::string> sent;
+
+        auto expect = [&](std::size_t expected) {
+            return [&, expected](boost::system::error_code ec, std::size_t transferred) {
+                REQUIRE(!ec);
+                REQUIRE(transferred == expected);
+                sent.push_back(connection.received());
+            };
+        };
+
+        writer.async_write(boost::asio::buffer("abc", 3), [&](boost::system::error_code ec, std::size_t transferred) {
+            expect(3)(ec, transferred);
+
+            writer.async_flush([&](boost::system::error_code ec, std::size_t transferred) {
+                expect(3)(ec, transferred);
+
+                writer.async_flush([&](boost::system::error_code ec, std::size_t transferred) {
+                    expect(0)(ec, transferred);
+
+                    writer.async_write(boost::asio::buffer("de", 2), [&](boost::system::error_code ec,
+                                                                         std::size_t transferred)
+                    {
+                        expect(2)(ec, transferred);
+                        writer.async_finish(expect(2));
+                    });
+                });
+            });
+        });
+
+        connection.io_service.run();
+
+        REQUIRE(sent == (std::vector<std::string> {"", "3\r\nabc\r\n", "", "", "2\r\nde\r\n0\r\n\r\n"}));
+    }
+}
+
+
+TEST_CASE("chunked body writer finishes the body with trailers", "[chunked_body_writer]") {
+    connection_t connection;
+    writer_t writer(connection.server, 8);
+
+    httplib::http_headers_t trailers;
+    trailers.set_header("Checksum", {"abc123"});
+    trailers.set_header("Expires", {"never"});
+
+    SECTION("synchronously") {
+        writer.write(boost::asio::buffer(std::string("first chunk, ")));
+        writer.write(boost::asio::buffer(std::string("small")));
+
+        REQUIRE(writer.finish(trailers) == 5);
+    }
+
+    SECTION("asynchronously") {
+        bool finished = false;
+
+        writer.async_write(boost::asio::buffer(std::string("first chunk, ")), [&](auto ec, std::size_t) {
+            REQUIRE(!ec);
+
+            writer.async_write(boost::asio::buffer(std::string("small")), [&](auto ec, std::size_t) {
+                REQUIRE(!ec);
+
+                writer.async_finish(trailers, [&](auto ec, std::size_t transferred) {
+                    REQUIRE(!ec);
+                    REQUIRE(transferred == 5);
+                    finished = true;
+                });
+            });
+        });
+
+        connection.io_service.run();
+
+        REQUIRE(finished);
+    }
+
+    auto body = read_back(connection.received());
+
+    REQUIRE(body.data == "first chunk, small");
+    REQUIRE(body.trailers.get_header("Checksum"));
+    REQUIRE(*body.trailers.get_header("Checksum") == "abc123");
+    REQUIRE(body.trailers.get_header("Expires"));
+    REQUIRE(*body.trailers.get_header("Expires") == "never");
+}
+
+
+TEST_CASE("chunked body writer reports write errors", "[chunked_body_writer]") {
+    connection_t connection;
+    writer_t writer(connection.server);
+    connection.client.close();
+
+    boost::system::error_code ec;
+
+    REQUIRE(writer.write(boost::asio::buffer(std::string("lost")), ec) == 0);
+    REQUIRE(ec == boost::asio::error::broken_pipe);
+    REQUIRE_THROWS_AS(writer.finish(), boost::system::system_error);
+}
@@ -0,0 +1,417 @@
+#include <catch.hpp>
+
+#include <httplib/asio/client.hpp>
+#include <httplib/asio/server.hpp>
+#include <httplib/error.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+using tcp = boost::asio::ip::tcp;
+
+
+tcp::endpoint loopback() {
+    return tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0);
+}
+
+
+httplib::http_request_t make_request(const std::string &method, const std::string &target) {
+    httplib::http_request_t request;
+    request.method = method;
+    request.target = target;
+    request.version = {1, 1};
+    return request;
+}
+
+
+// Echoes the method, the target and the body. /close closes the connection, /big answers with a big body.
+class echo_server_t {
+public:
+    echo_server_t() :
+        m_server(&echo, options())
+    {
+        m_server.start(loopback());
+    }
+
+    ~echo_server_t() {
+        m_server.stop();
+        m_server.join();
+    }
+
+    tcp::endpoint endpoint() const {
+        return m_server.local_endpoint();
+    }
+
+private:
+    static httplib::server_options_t options() {
+        httplib::server_options_t result;
+        result.threads = 1;
+        result.pin_threads = false;
+        return result;
+    }
+
+    static void echo(const httplib::http_request_t &request,
+                     const std::string &body,
+                     httplib::server_response_t &response)
+    {
+        if (request.target == "/close") {
+            response.builder.connection_close();
+        } else if (request.target == "/big") {
+            response.body = std::string(1000, 'x');
+            return;
+        }
+
+        response.body = request.method + " " + request.target + ": " + body;
+    }
+
+private:
+    httplib::server_t m_server;
+};
+
+
+// Accepts the connections one after another in its own thread and passes each one to the script,
+// along with its number.
+class scripted_server_t {
+public:
+    using script_t = std::function<void(std::size_t connection, tcp::socket &socket)>;
+
+    scripted_server_t(std::size_t connections, script_t script) :
+        m_acceptor(m_io_service, loopback())
+    {
+        m_thread = std::thread([this, connections, script] {
+            for (std::size_t i = 0; i < connections; ++i) {
+                tcp::socket socket(m_io_service);
+                boost::system::error_code ec;
+                m_acceptor.accept(socket, ec);
+
+                if (ec) {
+                    return;
+                }
+
+                script(i, socket);
+            }
+        });
+    }
+
+    ~scripted_server_t() {
+        m_thread.join();
+    }
+
+    tcp::endpoint endpoint() const {
+        return m_acceptor.local_endpoint();
+    }
+
+private:
+    boost::asio::io_service m_io_service;
+    tcp::acceptor m_acceptor;
+    std::thread m_thread;
+};
+
+
+// Reads a request head, ignoring the body.
+void read_head(tcp::socket &socket, boost::asio::streambuf &buffer) {
+    std::size_t size = boost::asio::read_until(socket, buffer, "\r\n\r\n");
+    buffer.consume(size);
+}
+
+
+void write_ok(tcp::socket &socket, const std::string &body) {
+    boost::asio::write(socket, boost::asio::buffer(
+        "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body
+    ));
+}
+
+
+// Runs the handlers until the condition holds or the io_service runs out of work.
+template<class Condition>
+void run_until(boost::asio::io_service &io_service, Condition condition) {
+    io_service.reset();
+
+    while (!condition() && io_service.run_one() > 0) { }
+}
+
+
+// The body of the response or the error.
+std::string describe(boost::system::error_code ec, const httplib::http_client_response_t &response) {
+    return ec ? "error: " + ec.message() : response.body;
+}
+
+} // namespace
+
+
+TEST_CASE("client reuses keep-alive connections", "[http_client_t]") {
+    echo_server_t server;
+    boost::asio::io_service io_service;
+    httplib::http_client_t client(io_service);
+
+    std::vector<std::string> bodies;
+
+    std::function<void(std::size_t)> request;
+    request = [&](std::size_t i) {
+        if (i == 5) {
+            return;
+        }
+
+        client.async_request(server.endpoint(), make_request("GET", "/" + std::to_string(i)),
+                             [&, i](auto ec, const httplib::http_client_response_t &response) {
+            bodies.push_back(describe(ec, response));
+            request(i + 1);
+        });
+    };
+
+    request(0);
+    run_until(io_service, [&] { return bodies.size() == 5; });
+
+    REQUIRE(bodies == (std::vector<std::string> {"GET /0: ", "GET /1: ", "GET /2: ", "GET /3: ", "GET /4: "}));
+
+    auto metrics = client.metrics(server.endpoint());
+
+    REQUIRE(metrics.connections_opened == 1);
+    REQUIRE(metrics.requests == 5);
+    REQUIRE(metrics.responses == 5);
+    REQUIRE(metrics.reused == 4);
+    REQUIRE(metrics.idle_connections == 1);
+}
+
+
+TEST_CASE("client closes connections with Connection: close", "[http_client_t]") {
+    echo_server_t server;
+    boost::asio::io_service io_service;
+    httplib::http_client_t client(io_service);
+
+    std::vector<std::string> bodies;
+
+    auto on_response = [&](auto ec, const httplib::http_client_response_t &response) {
+        bodies.push_back(describe(ec, response));
+    };
+
+    SECTION("in the request") {
+        auto first = make_request("GET", "/first");
+        first.headers.set_header("Connection", {"close"});
+
+        client.async_request(server.endpoint(), first, [&](auto ec, const httplib::http_client_response_t &response) {
+            on_response(ec, response);
+            client.async_request(server.endpoint(), make_request("GET", "/second"), on_response);
+        });
+
+        run_until(io_service, [&] { return bodies.size() == 2; });
+
+        REQUIRE(bodies == (std::vector<std::string> {"GET /first: ", "GET /second: "}));
+    }
+
+    SECTION("in the response") {
+        client.async_request(server.endpoint(), make_request("GET", "/close"),
+                             [&](auto ec, const httplib::http_client_response_t &response) {
+            on_response(ec, response);
+            client.async_request(server.endpoint(), make_request("GET", "/second"), on_response);
+        });
+
+        run_until(io_service, [&] { return bodies.size() == 2; });
+
+        REQUIRE(bodies == (std::vector<std::string> {"GET /close: ", "GET /second: "}));
+    }
+
+    auto metrics = client.metrics();
+
+    REQUIRE(metrics.connections_opened == 2);
+    REQUIRE(metrics.connections_closed == 1);
+    REQUIRE(metrics.reused == 0);
+}
+
+
+TEST_CASE("client keeps the order of pipelined responses", "[http_client_t]") {
+    echo_server_t server;
+    boost::asio::io_service io_service;
+
+    httplib::http_client_options_t options;
+    options.max_connections_per_host = 1;
+    options.max_pipelined_requests = 8;
+
+    httplib::http_client_t client(io_service, options);
+
+    std::vector<std::string> bodies;
+    std::vector<std::string> expected;
+
+    // The first response confirms that the connection is kept alive, the rest are pipelined.
+    client.async_request(server.endpoint(), make_request("GET", "/first"), [&](auto ec, const auto &) {
+        REQUIRE(!ec);
+
+        for (int i = 0; i < 20; ++i) {
+            auto target = "/" + std::to_string(i);
+            expected.push_back("GET " + target + ": ");
+
+            client.async_request(server.endpoint(), make_request("GET", target),
+                                 [&](auto ec, const httplib::http_client_response_t &response) {
+                bodies.push_back(describe(ec, response));
+            });
+        }
+    });
+
+    run_until(io_service, [&] { return bodies.size() == 20; });
+
+    REQUIRE(bodies == expected);
+
+    auto metrics = client.metrics();
+
+    REQUIRE(metrics.connections_opened == 1);
+    REQUIRE(metrics.pipelined > 0);
+    REQUIRE(metrics.responses == 21);
+}
+
+
+TEST_CASE("client retries an idempotent request once on a dropped connection", "[http_client_t]") {
+    // The first connection answers a request and is then closed by the server while the next request arrives,
+    // e.g. by its keep-alive timeout.
+    scripted_server_t server(2, [](std::size_t connection, tcp::socket &socket) {
+        boost::asio::streambuf buffer;
+
+        if (connection == 0) {
+            read_head(socket, buffer);
+            write_ok(socket, "first");
+            read_head(socket, buffer);
+        } else {
+            read_head(socket, buffer);
+            write_ok(socket, "retried");
+        }
+    });
+
+    boost::asio::io_service io_service;
+    httplib::http_client_t client(io_service);
+
+    std::vector<std::string> bodies;
+
+    client.async_request(server.endpoint(), make_request("GET", "/"),
+                         [&](auto ec, const httplib::http_client_response_t &response) {
+        bodies.push_back(describe(ec, response));
+
+        client.async_request(server.endpoint(), make_request("GET", "/"),
+                             [&](auto ec, const httplib::http_client_response_t &response) {
+            bodies.push_back(describe(ec, response));
+        });
+    });
+
+    run_until(io_service, [&] { return bodies.size() == 2; });
+
+    REQUIRE(bodies == (std::vector<std::string> {"first", "retried"}));
+
+    auto metrics = client.metrics();
+
+    REQUIRE(metrics.connections_opened == 2);
+    REQUIRE(metrics.retried == 1);
+    REQUIRE(metrics.errors == 0);
+}
+
+
+TEST_CASE("client doesn't retry a POST on a dropped connection", "[http_client_t]") {
+    scripted_server_t server(1, [](std::size_t, tcp::socket &socket) {
+        boost::asio::streambuf buffer;
+
+        read_head(socket, buffer);
+        write_ok(socket, "first");
+        read_head(socket, buffer);
+    });
+
+    boost::asio::io_service io_service;
+    httplib::http_client_t client(io_service);
+
+    std::string first;
+    boost::system::error_code error;
+    bool completed = false;
+
+    client.async_request(server.endpoint(), make_request("GET", "/"),
+                         [&](auto ec, const httplib::http_client_response_t &response) {
+        first = describe(ec, response);
+
+        client.async_request(server.endpoint(), make_request("POST", "/"), "body", [&](auto ec, const auto &) {
+            error = ec;
+            completed = true;
+        });
+    });
+
+    run_until(io_service, [&] { return completed; });
+
+    REQUIRE(completed);
+    REQUIRE(first == "first");
+    REQUIRE(error);
+
+    auto metrics = client.metrics();
+
+    REQUIRE(metrics.connections_opened == 1);
+    REQUIRE(metrics.retried == 0);
+    REQUIRE(metrics.errors == 1);
+}
+
+
+TEST_CASE("client fails a response over max_body_size", "[http_client_t]") {
+    echo_server_t server;
+    boost::asio::io_service io_service;
+
+    httplib::http_client_options_t options;
+    options.max_body_size = 100;
+
+    httplib::http_client_t client(io_service, options);
+
+    boost::system::error_code error;
+    bool completed = false;
+
+    client.async_request(server.endpoint(), make_request("GET", "/big"), [&](auto ec, const auto &) {
+        error = ec;
+        completed = true;
+    });
+
+    run_until(io_service, [&] { return completed; });
+
+    REQUIRE(error == httplib::client_errc_t::body_too_large);
+    REQUIRE(client.metrics().errors == 1);
+    REQUIRE(client.metrics().active_connections == 0);
+}
+
+
+TEST_CASE("client aborts the requests in progress on close", "[http_client_t]") {
+    echo_server_t server;
+    boost::asio::io_service io_service;
+
+    httplib::http_client_options_t options;
+    options.max_connections_per_host = 1;
+
+    httplib::http_client_t client(io_service, options);
+
+    std::vector<boost::system::error_code> errors;
+
+    for (int i = 0; i < 3; ++i) {
+        client.async_request(server.endpoint(), make_request("GET", "/"), [&](auto ec, const auto &) {
+            errors.push_back(ec);
+        });
+    }
+
+    // One request is being sent, the others wait for the connection.
+    REQUIRE(client.metrics().queued_requests == 2);
+
+    client.close();
+    run_until(io_service, [&] { return errors.size() == 3; });
+
+    REQUIRE(errors == (std::vector<boost::system::error_code>(3, boost::asio::error::operation_aborted)));
+
+    // The client may be used again.
+    std::string body;
+
+    client.async_request(server.endpoint(), make_request("GET", "/again"),
+                         [&](auto ec, const httplib::http_client_response_t &response) {
+        body = describe(ec, response);
+    });
+
+    run_until(io_service, [&] { return !body.empty(); });
+
+    REQUIRE(body == "GET /again: ");
+}
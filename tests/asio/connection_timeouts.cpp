@@ -0,0 +1,271 @@
+#include <catch.hpp>
+
+#include <httplib/asio/bound_body_reader.hpp>
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/chunked_body_reader.hpp>
+#include <httplib/asio/connection_timeouts.hpp>
+#include <httplib/asio/read_request.hpp>
+#include <httplib/asio/timer_wheel.hpp>
+#include <httplib/error.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+
+
+namespace {
+
+using milliseconds = std::chrono::milliseconds;
+using socket_t = boost::asio::local::stream_protocol::socket;
+using stream_t = httplib::buffered_read_stream<socket_t &, boost::asio::streambuf &>;
+
+
+// A connection read by the server side with the timeouts, which close the server socket on expiry,
+// as server_t does.
+struct connection_t {
+    boost::asio::io_service io_service;
+    httplib::timer_wheel_t wheel{io_service, milliseconds(1)};
+    socket_t client{io_service};
+    socket_t server{io_service};
+    boost::asio::streambuf buffer;
+    stream_t stream{server, buffer};
+    httplib::connection_timeouts_t timeouts;
+    httplib::read_options_t read_options;
+
+    explicit connection_t(httplib::connection_timeout_options_t options) :
+        timeouts(wheel, options, [this] { server.close(); })
+    {
+        boost::asio::local::connect_pair(client, server);
+        read_options.timeouts = &timeouts;
+    }
+
+    void send(const std::string &data) {
+        boost::asio::write(client, boost::asio::buffer(data));
+    }
+
+    // Sends the data a byte per period until it ends or the server closes the connection.
+    void trickle(std::string data, milliseconds period) {
+        auto timer = std::make_shared<boost::asio::steady_timer>(io_service);
+        auto next = std::make_shared<std::function<void(std::size_t)>>();
+
+        *next = [this, data, period, timer, next](std::size_t position) {
+            boost::system::error_code ec;
+
+            if (position < data.size()) {
+                boost::asio::write(client, boost::asio::buffer(&data[position], 1), ec);
+            }
+
+            if (position == data.size() || ec) {
+                // Breaks the cycle of the pointers.
+                io_service.post([next] { *next = nullptr; });
+                return;
+            }
+
+            timer->expires_from_now(period);
+            timer->async_wait([next, position](boost::system::error_code) {
+                (*next)(position + 1);
+            });
+        };
+
+        (*next)(0);
+    }
+
+    // Runs the io_service for the duration, so any armed timeout may expire.
+    void run_for(milliseconds duration) {
+        boost::asio::steady_timer timer(io_service, duration);
+        timer.async_wait([](boost::system::error_code) { });
+        io_service.reset();
+        io_service.run();
+    }
+};
+
+
+// Reads the body with async_read_some() until an error, which is returned.
+template<class Reader>
+boost::system::error_code async_read_all(Reader &reader, std::size_t &total) {
+    boost::system::error_code result;
+    char part[64];
+
+    std::function<void()> read;
+    read = [&] {
+        reader.async_read_some(boost::asio::buffer(part), [&](boost::system::error_code ec, std::size_t transferred) {
+            total += transferred;
+
+            if (ec) {
+                result = ec;
+            } else {
+                read();
+            }
+        });
+    };
+
+    read();
+    reader.get_io_service().run();
+
+    return result;
+}
+
+
+httplib::connection_timeout_options_t no_timeouts() {
+    httplib::connection_timeout_options_t options;
+    options.idle = milliseconds(0);
+    options.head = milliseconds(0);
+    options.min_body_rate = 0;
+    return options;
+}
+
+} // namespace
+
+
+TEST_CASE("connection timeouts close an idle connection", "[connection_timeouts_t]") {
+    auto options = no_timeouts();
+    options.idle = milliseconds(30);
+    connection_t connection(options);
+
+    boost::system::error_code error;
+    bool completed = false;
+
+    auto start = std::chrono::steady_clock::now();
+
+    httplib::async_read_request(connection.stream, connection.read_options, [&](auto ec, const auto &) {
+        error = ec;
+        completed = true;
+    });
+
+    connection.io_service.run();
+
+    REQUIRE(completed);
+    REQUIRE(error == boost::asio::error::timed_out);
+    REQUIRE(std::chrono::steady_clock::now() - start >= milliseconds(30));
+    REQUIRE(connection.timeouts.expired());
+    REQUIRE(!connection.server.is_open());
+}
+
+
+TEST_CASE("connection timeouts close a connection whose head trickles in", "[connection_timeouts_t]") {
+    // The head keeps arriving, a byte every 5 ms, but takes longer than the head timeout.
+    // The idle timeout no longer applies once the first byte arrives.
+    auto options = no_timeouts();
+    options.idle = milliseconds(30);
+    options.head = milliseconds(60);
+    connection_t connection(options);
+
+    boost::system::error_code error;
+    bool completed = false;
+
+    auto start = std::chrono::steady_clock::now();
+
+    httplib::async_read_request(connection.stream, connection.read_options, [&](auto ec, const auto &) {
+        error = ec;
+        completed = true;
+    });
+
+    connection.trickle("GET / HTTP/1.1\r\nHost: localhost\r\nX-Slow: " + std::string(1000, 'x') + "\r\n\r\n",
+                       milliseconds(5));
+
+    connection.io_service.run();
+
+    REQUIRE(completed);
+    REQUIRE(error == boost::asio::error::timed_out);
+    REQUIRE(std::chrono::steady_clock::now() - start >= milliseconds(60));
+    REQUIRE(!connection.server.is_open());
+}
+
+
+TEST_CASE("connection timeouts close a connection whose body is too slow", "[connection_timeouts_t]") {
+    // 20 bytes per 20 ms are required, a byte every 5 ms arrives.
+    auto options = no_timeouts();
+    options.min_body_rate = 1000;
+    options.body_rate_interval = milliseconds(20);
+    connection_t connection(options);
+
+    boost::system::error_code error;
+    std::size_t total = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    SECTION("with Content-Length") {
+        httplib::bound_body_reader<stream_t> reader(connection.stream, 1000, connection.read_options);
+        connection.trickle(std::string(1000, 'x'), milliseconds(5));
+
+        error = async_read_all(reader, total);
+    }
+
+    SECTION("chunked") {
+        connection.send("3e8\r\n");
+
+        httplib::chunked_body_reader<stream_t> reader(connection.stream, connection.read_options);
+        connection.trickle(std::string(1000, 'x'), milliseconds(5));
+
+        error = async_read_all(reader, total);
+    }
+
+    REQUIRE(error == boost::asio::error::timed_out);
+    REQUIRE(total < 1000);
+    REQUIRE(std::chrono::steady_clock::now() - start >= milliseconds(20));
+    REQUIRE(!connection.server.is_open());
+}
+
+
+TEST_CASE("connection timeouts are disarmed when the message is read", "[connection_timeouts_t]") {
+    auto options = no_timeouts();
+    options.idle = milliseconds(20);
+    options.head = milliseconds(20);
+    options.min_body_rate = 1000;
+    options.body_rate_interval = milliseconds(20);
+    connection_t connection(options);
+
+    connection.send("POST / HTTP/1.1\r\nHost: localhost\r\n\r\n");
+
+    std::string target;
+
+    httplib::async_read_request(connection.stream, connection.read_options, [&](auto ec, const auto &request) {
+        REQUIRE(!ec);
+        target = request.target;
+    });
+
+    connection.io_service.run();
+
+    REQUIRE(target == "/");
+    REQUIRE(connection.wheel.armed() == 0);
+
+    SECTION("with Content-Length") {
+        connection.send("hello");
+
+        httplib::bound_body_reader<stream_t> reader(connection.stream, 5, connection.read_options);
+        std::size_t total = 0;
+
+        connection.io_service.reset();
+
+        REQUIRE(async_read_all(reader, total) == httplib::reader_errc_t::eof);
+        REQUIRE(total == 5);
+    }
+
+    SECTION("chunked") {
+        connection.send("5\r\nhello\r\n0\r\n\r\n");
+
+        httplib::chunked_body_reader<stream_t> reader(connection.stream, connection.read_options);
+        std::size_t total = 0;
+
+        connection.io_service.reset();
+
+        REQUIRE(async_read_all(reader, total) == httplib::reader_errc_t::eof);
+        REQUIRE(total == 5);
+    }
+
+    REQUIRE(connection.wheel.armed() == 0);
+
+    // Longer than every timeout, nothing expires.
+    connection.run_for(milliseconds(60));
+
+    REQUIRE(!connection.timeouts.expired());
+    REQUIRE(connection.server.is_open());
+}
@@ -0,0 +1,103 @@
+#include <catch.hpp>
+
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/eof_body_reader.hpp>
+#include <httplib/error.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <functional>
+#include <string>
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+using stream_t = httplib::buffered_read_stream<socket_t &, boost::asio::streambuf &>;
+using reader_t = httplib::eof_body_reader<stream_t>;
+
+
+struct connection_t {
+    boost::asio::io_service io_service;
+    socket_t client{io_service};
+    socket_t server{io_service};
+    boost::asio::streambuf buffer;
+    stream_t stream{server, buffer};
+
+    connection_t() {
+        boost::asio::local::connect_pair(client, server);
+    }
+};
+
+} // namespace
+
+
+TEST_CASE("eof body reader reads directly into big buffers until the end of the stream", "[eof_body_reader]") {
+    connection_t connection;
+
+    std::string body;
+
+    for (int i = 0; i < 100; ++i) {
+        body += std::to_string(i) + " ";
+    }
+
+    boost::asio::write(connection.client, boost::asio::buffer(body));
+    connection.client.close();
+
+    // Smaller than the caller's buffers, so the reader reads right into them.
+    httplib::read_options_t options;
+    options.read_buffer_size = 64;
+    options.max_read_buffer_size = 64;
+
+    reader_t reader(connection.stream, options);
+
+    std::string read;
+    char part[1024];
+
+    SECTION("synchronously") {
+        while (true) {
+            boost::system::error_code ec;
+            std::size_t transferred = reader.read_some(boost::asio::buffer(part), ec);
+            read.append(part, transferred);
+
+            // Nothing goes through the stream's buffer.
+            REQUIRE(connection.buffer.size() == 0);
+
+            if (ec == httplib::reader_errc_t::eof) {
+                break;
+            }
+
+            REQUIRE(!ec);
+        }
+    }
+
+    SECTION("asynchronously") {
+        bool eof = false;
+
+        std::function<void()> read_some;
+        read_some = [&] {
+            reader.async_read_some(boost::asio::buffer(part), [&](boost::system::error_code ec, std::size_t transferred) {
+                read.append(part, transferred);
+                REQUIRE(connection.buffer.size() == 0);
+
+                if (ec == httplib::reader_errc_t::eof) {
+                    eof = true;
+                } else {
+                    REQUIRE(!ec);
+                    read_some();
+                }
+            });
+        };
+
+        read_some();
+        connection.io_service.run();
+
+        REQUIRE(eof);
+    }
+
+    REQUIRE(read == body);
+}
@@ -0,0 +1,334 @@
+#include <catch.hpp>
+
+#include <httplib/asio/erased_handler.hpp>
+
+#include <boost/asio/handler_alloc_hook.hpp>
+#include <boost/asio/handler_continuation_hook.hpp>
+#include <boost/asio/handler_invoke_hook.hpp>
+#include <boost/asio/io_service.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+
+
+namespace {
+
+struct counters_t {
+    // The handlers constructed and not yet destroyed.
+    int alive = 0;
+    int copied = 0;
+    int moved = 0;
+    int called = 0;
+
+    // The handler called last.
+    const void *called_handler = nullptr;
+
+    int allocated = 0;
+    int deallocated = 0;
+    int invoked = 0;
+    bool continuation = false;
+};
+
+
+// Counts its copies and the calls of its hooks. Size and Align control whether erased_handler stores it inline.
+template<std::size_t Size, std::size_t Align = alignof(void *)>
+struct alignas(Align) counting_handler_t {
+    counters_t *counters;
+    char padding[Size];
+
+    explicit counting_handler_t(counters_t &counters) :
+        counters(&counters)
+    {
+        ++counters.alive;
+    }
+
+    counting_handler_t(const counting_handler_t &other) noexcept :
+        counters(other.counters)
+    {
+        ++counters->alive;
+        ++counters->copied;
+    }
+
+    counting_handler_t(counting_handler_t &&other) noexcept :
+        counters(other.counters)
+    {
+        ++counters->alive;
+        ++counters->moved;
+    }
+
+    ~counting_handler_t() {
+        --counters->alive;
+    }
+
+    std::string operator()(int value, std::string suffix) {
+        ++counters->called;
+        counters->called_handler = this;
+        return std::to_string(value) + suffix;
+    }
+
+    void operator()() {
+        ++counters->called;
+        counters->called_handler = this;
+    }
+
+    friend void *asio_handler_allocate(std::size_t size, counting_handler_t *context) {
+        ++context->counters->allocated;
+        return ::operator new(size);
+    }
+
+    friend void asio_handler_deallocate(void *pointer, std::size_t, counting_handler_t *context) {
+        ++context->counters->deallocated;
+        ::operator delete(pointer);
+    }
+
+    friend bool asio_handler_is_continuation(counting_handler_t *context) {
+        return context->counters->continuation;
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(Callable &function, counting_handler_t *context) {
+        ++context->counters->invoked;
+        function();
+    }
+
+    template<class Callable>
+    friend void asio_handler_invoke(const Callable &function, counting_handler_t *context) {
+        ++context->counters->invoked;
+        Callable copy(function);
+        copy();
+    }
+};
+
+
+using erased_t = httplib::erased_handler<std::string(int, std::string)>;
+
+using small_handler_t = counting_handler_t<8>;
+using big_handler_t = counting_handler_t<erased_t::inline_size>;
+using over_aligned_handler_t = counting_handler_t<8, 2 * alignof(std::max_align_t)>;
+
+
+struct throwing_move_t {
+    throwing_move_t() = default;
+    throwing_move_t(const throwing_move_t &) = default;
+    throwing_move_t(throwing_move_t &&) { }
+
+    std::string operator()(int, std::string) {
+        return std::string();
+    }
+};
+
+
+static_assert(erased_t::is_stored_inline<small_handler_t>(), "a small handler must be stored inline");
+static_assert(!erased_t::is_stored_inline<big_handler_t>(), "a handler bigger than the buffer must be on the heap");
+static_assert(!erased_t::is_stored_inline<over_aligned_handler_t>(), "an over-aligned handler must be on the heap");
+static_assert(!erased_t::is_stored_inline<throwing_move_t>(), "a handler with a throwing move must be on the heap");
+
+
+// Whether the erased handler keeps the wrapped handler within its own bytes.
+bool stored_inline(erased_t &erased, const counters_t &counters) {
+    erased(0, "");
+
+    auto begin = reinterpret_cast<const char *>(&erased);
+    auto handler = static_cast<const char *>(counters.called_handler);
+
+    return handler >= begin && handler < begin + sizeof(erased);
+}
+
+
+template<class Handler>
+void check_copy_and_move() {
+    counters_t counters;
+
+    {
+        erased_t erased{Handler(counters)};
+
+        // The temporary is gone, only the stored one is left.
+        REQUIRE(counters.alive == 1);
+
+        erased_t copy(erased);
+
+        REQUIRE(counters.alive == 2);
+        REQUIRE(counters.copied == 1);
+
+        int moved_before = counters.moved;
+        erased_t moved(std::move(copy));
+
+        // Moving an inline handler moves the handler itself, moving a heap one moves only the pointer.
+        REQUIRE(counters.alive == 2);
+        REQUIRE(counters.moved == moved_before + (erased_t::is_stored_inline<Handler>() ? 1 : 0));
+
+        erased_t assigned{Handler(counters)};
+        REQUIRE(counters.alive == 3);
+
+        assigned = erased;
+        REQUIRE(counters.alive == 3);
+        REQUIRE(counters.copied == 2);
+
+        assigned = std::move(moved);
+        REQUIRE(counters.alive == 2);
+
+        // A moved-from handler may be assigned to again.
+        moved = erased;
+        REQUIRE(counters.alive == 3);
+
+        REQUIRE(erased(1, "a") == "1a");
+        REQUIRE(assigned(2, "b") == "2b");
+        REQUIRE(moved(3, "c") == "3c");
+        REQUIRE(counters.called == 3);
+    }
+
+    // Every handler is destroyed, and only once.
+    REQUIRE(counters.alive == 0);
+}
+
+
+template<class Handler>
+void check_hooks() {
+    counters_t counters;
+    erased_t erased{Handler(counters)};
+
+    using boost::asio::asio_handler_allocate;
+    using boost::asio::asio_handler_deallocate;
+    using boost::asio::asio_handler_is_continuation;
+    using boost::asio::asio_handler_invoke;
+
+    void *pointer = asio_handler_allocate(64, &erased);
+    REQUIRE(counters.allocated == 1);
+
+    asio_handler_deallocate(pointer, 64, &erased);
+    REQUIRE(counters.deallocated == 1);
+
+    REQUIRE(!asio_handler_is_continuation(&erased));
+    counters.continuation = true;
+    REQUIRE(asio_handler_is_continuation(&erased));
+
+    int calls = 0;
+    auto function = [&calls] { ++calls; };
+    const auto const_function = function;
+
+    asio_handler_invoke(function, &erased);
+    asio_handler_invoke(const_function, &erased);
+
+    REQUIRE(counters.invoked == 2);
+    REQUIRE(calls == 2);
+
+    // The io_service goes through the hooks too.
+    boost::asio::io_service io_service;
+    io_service.post(httplib::erased_handler<void()>(Handler(counters)));
+
+    REQUIRE(counters.allocated == 2);
+
+    io_service.run();
+
+    REQUIRE(counters.called == 1);
+    REQUIRE(counters.invoked == 3);
+    REQUIRE(counters.deallocated == 2);
+}
+
+} // namespace
+
+
+TEST_CASE("erased handler calls the wrapped handler", "[erased_handler]") {
+    httplib::erased_handler<int(int, int)> sum = [](int a, int b) { return a + b; };
+
+    REQUIRE(sum(2, 3) == 5);
+
+    // The arguments are forwarded, a move-only one too.
+    httplib::erased_handler<std::size_t(std::unique_ptr<std::string>)> size = [](std::unique_ptr<std::string> s) {
+        return s->size();
+    };
+
+    REQUIRE(size(std::make_unique<std::string>("four")) == 4);
+}
+
+
+TEST_CASE("erased handler stores small handlers inline and big ones on the heap", "[erased_handler]") {
+    counters_t counters;
+
+    erased_t small{small_handler_t(counters)};
+    erased_t big{big_handler_t(counters)};
+    erased_t over_aligned{over_aligned_handler_t(counters)};
+
+    REQUIRE(stored_inline(small, counters));
+    REQUIRE(!stored_inline(big, counters));
+    REQUIRE(!stored_inline(over_aligned, counters));
+
+    // An over-aligned handler is aligned on the heap.
+    REQUIRE(reinterpret_cast<std::uintptr_t>(counters.called_handler) % alignof(over_aligned_handler_t) == 0);
+}
+
+
+TEST_CASE("erased handler copies, moves and destroys the wrapped handler", "[erased_handler]") {
+    SECTION("inline") {
+        check_copy_and_move<small_handler_t>();
+    }
+
+    SECTION("on the heap") {
+        check_copy_and_move<big_handler_t>();
+    }
+
+    SECTION("over-aligned") {
+        check_copy_and_move<over_aligned_handler_t>();
+    }
+}
+
+
+TEST_CASE("erased handler forwards the asio hooks", "[erased_handler]") {
+    SECTION("inline") {
+        check_hooks<small_handler_t>();
+    }
+
+    SECTION("on the heap") {
+        check_hooks<big_handler_t>();
+    }
+}
+
+
+TEST_CASE("erased function refers to the function until copied", "[erased_handler]") {
+    counters_t counters;
+    small_handler_t handler(counters);
+
+    int calls = 0;
+    auto function = [&calls, handler] { ++calls; };
+
+    REQUIRE(counters.alive == 2);
+
+    {
+        httplib::detail::erased_function_t erased(function);
+
+        // Calls the original.
+        erased();
+        REQUIRE(calls == 1);
+        REQUIRE(counters.alive == 2);
+
+        // The copy owns a copy of the original, e.g. for a strand which runs it later.
+        httplib::detail::erased_function_t copy(erased);
+        REQUIRE(counters.alive == 3);
+
+        copy();
+        REQUIRE(calls == 2);
+
+        httplib::detail::erased_function_t copy_of_copy(copy);
+        REQUIRE(counters.alive == 4);
+    }
+
+    // The copies are destroyed once, the original is left alone.
+    REQUIRE(counters.alive == 2);
+
+    {
+        // A constant function object is called through a copy, as the default asio_handler_invoke() does.
+        const auto const_function = function;
+        httplib::detail::erased_function_t erased(const_function);
+
+        REQUIRE(counters.alive == 3);
+
+        erased();
+        REQUIRE(calls == 3);
+        REQUIRE(counters.alive == 3);
+    }
+
+    REQUIRE(counters.alive == 2);
+}
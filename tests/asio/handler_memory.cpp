@@ -0,0 +1,90 @@
+#include <catch.hpp>
+
+#include <httplib/asio/handler_memory.hpp>
+
+#include <boost/asio/handler_alloc_hook.hpp>
+
+#include <cstdlib>
+
+
+TEST_CASE("handler memory reuses freed blocks", "[handler_memory_t]") {
+    httplib::handler_memory_t memory;
+
+    void *first = memory.allocate(128);
+    memory.deallocate(first, 128);
+
+    REQUIRE(memory.allocate(64) == first);
+    memory.deallocate(first, 64);
+
+    REQUIRE(memory.allocate(128) == first);
+    memory.deallocate(first, 128);
+}
+
+
+TEST_CASE("handler memory keeps three blocks in use", "[handler_memory_t]") {
+    httplib::handler_memory_t memory;
+
+    // E.g. the state of async_read_request(), the socket read it waits for and a write.
+    void *first = memory.allocate(128);
+    void *second = memory.allocate(128);
+    void *third = memory.allocate(128);
+    REQUIRE(first != second);
+    REQUIRE(second != third);
+    REQUIRE(first != third);
+
+    // All the blocks are busy, so this one comes from the heap and isn't kept.
+    void *fourth = memory.allocate(128);
+    REQUIRE(fourth != first);
+    REQUIRE(fourth != second);
+    REQUIRE(fourth != third);
+    memory.deallocate(fourth, 128);
+
+    memory.deallocate(second, 128);
+    REQUIRE(memory.allocate(128) == second);
+
+    memory.deallocate(first, 128);
+    memory.deallocate(second, 128);
+    memory.deallocate(third, 128);
+}
+
+
+TEST_CASE("handler memory grows a free block", "[handler_memory_t]") {
+    httplib::handler_memory_t memory;
+
+    void *small = memory.allocate(16);
+    memory.deallocate(small, 16);
+
+    void *big = memory.allocate(4096);
+    static_cast<char *>(big)[4095] = 'x';
+
+    void *other = memory.allocate(16);
+    REQUIRE(other != big);
+
+    memory.deallocate(big, 4096);
+    memory.deallocate(other, 16);
+
+    REQUIRE(memory.allocate(4096) == big);
+    memory.deallocate(big, 4096);
+}
+
+
+TEST_CASE("bound handler allocates from the memory", "[handler_memory_t]") {
+    httplib::handler_memory_t memory;
+
+    int calls = 0;
+    auto handler = httplib::bind_handler_memory(memory, [&calls](int value) {
+        calls += value;
+    });
+
+    using boost::asio::asio_handler_allocate;
+    using boost::asio::asio_handler_deallocate;
+
+    void *pointer = asio_handler_allocate(64, &handler);
+    asio_handler_deallocate(pointer, 64, &handler);
+
+    REQUIRE(memory.allocate(64) == pointer);
+    memory.deallocate(pointer, 64);
+
+    handler(2);
+    REQUIRE(calls == 2);
+}
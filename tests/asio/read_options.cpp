@@ -0,0 +1,74 @@
+#include <catch.hpp>
+
+#include <httplib/asio/read_options.hpp>
+
+
+TEST_CASE("read size starts from read_buffer_size", "[read_size_t]") {
+    httplib::read_options_t options;
+    options.read_buffer_size = 1024;
+
+    REQUIRE(httplib::read_size_t(options).get() == 1024);
+    REQUIRE(httplib::read_size_t().get() == httplib::read_options_t().read_buffer_size);
+}
+
+
+TEST_CASE("read size grows up to the limit while reads fill the buffer", "[read_size_t]") {
+    httplib::read_options_t options;
+    options.read_buffer_size = 1024;
+    options.max_read_buffer_size = 5000;
+
+    httplib::read_size_t read_size(options);
+
+    read_size.update(1024);
+    REQUIRE(read_size.get() == 2048);
+
+    read_size.update(2048);
+    REQUIRE(read_size.get() == 4096);
+
+    read_size.update(4096);
+    REQUIRE(read_size.get() == 5000);
+
+    read_size.update(5000);
+    REQUIRE(read_size.get() == 5000);
+}
+
+
+TEST_CASE("read size shrinks back on short reads", "[read_size_t]") {
+    httplib::read_options_t options;
+    options.read_buffer_size = 1024;
+    options.max_read_buffer_size = 8192;
+
+    httplib::read_size_t read_size(options);
+
+    read_size.update(1024);
+    read_size.update(2048);
+    read_size.update(4096);
+    REQUIRE(read_size.get() == 8192);
+
+    // More than a half keeps the size.
+    read_size.update(5000);
+    REQUIRE(read_size.get() == 8192);
+
+    read_size.update(100);
+    REQUIRE(read_size.get() == 4096);
+
+    read_size.update(0);
+    read_size.update(0);
+    read_size.update(0);
+    REQUIRE(read_size.get() == 1024);
+}
+
+
+TEST_CASE("read size is fixed when the limit doesn't exceed the initial size", "[read_size_t]") {
+    httplib::read_options_t options;
+    options.read_buffer_size = 1024;
+    options.max_read_buffer_size = 0;
+
+    httplib::read_size_t read_size(options);
+
+    read_size.update(1024);
+    REQUIRE(read_size.get() == 1024);
+
+    read_size.update(1);
+    REQUIRE(read_size.get() == 1024);
+}
@@ -0,0 +1,89 @@
+#include <catch.hpp>
+
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/read_request.hpp>
+#include <httplib/asio/ring_buffer.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/write.hpp>
+
+#include <string>
+#include <vector>
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+using stream_t = httplib::buffered_read_stream<socket_t &, httplib::ring_buffer_t &>;
+
+
+struct connection_t {
+    boost::asio::io_service io_service;
+    socket_t client{io_service};
+    socket_t server{io_service};
+    httplib::ring_buffer_t buffer{1024};
+    stream_t stream{server, buffer};
+
+    connection_t() {
+        boost::asio::local::connect_pair(client, server);
+    }
+
+    void send(const std::string &data) {
+        boost::asio::write(client, boost::asio::buffer(data));
+    }
+};
+
+} // namespace
+
+
+TEST_CASE("async_read_request reads requests already in the buffer", "[read_request]") {
+    connection_t connection;
+    httplib::http_request_parser_t parser;
+    std::vector<std::string> targets;
+
+    connection.send("GET /1 HTTP/1.1\r\nHost: a\r\n\r\n"
+                    "GET /2 HTTP/1.1\r\nHost: a\r\n\r\n");
+
+    auto on_request = [&](boost::system::error_code ec, const httplib::http_request_t &request) {
+        REQUIRE(!ec);
+        targets.push_back(request.target);
+    };
+
+    httplib::async_read_request(connection.stream, parser, on_request);
+    connection.io_service.run();
+
+    // The second request is parsed from the buffer without reading the socket.
+    httplib::async_read_request(connection.stream, parser, on_request);
+    connection.io_service.reset();
+    connection.io_service.run();
+
+    REQUIRE(targets == (std::vector<std::string> {"/1", "/2"}));
+}
+
+
+TEST_CASE("async_read_request probes the stream before reading", "[read_request]") {
+    connection_t connection;
+    httplib::read_options_t options;
+    options.probe_before_read = true;
+
+    std::string target;
+
+    httplib::async_read_request(connection.stream, options, [&](boost::system::error_code ec,
+                                                                httplib::http_request_t request)
+    {
+        REQUIRE(!ec);
+        target = request.target;
+    });
+
+    // Nothing to read yet, so the operation waits on a null_buffers read.
+    connection.io_service.poll();
+
+    REQUIRE(target.empty());
+
+    connection.send("GET /probed HTTP/1.1\r\nHost: a\r\n\r\n");
+    connection.io_service.run();
+
+    REQUIRE(target == "/probed");
+}
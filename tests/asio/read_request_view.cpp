@@ -0,0 +1,264 @@
+#include <catch.hpp>
+
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/read_request_view.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <string>
+#include <vector>
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+using stream_t = httplib::buffered_read_stream<socket_t &, boost::asio::streambuf &>;
+
+
+struct connection_t {
+    boost::asio::io_service io_service;
+    socket_t client{io_service};
+    socket_t server{io_service};
+    boost::asio::streambuf buffer;
+    stream_t stream{server, buffer};
+
+    connection_t() {
+        boost::asio::local::connect_pair(client, server);
+    }
+
+    void send(const std::string &data) {
+        boost::asio::write(client, boost::asio::buffer(data));
+    }
+
+    // Puts the data straight into the stream's buffer, as if it had been read along with a previous message.
+    void buffer_data(const std::string &data) {
+        buffer.commit(boost::asio::buffer_copy(buffer.prepare(data.size()), boost::asio::buffer(data)));
+    }
+};
+
+
+// Reads the stream by read_size bytes, so the head is split across several reads.
+httplib::read_options_t small_reads(std::size_t read_size) {
+    httplib::read_options_t options;
+    options.read_buffer_size = read_size;
+    options.max_read_buffer_size = read_size;
+    return options;
+}
+
+
+// Whether the view lies within the memory of the buffer.
+bool points_into(boost::string_view view, const char *begin, std::size_t size) {
+    return view.data() >= begin && view.data() + view.size() <= begin + size;
+}
+
+
+struct result_t {
+    boost::system::error_code error;
+    std::string method;
+    std::string target;
+    std::vector<std::string> headers;
+    bool points_into_buffer = false;
+};
+
+
+// Copies the view, since it may be used only until the next operation on the stream.
+result_t describe(boost::system::error_code ec,
+                  const httplib::http_request_view_t &request,
+                  const char *buffer_begin = nullptr,
+                  std::size_t buffer_size = 0)
+{
+    result_t result;
+    result.error = ec;
+    result.method = request.method.to_string();
+    result.target = request.target.to_string();
+    result.points_into_buffer = points_into(request.method, buffer_begin, buffer_size) &&
+                                points_into(request.target, buffer_begin, buffer_size);
+
+    for (const auto &header: request.headers) {
+        result.headers.push_back(header.name.to_string() + ": " + header.value.to_string());
+        result.points_into_buffer = result.points_into_buffer &&
+                                    points_into(header.name, buffer_begin, buffer_size) &&
+                                    points_into(header.value, buffer_begin, buffer_size);
+    }
+
+    return result;
+}
+
+
+const std::string request_head = "GET /index.html HTTP/1.1\r\nHost: example.com\r\nAccept: */*\r\n\r\n";
+
+} // namespace
+
+
+TEST_CASE("read request view parses a head in the buffer in place", "[read_request_view]") {
+    connection_t connection;
+    connection.buffer_data(request_head);
+
+    const char *begin = boost::asio::buffer_cast<const char *>(*connection.buffer.data().begin());
+    std::size_t size = connection.buffer.size();
+
+    SECTION("synchronously") {
+        httplib::http_request_view_parser_t parser;
+        boost::system::error_code ec;
+
+        const auto &request = httplib::read_request_view(connection.stream, parser, {}, ec);
+        auto result = describe(ec, request, begin, size);
+
+        REQUIRE(!result.error);
+        REQUIRE(result.method == "GET");
+        REQUIRE(result.target == "/index.html");
+        REQUIRE(result.headers == (std::vector<std::string> {"Host: example.com", "Accept: */*"}));
+        REQUIRE(result.points_into_buffer);
+        REQUIRE(request.version == (httplib::http_version_t {1, 1}));
+    }
+
+    SECTION("asynchronously") {
+        result_t result;
+
+        httplib::async_read_request_view(connection.stream, [&](auto ec, const httplib::http_request_view_t &request) {
+            result = describe(ec, request, begin, size);
+        });
+
+        connection.io_service.run();
+
+        REQUIRE(!result.error);
+        REQUIRE(result.method == "GET");
+        REQUIRE(result.target == "/index.html");
+        REQUIRE(result.headers == (std::vector<std::string> {"Host: example.com", "Accept: */*"}));
+        REQUIRE(result.points_into_buffer);
+    }
+
+    // The head is consumed.
+    REQUIRE(connection.buffer.size() == 0);
+}
+
+
+TEST_CASE("read request view parses a head split across reads", "[read_request_view]") {
+    connection_t connection;
+    connection.send(request_head);
+
+    std::vector<std::string> expected_headers = {"Host: example.com", "Accept: */*"};
+
+    SECTION("synchronously") {
+        httplib::http_request_view_parser_t parser;
+        boost::system::error_code ec;
+
+        auto result = describe(ec, httplib::read_request_view(connection.stream, parser, small_reads(7), ec));
+
+        REQUIRE(!result.error);
+        REQUIRE(result.method == "GET");
+        REQUIRE(result.target == "/index.html");
+        REQUIRE(result.headers == expected_headers);
+    }
+
+    SECTION("asynchronously") {
+        result_t result;
+        result.error = boost::asio::error::would_block;
+
+        httplib::async_read_request_view(connection.stream, small_reads(7),
+                                         [&](auto ec, const httplib::http_request_view_t &request) {
+            result = describe(ec, request);
+        });
+
+        connection.io_service.run();
+
+        REQUIRE(!result.error);
+        REQUIRE(result.method == "GET");
+        REQUIRE(result.target == "/index.html");
+        REQUIRE(result.headers == expected_headers);
+    }
+
+    REQUIRE(connection.buffer.size() == 0);
+}
+
+
+TEST_CASE("read request view reads pipelined requests one by one", "[read_request_view]") {
+    connection_t connection;
+    connection.send("GET /first HTTP/1.1\r\nHost: a\r\n\r\n"
+                    "GET /second HTTP/1.1\r\nHost: b\r\n\r\n");
+
+    SECTION("synchronously") {
+        // The same parser is reused for both requests.
+        httplib::http_request_view_parser_t parser;
+
+        auto first = describe({}, httplib::read_request_view(connection.stream, parser, {}));
+
+        // The second request has been read along with the first one.
+        REQUIRE(connection.buffer.size() != 0);
+
+        auto second = describe({}, httplib::read_request_view(connection.stream, parser, {}));
+
+        REQUIRE(first.target == "/first");
+        REQUIRE(first.headers == (std::vector<std::string> {"Host: a"}));
+        REQUIRE(second.target == "/second");
+        REQUIRE(second.headers == (std::vector<std::string> {"Host: b"}));
+    }
+
+    SECTION("asynchronously") {
+        std::vector<result_t> results;
+
+        httplib::async_read_request_view(connection.stream, [&](auto ec, const httplib::http_request_view_t &request) {
+            results.push_back(describe(ec, request));
+
+            httplib::async_read_request_view(connection.stream, [&](auto ec, const auto &request) {
+                results.push_back(describe(ec, request));
+            });
+        });
+
+        connection.io_service.run();
+
+        REQUIRE(results.size() == 2);
+        REQUIRE(!results[0].error);
+        REQUIRE(results[0].target == "/first");
+        REQUIRE(!results[1].error);
+        REQUIRE(results[1].target == "/second");
+        REQUIRE(results[1].headers == (std::vector<std::string> {"Host: b"}));
+    }
+
+    REQUIRE(connection.buffer.size() == 0);
+}
+
+
+TEST_CASE("read request view reports a malformed head", "[read_request_view]") {
+    connection_t connection;
+    connection.send("GET / HTTP/1.1\r\nHost: a\r\n\r\n"
+                    "GET / HTTP/1.1\r\n: no name\r\n\r\n");
+
+    httplib::http_request_view_parser_t parser;
+
+    SECTION("synchronously") {
+        REQUIRE(httplib::read_request_view(connection.stream, parser, {}).target == "/");
+
+        boost::system::error_code ec;
+        httplib::read_request_view(connection.stream, parser, {}, ec);
+
+        REQUIRE(ec);
+    }
+
+    SECTION("throwing") {
+        REQUIRE(httplib::read_request_view(connection.stream, parser, {}).target == "/");
+        REQUIRE_THROWS_AS(httplib::read_request_view(connection.stream, parser, {}), boost::system::system_error);
+    }
+
+    SECTION("asynchronously") {
+        std::vector<boost::system::error_code> errors;
+
+        httplib::async_read_request_view(connection.stream, [&](auto ec, const httplib::http_request_view_t &) {
+            errors.push_back(ec);
+
+            httplib::async_read_request_view(connection.stream, [&](auto ec, const auto &) {
+                errors.push_back(ec);
+            });
+        });
+
+        connection.io_service.run();
+
+        REQUIRE(errors.size() == 2);
+        REQUIRE(!errors[0]);
+        REQUIRE(errors[1]);
+    }
+}
@@ -0,0 +1,149 @@
+#include <catch.hpp>
+
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/read_requests.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <string>
+#include <vector>
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+using stream_t = httplib::buffered_read_stream<socket_t &, boost::asio::streambuf &>;
+
+
+struct connection_t {
+    boost::asio::io_service io_service;
+    socket_t client{io_service};
+    socket_t server{io_service};
+    boost::asio::streambuf buffer;
+    stream_t stream{server, buffer};
+    httplib::http_request_parser_t parser;
+    std::vector<httplib::http_request_t> requests;
+
+    connection_t() {
+        boost::asio::local::connect_pair(client, server);
+    }
+
+    void send(const std::string &data) {
+        boost::asio::write(client, boost::asio::buffer(data));
+    }
+
+    boost::system::error_code async_read() {
+        boost::system::error_code result = boost::asio::error::would_block;
+
+        httplib::async_read_requests(stream, parser, requests, [&result](boost::system::error_code ec) {
+            result = ec;
+        });
+
+        io_service.reset();
+        io_service.run();
+
+        return result;
+    }
+
+    std::vector<std::string> targets() const {
+        std::vector<std::string> result;
+
+        for (const auto &request: requests) {
+            result.push_back(request.target);
+        }
+
+        return result;
+    }
+};
+
+} // namespace
+
+
+TEST_CASE("pipelined bodiless requests are read in one batch", "[read_requests]") {
+    connection_t connection;
+
+    connection.send("GET /1 HTTP/1.1\r\nHost: a\r\n\r\n"
+                    "GET /2 HTTP/1.1\r\nHost: a\r\n\r\n"
+                    "HEAD /3 HTTP/1.1\r\nHost: a\r\n\r\n");
+
+    // All three heads arrive with one write, so the first read gets them all.
+    httplib::read_requests(connection.stream, connection.parser, connection.requests, {});
+
+    REQUIRE(connection.targets() == (std::vector<std::string> {"/1", "/2", "/3"}));
+    REQUIRE(connection.requests[2].method == "HEAD");
+    REQUIRE(connection.stream.buffer().size() == 0);
+}
+
+
+TEST_CASE("a batch ends at the first request with a body", "[read_requests]") {
+    connection_t connection;
+
+    connection.send("GET /1 HTTP/1.1\r\nHost: a\r\n\r\n"
+                    "POST /2 HTTP/1.1\r\nHost: a\r\nContent-Length: 4\r\n\r\n"
+                    "body"
+                    "GET /3 HTTP/1.1\r\nHost: a\r\n\r\n");
+
+    REQUIRE(!connection.async_read());
+    REQUIRE(connection.targets() == (std::vector<std::string> {"/1", "/2"}));
+
+    // The body and the next request stay in the buffer.
+    REQUIRE(connection.stream.buffer().size() == std::string("bodyGET /3 HTTP/1.1\r\nHost: a\r\n\r\n").size());
+
+    connection.stream.buffer().consume(4);
+
+    REQUIRE(!connection.async_read());
+    REQUIRE(connection.targets() == (std::vector<std::string> {"/3"}));
+}
+
+
+TEST_CASE("a partial head is kept in the parser across calls", "[read_requests]") {
+    connection_t connection;
+
+    connection.send("GET /1 HTTP/1.1\r\nHost: a\r\n\r\n"
+                    "GET /2 HTTP/1.1\r\nHo");
+
+    REQUIRE(!connection.async_read());
+    REQUIRE(connection.targets() == (std::vector<std::string> {"/1"}));
+
+    // The parser has already taken the beginning of the second head.
+    REQUIRE(connection.stream.buffer().size() == 0);
+
+    connection.send("st: a\r\n\r\n");
+
+    boost::system::error_code ec;
+    httplib::read_requests(connection.stream, connection.parser, connection.requests, {}, ec);
+
+    REQUIRE(!ec);
+    REQUIRE(connection.targets() == (std::vector<std::string> {"/2"}));
+}
+
+
+TEST_CASE("a malformed request is reported by the call after the good ones", "[read_requests]") {
+    connection_t connection;
+
+    connection.send("GET /1 HTTP/1.1\r\nHost: a\r\n\r\n"
+                    "GET /2 HTTP/1.1\r\nHost: a\r\n\r\n"
+                    "GET /3 HTTP/1.1\r\n:::\r\n\r\n");
+
+    REQUIRE(!connection.async_read());
+    REQUIRE(connection.targets() == (std::vector<std::string> {"/1", "/2"}));
+
+    auto ec = connection.async_read();
+
+    REQUIRE(ec);
+    REQUIRE(connection.requests.empty());
+
+    // The error sticks to the parser, the synchronous version reports it too.
+    boost::system::error_code sync_ec;
+    httplib::read_requests(connection.stream, connection.parser, connection.requests, {}, sync_ec);
+
+    REQUIRE(sync_ec == ec);
+    REQUIRE_THROWS_AS(
+        httplib::read_requests(connection.stream, connection.parser, connection.requests, {}),
+        boost::system::system_error
+    );
+}
@@ -0,0 +1,127 @@
+#include <catch.hpp>
+
+#include <httplib/asio/ring_buffer.hpp>
+
+#include <boost/asio/buffer.hpp>
+
+#include <stdexcept>
+#include <string>
+
+
+namespace {
+
+std::size_t write(httplib::ring_buffer_t &buffer, const std::string &data) {
+    std::size_t written = boost::asio::buffer_copy(buffer.prepare(data.size()), boost::asio::buffer(data));
+    buffer.commit(written);
+    return written;
+}
+
+
+std::string read_all(const httplib::ring_buffer_t &buffer) {
+    std::string result;
+
+    for (const auto &buf: buffer.data()) {
+        result.append(boost::asio::buffer_cast<const char *>(buf), boost::asio::buffer_size(buf));
+    }
+
+    return result;
+}
+
+} // namespace
+
+
+TEST_CASE("ring buffer reads and consumes", "[ring_buffer_t]") {
+    httplib::ring_buffer_t buffer(16);
+
+    REQUIRE(buffer.size() == 0);
+    REQUIRE(buffer.data().empty());
+
+    REQUIRE(write(buffer, "0123456789") == 10);
+    REQUIRE(buffer.size() == 10);
+    REQUIRE(buffer.data().size() == 1);
+    REQUIRE(read_all(buffer) == "0123456789");
+
+    buffer.consume(4);
+    REQUIRE(read_all(buffer) == "456789");
+
+    buffer.consume(100);
+    REQUIRE(buffer.size() == 0);
+}
+
+
+TEST_CASE("ring buffer commits at most the prepared size", "[ring_buffer_t]") {
+    httplib::ring_buffer_t buffer(16);
+
+    REQUIRE(boost::asio::buffer_size(buffer.prepare(4)) == 4);
+    buffer.commit(10);
+    REQUIRE(buffer.size() == 4);
+
+    buffer.commit(10);
+    REQUIRE(buffer.size() == 4);
+}
+
+
+TEST_CASE("ring buffer wraps around without moving data", "[ring_buffer_t]") {
+    httplib::ring_buffer_t buffer(16);
+
+    REQUIRE(write(buffer, "0123456789ab") == 12);
+
+    const char *first = boost::asio::buffer_cast<const char *>(*buffer.data().begin());
+
+    buffer.consume(10);
+
+    // The unread bytes stay where they were.
+    REQUIRE(boost::asio::buffer_cast<const char *>(*buffer.data().begin()) == first + 10);
+
+    auto prepared = buffer.prepare(100);
+    REQUIRE(prepared.size() == 2);
+    REQUIRE(boost::asio::buffer_size(prepared) == 14);
+
+    REQUIRE(write(buffer, "cdefghij") == 8);
+    REQUIRE(buffer.size() == 10);
+    REQUIRE(buffer.data().size() == 2);
+    REQUIRE(read_all(buffer) == "abcdefghij");
+    REQUIRE(boost::asio::buffer_cast<const char *>(*buffer.data().begin()) == first + 10);
+}
+
+
+TEST_CASE("ring buffer starts over when empty", "[ring_buffer_t]") {
+    httplib::ring_buffer_t buffer(16);
+
+    write(buffer, "0123456789");
+    const char *first = boost::asio::buffer_cast<const char *>(*buffer.data().begin());
+    buffer.consume(10);
+
+    auto prepared = buffer.prepare(16);
+    REQUIRE(prepared.size() == 1);
+    REQUIRE(boost::asio::buffer_cast<char *>(*prepared.begin()) == first);
+    REQUIRE(boost::asio::buffer_size(prepared) == 16);
+}
+
+
+TEST_CASE("ring buffer limits prepared size by capacity", "[ring_buffer_t]") {
+    httplib::ring_buffer_t buffer(16);
+
+    REQUIRE(write(buffer, "0123456789abcdefXYZ") == 16);
+    REQUIRE(buffer.size() == 16);
+    REQUIRE_THROWS_AS(buffer.prepare(1), const std::length_error &);
+
+    buffer.consume(1);
+    REQUIRE(boost::asio::buffer_size(buffer.prepare(100)) == 1);
+}
+
+
+TEST_CASE("ring buffer releases memory only when empty", "[ring_buffer_t]") {
+    httplib::ring_buffer_t buffer(16);
+
+    write(buffer, "0123");
+    buffer.release();
+    REQUIRE(read_all(buffer) == "0123");
+
+    buffer.consume(4);
+    buffer.release();
+    REQUIRE(buffer.size() == 0);
+
+    REQUIRE(write(buffer, "abc") == 3);
+    REQUIRE(read_all(buffer) == "abc");
+}
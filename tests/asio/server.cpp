@@ -0,0 +1,351 @@
+#include <catch.hpp>
+
+#include <httplib/asio/body_reader.hpp>
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/read_response.hpp>
+#include <httplib/asio/server.hpp>
+#include <httplib/http/message_properties.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+
+namespace {
+
+using tcp = boost::asio::ip::tcp;
+
+
+struct reply_t {
+    httplib::http_response_t response;
+    std::string body;
+
+    bool keep_alive() const {
+        return httplib::connection_status(response) == httplib::connection_status_t::keep_alive;
+    }
+};
+
+
+// A blocking connection to the server.
+class connection_t {
+public:
+    explicit connection_t(const tcp::endpoint &endpoint) :
+        m_socket(m_io_service),
+        m_stream(m_socket, m_buffer)
+    {
+        m_socket.connect(endpoint);
+    }
+
+    void send(const std::string &data) {
+        boost::asio::write(m_socket, boost::asio::buffer(data));
+    }
+
+    reply_t receive() {
+        reply_t result;
+        result.response = httplib::read_response(m_stream);
+
+        auto reader = httplib::make_body_reader(result.response, m_stream);
+        REQUIRE(reader);
+
+        char buffer[1024];
+
+        while (true) {
+            boost::system::error_code ec;
+            std::size_t transferred = reader->read_some(boost::asio::buffer(buffer), ec);
+            result.body.append(buffer, transferred);
+
+            if (ec == httplib::reader_errc_t::eof) {
+                return result;
+            }
+
+            REQUIRE(!ec);
+        }
+    }
+
+    // Whether the server has closed the connection, and sent nothing else.
+    bool closed() {
+        char byte;
+        boost::system::error_code ec;
+        std::size_t transferred = m_stream.stream().read_some(boost::asio::buffer(&byte, 1), ec);
+
+        return m_stream.buffer().size() == 0 && transferred == 0 &&
+               (ec == boost::asio::error::eof || ec == boost::asio::error::connection_reset);
+    }
+
+private:
+    boost::asio::io_service m_io_service;
+    tcp::socket m_socket;
+    boost::asio::streambuf m_buffer;
+    httplib::buffered_read_stream<tcp::socket &, boost::asio::streambuf &> m_stream;
+};
+
+
+std::string get(const std::string &target) {
+    return "GET " + target + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+}
+
+
+std::string post(const std::string &target, const std::string &body) {
+    return "POST " + target + " HTTP/1.1\r\nHost: localhost\r\nContent-Length: " + std::to_string(body.size()) +
+           "\r\n\r\n" + body;
+}
+
+
+// Echoes the method, the target and the body. /throw throws.
+void echo(const httplib::http_request_t &request, const std::string &body, httplib::server_response_t &response) {
+    if (request.target == "/throw") {
+        throw std::runtime_error("handler failed");
+    }
+
+    response.body = request.method + " " + request.target + ": " + body;
+}
+
+
+httplib::server_options_t make_options(bool reuse_port) {
+    httplib::server_options_t options;
+    options.threads = 2;
+    options.pin_threads = false;
+    options.reuse_port = reuse_port;
+    options.max_body_size = 64;
+    return options;
+}
+
+
+tcp::endpoint loopback() {
+    return tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0);
+}
+
+
+// Lets the process open no more descriptors while it exists.
+class descriptor_limit_t {
+public:
+    descriptor_limit_t() {
+        getrlimit(RLIMIT_NOFILE, &m_original);
+
+        // The lowest free descriptor, so everything above it is forbidden.
+        int lowest_free = dup(0);
+        close(lowest_free);
+
+        rlimit limit = m_original;
+        limit.rlim_cur = static_cast<rlim_t>(lowest_free);
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    ~descriptor_limit_t() {
+        setrlimit(RLIMIT_NOFILE, &m_original);
+    }
+
+private:
+    rlimit m_original;
+};
+
+} // namespace
+
+
+TEST_CASE("server serves several requests on a keep-alive connection", "[server_t]") {
+    bool reuse_port = true;
+
+    SECTION("with an acceptor per thread") {
+        reuse_port = true;
+    }
+
+    SECTION("with one acceptor") {
+        reuse_port = false;
+    }
+
+    httplib::server_t server(echo, make_options(reuse_port));
+    server.start(loopback());
+
+    REQUIRE(server.local_endpoint().port() != 0);
+
+    // Several connections, so both threads get some.
+    for (int i = 0; i < 4; ++i) {
+        connection_t connection(server.local_endpoint());
+
+        for (int j = 0; j < 3; ++j) {
+            connection.send(post("/" + std::to_string(j), "body " + std::to_string(i)));
+
+            auto reply = connection.receive();
+
+            REQUIRE(reply.response.code == 200);
+            REQUIRE(reply.keep_alive());
+            REQUIRE(reply.body == "POST /" + std::to_string(j) + ": body " + std::to_string(i));
+        }
+
+        // Pipelined requests are answered in order.
+        connection.send(get("/a") + get("/b"));
+
+        REQUIRE(connection.receive().body == "GET /a: ");
+        REQUIRE(connection.receive().body == "GET /b: ");
+    }
+
+    server.stop();
+    server.join();
+}
+
+
+TEST_CASE("server answers errors and closes the connection", "[server_t]") {
+    httplib::server_t server(echo, make_options(true));
+    server.start(loopback());
+
+    connection_t connection(server.local_endpoint());
+
+    SECTION("a malformed head") {
+        connection.send("GET / HTTP/1.1\r\nHost: localhost\r\n: no name\r\n\r\n");
+
+        auto reply = connection.receive();
+
+        REQUIRE(reply.response.code == 400);
+        REQUIRE(!reply.keep_alive());
+    }
+
+    SECTION("a body over max_body_size") {
+        connection.send(post("/big", std::string(100, 'x')));
+
+        auto reply = connection.receive();
+
+        REQUIRE(reply.response.code == 413);
+        REQUIRE(!reply.keep_alive());
+    }
+
+    SECTION("a throwing handler") {
+        // The request before it is served as usual.
+        connection.send(get("/ok"));
+
+        REQUIRE(connection.receive().response.code == 200);
+
+        connection.send(get("/throw"));
+
+        auto reply = connection.receive();
+
+        REQUIRE(reply.response.code == 500);
+        REQUIRE(!reply.keep_alive());
+    }
+
+    REQUIRE(connection.closed());
+}
+
+
+TEST_CASE("server stops gracefully", "[server_t]") {
+    bool reuse_port = true;
+
+    SECTION("with an acceptor per thread") {
+        reuse_port = true;
+    }
+
+    SECTION("with one acceptor") {
+        reuse_port = false;
+    }
+
+    httplib::server_t server(echo, make_options(reuse_port));
+    server.start(loopback());
+
+    auto endpoint = server.local_endpoint();
+    connection_t idle(endpoint);
+    connection_t busy(endpoint);
+
+    idle.send(get("/idle"));
+
+    REQUIRE(idle.receive().keep_alive());
+
+    // The head and a part of the body, so the request is in progress when the server stops.
+    busy.send("POST /busy HTTP/1.1\r\nHost: localhost\r\nContent-Length: 10\r\n\r\n01234");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    server.stop();
+
+    REQUIRE(idle.closed());
+
+    busy.send("56789");
+
+    auto reply = busy.receive();
+
+    REQUIRE(reply.response.code == 200);
+    REQUIRE(reply.body == "POST /busy: 0123456789");
+    REQUIRE(!reply.keep_alive());
+    REQUIRE(busy.closed());
+
+    // The threads exit once their connections are closed.
+    server.join();
+
+    boost::asio::io_service io_service;
+    tcp::socket socket(io_service);
+    boost::system::error_code ec;
+    socket.connect(endpoint, ec);
+
+    REQUIRE(ec == boost::asio::error::connection_refused);
+}
+
+
+TEST_CASE("server closes idle connections", "[server_t]") {
+    auto options = make_options(true);
+    options.timeouts.idle = std::chrono::milliseconds(50);
+    options.timeout_resolution = std::chrono::milliseconds(10);
+
+    httplib::server_t server(echo, options);
+    server.start(loopback());
+
+    connection_t connection(server.local_endpoint());
+    auto start = std::chrono::steady_clock::now();
+
+    SECTION("before the first request") {
+    }
+
+    SECTION("after a request") {
+        connection.send(get("/"));
+
+        REQUIRE(connection.receive().keep_alive());
+    }
+
+    REQUIRE(connection.closed());
+    REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(50));
+
+    server.stop();
+    server.join();
+}
+
+
+TEST_CASE("server waits after a failed accept", "[server_t]") {
+    auto options = make_options(false);
+    options.threads = 1;
+    options.accept_error_delay = std::chrono::milliseconds(50);
+
+    httplib::server_t server(echo, options);
+    server.start(loopback());
+
+    boost::asio::io_service io_service;
+    tcp::socket socket(io_service);
+    socket.open(tcp::v4());
+
+    {
+        // The connection is queued, but the server has no descriptor to accept it with.
+        descriptor_limit_t limit;
+        socket.connect(server.local_endpoint());
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    }
+
+    // Accepting again right away would fail thousands of times.
+    REQUIRE(server.accept_errors() >= 1);
+    REQUIRE(server.accept_errors() <= 10);
+
+    // The connection is accepted once a descriptor is available.
+    boost::asio::write(socket, boost::asio::buffer(get("/late")));
+
+    boost::asio::streambuf buffer;
+    httplib::buffered_read_stream<tcp::socket &, boost::asio::streambuf &> stream(socket, buffer);
+
+    REQUIRE(httplib::read_response(stream).code == 200);
+
+    server.stop();
+    server.join();
+}
@@ -0,0 +1,403 @@
+#include <catch.hpp>
+
+#include <httplib/asio/splice_body.hpp>
+
+#ifdef __linux__
+
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/read_request.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+using stream_t = httplib::buffered_read_stream<socket_t &, boost::asio::streambuf &>;
+
+
+struct connection_t {
+    boost::asio::io_service io_service;
+    socket_t client{io_service};
+    socket_t server{io_service};
+    boost::asio::streambuf buffer;
+    stream_t stream{server, buffer};
+
+    connection_t() {
+        boost::asio::local::connect_pair(client, server);
+    }
+
+    void send(const std::string &data) {
+        boost::asio::write(client, boost::asio::buffer(data));
+    }
+
+    // Sends the data from another thread, so it may be bigger than the socket's buffers.
+    std::thread send_async(std::string data) {
+        return std::thread([this, data] {
+            send(data);
+        });
+    }
+};
+
+
+// A temporary file to splice the body into.
+class output_t {
+public:
+    output_t() :
+        m_file(std::tmpfile(), &std::fclose)
+    {
+        REQUIRE(m_file);
+    }
+
+    int fd() const {
+        return ::fileno(m_file.get());
+    }
+
+    std::string contents() const {
+        std::string result;
+        char buffer[4096];
+        off_t offset = 0;
+
+        while (true) {
+            ssize_t received = ::pread(fd(), buffer, sizeof(buffer), offset);
+            REQUIRE(received >= 0);
+
+            if (received == 0) {
+                return result;
+            }
+
+            result.append(buffer, static_cast<std::size_t>(received));
+            offset += received;
+        }
+    }
+
+private:
+    std::unique_ptr<std::FILE, int (*)(std::FILE *)> m_file;
+};
+
+
+std::string make_body(std::size_t size) {
+    std::string result;
+
+    for (std::size_t i = 0; i < size; ++i) {
+        result.push_back(static_cast<char>('a' + i % 26));
+    }
+
+    return result;
+}
+
+
+std::string head(std::size_t content_length) {
+    return "PUT /upload HTTP/1.1\r\nHost: a\r\nContent-Length: " + std::to_string(content_length) + "\r\n\r\n";
+}
+
+
+std::string chunked(const std::string &body, std::size_t chunk_size) {
+    std::string result = "PUT /upload HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: chunked\r\n\r\n";
+
+    for (std::size_t offset = 0; offset < body.size(); offset += chunk_size) {
+        auto chunk = body.substr(offset, chunk_size);
+        char size[32];
+        std::snprintf(size, sizeof(size), "%zx\r\n", chunk.size());
+        result += size + chunk + "\r\n";
+    }
+
+    return result + "0\r\n\r\n";
+}
+
+
+// Another socket pair, registered in the same io_service, to splice the body into. Nobody reads it until
+// drain() is called, so it gets full.
+struct sink_t {
+    socket_t writer;
+    socket_t reader;
+    std::string received;
+    std::thread thread;
+
+    explicit sink_t(boost::asio::io_service &io_service) :
+        writer(io_service),
+        reader(io_service)
+    {
+        boost::asio::local::connect_pair(writer, reader);
+    }
+
+    ~sink_t() {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    int fd() {
+        return writer.native_handle();
+    }
+
+    bool non_blocking() {
+        return (::fcntl(fd(), F_GETFL) & O_NONBLOCK) != 0;
+    }
+
+    // Reads size bytes from another thread.
+    void drain(std::size_t size) {
+        thread = std::thread([this, size] {
+            received.resize(size);
+            boost::asio::read(reader, boost::asio::buffer(&received[0], size));
+        });
+    }
+};
+
+} // namespace
+
+
+TEST_CASE("splice body writes the buffered part of the body first", "[splice_body]") {
+    connection_t connection;
+    output_t output;
+
+    // The head and the beginning of the body arrive together, so reading the head buffers a part of the body.
+    connection.send(head(10) + "01234");
+
+    auto request = httplib::read_request(connection.stream);
+
+    REQUIRE(connection.stream.buffer().size() == 5);
+
+    // The rest of the body arrives with the next request.
+    connection.send("56789GET /next HTTP/1.1\r\nHost: a\r\n\r\n");
+
+    REQUIRE(httplib::splice_body(request, connection.stream, output.fd()) == 10);
+    REQUIRE(output.contents() == "0123456789");
+    REQUIRE(httplib::read_request(connection.stream).target == "/next");
+}
+
+
+TEST_CASE("splice body leaves the next message in the buffer", "[splice_body]") {
+    connection_t connection;
+    output_t output;
+
+    connection.send(head(4) + "bodyGET /next HTTP/1.1\r\nHost: a\r\n\r\n");
+
+    auto request = httplib::read_request(connection.stream);
+
+    REQUIRE(httplib::splice_body(request, connection.stream, output.fd()) == 4);
+    REQUIRE(output.contents() == "body");
+    REQUIRE(httplib::read_request(connection.stream).target == "/next");
+}
+
+
+TEST_CASE("splice body moves a body with Content-Length", "[splice_body]") {
+    const auto body = make_body(3 * 1024 * 1024 + 17);
+
+    SECTION("synchronously") {
+        connection_t connection;
+        output_t output;
+
+        connection.send(head(body.size()));
+        auto request = httplib::read_request(connection.stream);
+        auto sender = connection.send_async(body);
+
+        boost::system::error_code ec;
+        auto written = httplib::splice_body(request, connection.stream, output.fd(), {}, ec);
+        sender.join();
+
+        REQUIRE(!ec);
+        REQUIRE(written == static_cast<httplib::content_length_int_t>(body.size()));
+        REQUIRE(output.contents() == body);
+    }
+
+    SECTION("asynchronously") {
+        connection_t connection;
+        output_t output;
+
+        connection.send(head(body.size()) + body.substr(0, 100));
+        auto request = httplib::read_request(connection.stream);
+        auto sender = connection.send_async(body.substr(100));
+
+        boost::system::error_code error = boost::asio::error::would_block;
+        httplib::content_length_int_t written = 0;
+
+        httplib::async_splice_body(request, connection.stream, output.fd(), {},
+                                   [&](boost::system::error_code ec, httplib::content_length_int_t transferred) {
+            error = ec;
+            written = transferred;
+        });
+
+        connection.io_service.run();
+        sender.join();
+
+        REQUIRE(!error);
+        REQUIRE(written == static_cast<httplib::content_length_int_t>(body.size()));
+        REQUIRE(output.contents() == body);
+    }
+}
+
+
+TEST_CASE("splice body copies a chunked body", "[splice_body]") {
+    connection_t connection;
+    output_t output;
+
+    connection.send("PUT /upload HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: chunked\r\n\r\n"
+                    "5\r\nhello\r\n"
+                    "7\r\n, world\r\n"
+                    "0\r\n\r\n"
+                    "GET /next HTTP/1.1\r\nHost: a\r\n\r\n");
+
+    auto request = httplib::read_request(connection.stream);
+
+    SECTION("synchronously") {
+        REQUIRE(httplib::splice_body(request, connection.stream, output.fd()) == 12);
+    }
+
+    SECTION("asynchronously") {
+        boost::system::error_code error = boost::asio::error::would_block;
+        httplib::content_length_int_t written = 0;
+
+        httplib::async_splice_body(request, connection.stream, output.fd(), {},
+                                   [&](boost::system::error_code ec, httplib::content_length_int_t transferred) {
+            error = ec;
+            written = transferred;
+        });
+
+        connection.io_service.run();
+
+        REQUIRE(!error);
+        REQUIRE(written == 12);
+    }
+
+    REQUIRE(output.contents() == "hello, world");
+    REQUIRE(httplib::read_request(connection.stream).target == "/next");
+}
+
+
+TEST_CASE("splice body reports an early end of the stream", "[splice_body]") {
+    connection_t connection;
+    output_t output;
+
+    connection.send(head(100) + "0123456789");
+    auto request = httplib::read_request(connection.stream);
+
+    connection.send("abcde");
+    connection.client.close();
+
+    SECTION("synchronously") {
+        boost::system::error_code ec;
+
+        REQUIRE(httplib::splice_body(request, connection.stream, output.fd(), {}, ec) == 15);
+        REQUIRE(ec == boost::asio::error::eof);
+    }
+
+    SECTION("asynchronously") {
+        boost::system::error_code error;
+        httplib::content_length_int_t written = 0;
+
+        httplib::async_splice_body(request, connection.stream, output.fd(), {},
+                                   [&](boost::system::error_code ec, httplib::content_length_int_t transferred) {
+            error = ec;
+            written = transferred;
+        });
+
+        connection.io_service.run();
+
+        REQUIRE(written == 15);
+        REQUIRE(error == boost::asio::error::eof);
+    }
+
+    REQUIRE(output.contents() == "0123456789abcde");
+}
+
+
+TEST_CASE("async splice body doesn't block the thread on a full descriptor", "[splice_body]") {
+    const auto body = make_body(2 * 1024 * 1024 + 17);
+
+    connection_t connection;
+    sink_t sink(connection.io_service);
+    std::string message;
+    bool spliced = false;
+
+    SECTION("with Content-Length") {
+        message = head(body.size()) + body;
+        spliced = true;
+    }
+
+    SECTION("chunked") {
+        message = chunked(body, 10000);
+    }
+
+    auto sender = connection.send_async(message);
+    auto request = httplib::read_request(connection.stream);
+
+    boost::system::error_code error = boost::asio::error::would_block;
+    httplib::content_length_int_t written = 0;
+    bool completed = false;
+
+    httplib::async_splice_body(request, connection.stream, sink.fd(), {},
+                               [&](boost::system::error_code ec, httplib::content_length_int_t transferred) {
+        error = ec;
+        written = transferred;
+        completed = true;
+    });
+
+    // The handlers keep running while the sink is full and nobody reads it.
+    for (int i = 0; i < 20; ++i) {
+        connection.io_service.poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    REQUIRE(!completed);
+    REQUIRE(sink.reader.available() > 0);
+
+    sink.drain(body.size());
+    connection.io_service.reset();
+    connection.io_service.run();
+    sender.join();
+    sink.thread.join();
+
+    REQUIRE(completed);
+    REQUIRE(!error);
+    REQUIRE(written == static_cast<httplib::content_length_int_t>(body.size()));
+    REQUIRE(sink.received == body);
+
+    REQUIRE(!sink.non_blocking());
+
+    // A chunked body is read by body_reader, and asio leaves the socket in the non-blocking mode after that.
+    if (spliced) {
+        REQUIRE(!connection.server.native_non_blocking());
+        REQUIRE((::fcntl(connection.server.native_handle(), F_GETFL) & O_NONBLOCK) == 0);
+    }
+}
+
+
+TEST_CASE("splice body waits for a non-blocking descriptor", "[splice_body]") {
+    const auto body = make_body(1024 * 1024 + 17);
+
+    connection_t connection;
+    sink_t sink(connection.io_service);
+
+    sink.writer.native_non_blocking(true);
+
+    auto sender = connection.send_async(head(body.size()) + body);
+    auto request = httplib::read_request(connection.stream);
+
+    sink.drain(body.size());
+
+    boost::system::error_code ec;
+    auto written = httplib::splice_body(request, connection.stream, sink.fd(), {}, ec);
+    sender.join();
+    sink.thread.join();
+
+    REQUIRE(!ec);
+    REQUIRE(written == static_cast<httplib::content_length_int_t>(body.size()));
+    REQUIRE(sink.received == body);
+}
+
+#endif // __linux__
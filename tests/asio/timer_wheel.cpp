@@ -0,0 +1,144 @@
+#include <catch.hpp>
+
+#include <httplib/asio/connection_timeouts.hpp>
+#include <httplib/asio/timer_wheel.hpp>
+
+#include <boost/asio/io_service.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+
+namespace {
+
+using milliseconds = std::chrono::milliseconds;
+
+} // namespace
+
+
+TEST_CASE("timer wheel expires timers in order of their timeouts", "[timer_wheel_t]") {
+    boost::asio::io_service io_service;
+    httplib::timer_wheel_t wheel(io_service, milliseconds(1), 4);
+
+    std::vector<int> expired;
+    httplib::timer_wheel_t::timer_t first([&] { expired.push_back(1); });
+    httplib::timer_wheel_t::timer_t second([&] { expired.push_back(2); });
+    httplib::timer_wheel_t::timer_t third([&] { expired.push_back(3); });
+
+    // Longer than a turn of the wheel.
+    wheel.arm(third, milliseconds(15));
+    wheel.arm(second, milliseconds(6));
+    wheel.arm(first, milliseconds(2));
+    REQUIRE(wheel.armed() == 3);
+
+    auto start = std::chrono::steady_clock::now();
+    io_service.run();
+
+    REQUIRE(std::chrono::steady_clock::now() - start >= milliseconds(15));
+    REQUIRE(expired == (std::vector<int>{1, 2, 3}));
+    REQUIRE(wheel.armed() == 0);
+    REQUIRE(!first.armed());
+}
+
+
+TEST_CASE("timer wheel rearms and cancels timers", "[timer_wheel_t]") {
+    boost::asio::io_service io_service;
+    httplib::timer_wheel_t wheel(io_service, milliseconds(1));
+
+    std::vector<int> expired;
+    httplib::timer_wheel_t::timer_t canceled([&] { expired.push_back(1); });
+    httplib::timer_wheel_t::timer_t rearmed([&] { expired.push_back(2); });
+    httplib::timer_wheel_t::timer_t periodic([&] { expired.push_back(3); });
+
+    httplib::timer_wheel_t::timer_t repeat([&] {
+        if (expired.size() < 2) {
+            wheel.arm(periodic, milliseconds(1));
+            wheel.arm(repeat, milliseconds(3));
+        }
+    });
+
+    wheel.arm(canceled, milliseconds(2));
+    wheel.arm(rearmed, milliseconds(2));
+    wheel.arm(repeat, milliseconds(1));
+
+    canceled.cancel();
+    wheel.arm(rearmed, milliseconds(30));
+    REQUIRE(wheel.armed() == 2);
+
+    io_service.run();
+
+    REQUIRE(expired == (std::vector<int>{3, 3, 2}));
+    REQUIRE(wheel.armed() == 0);
+}
+
+
+TEST_CASE("timer wheel disarms timers when destroyed", "[timer_wheel_t]") {
+    boost::asio::io_service io_service;
+    httplib::timer_wheel_t::timer_t timer([] { });
+
+    {
+        httplib::timer_wheel_t wheel(io_service);
+        wheel.arm(timer, milliseconds(1000));
+        REQUIRE(timer.armed());
+    }
+
+    REQUIRE(!timer.armed());
+}
+
+
+TEST_CASE("connection timeouts report the expiry as timed_out", "[connection_timeouts_t]") {
+    boost::asio::io_service io_service;
+    httplib::timer_wheel_t wheel(io_service, milliseconds(1));
+
+    httplib::connection_timeout_options_t options;
+    options.idle = milliseconds(2);
+    options.head = milliseconds(1000);
+
+    int expired = 0;
+    httplib::connection_timeouts_t timeouts(wheel, options, [&] { ++expired; });
+
+    // The message is read in time.
+    timeouts.wait_message();
+    timeouts.read_head();
+    timeouts.finish();
+    io_service.run();
+    io_service.reset();
+
+    REQUIRE(expired == 0);
+    REQUIRE(!timeouts.expired());
+
+    timeouts.wait_message();
+    io_service.run();
+
+    REQUIRE(expired == 1);
+    REQUIRE(timeouts.expired());
+    REQUIRE(timeouts.error(make_error_code(boost::asio::error::operation_aborted)) == boost::asio::error::timed_out);
+    REQUIRE(!timeouts.error(boost::system::error_code()));
+}
+
+
+TEST_CASE("connection timeouts extend the body timeout while the body arrives fast enough", "[connection_timeouts_t]") {
+    boost::asio::io_service io_service;
+    httplib::timer_wheel_t wheel(io_service, milliseconds(1));
+
+    httplib::connection_timeout_options_t options;
+    options.min_body_rate = 1000;
+    options.body_rate_interval = milliseconds(10);
+
+    httplib::connection_timeouts_t timeouts(wheel, options, [] { });
+
+    // 10 bytes per 10 ms are required.
+    timeouts.read_body(0);
+    auto armed = std::chrono::steady_clock::now();
+
+    timeouts.read_body(5);
+    timeouts.read_body(5);
+    auto rearmed = std::chrono::steady_clock::now();
+
+    io_service.run();
+
+    REQUIRE(timeouts.expired());
+    REQUIRE(std::chrono::steady_clock::now() - armed >= milliseconds(10));
+    REQUIRE(std::chrono::steady_clock::now() - rearmed >= milliseconds(10));
+}
@@ -0,0 +1,147 @@
+#include <catch.hpp>
+
+#include <httplib/asio/use_awaitable.hpp>
+
+#ifdef HTTPLIB_HAS_COROUTINES
+
+#include <httplib/asio/body_reader.hpp>
+#include <httplib/asio/buffered_read_stream.hpp>
+#include <httplib/asio/read_request.hpp>
+#include <httplib/asio/ring_buffer.hpp>
+#include <httplib/asio/write_response.hpp>
+#include <httplib/response_builder.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+using stream_t = httplib::buffered_read_stream<socket_t &, httplib::ring_buffer_t &>;
+
+
+// What the coroutine has seen. Checked after it's done, since a failed REQUIRE must not throw out of it.
+struct exchange_t {
+    std::vector<std::string> targets;
+    std::vector<std::string> bodies;
+    boost::system::error_code error;
+    bool finished = false;
+};
+
+
+// Echoes the bodies of the requests until the connection is closed.
+httplib::detached_task_t echo(socket_t &socket, exchange_t &exchange) {
+    httplib::ring_buffer_t buffer;
+    stream_t stream(socket, buffer);
+    httplib::http_request_parser_t parser;
+
+    while (true) {
+        auto [ec, request] = co_await httplib::async_read_request(stream, parser, {}, httplib::use_awaitable);
+
+        if (ec) {
+            exchange.error = ec;
+            break;
+        }
+
+        exchange.targets.push_back(request.target);
+
+        auto reader = httplib::make_body_reader(request, stream);
+
+        if (!reader) {
+            exchange.error = boost::system::errc::make_error_code(boost::system::errc::bad_message);
+            break;
+        }
+
+        std::string body;
+        std::array<char, 4> part;
+
+        // Small reads, so the body takes several of them.
+        while (true) {
+            auto [ec, transferred] = co_await reader->async_read_some(boost::asio::buffer(part), httplib::use_awaitable);
+            body.append(part.data(), transferred);
+
+            if (ec == httplib::reader_errc_t::eof) {
+                break;
+            } else if (ec) {
+                exchange.error = ec;
+                co_return;
+            }
+        }
+
+        exchange.bodies.push_back(body);
+
+        auto response = httplib::http_response_builder_t()
+            .content_length(body.size())
+            .build(httplib::STATUS_200_OK);
+
+        auto [write_ec, written] = co_await httplib::async_write_response(
+            socket,
+            response,
+            boost::asio::buffer(body),
+            httplib::use_awaitable
+        );
+
+        if (write_ec || written == 0) {
+            exchange.error = write_ec;
+            break;
+        }
+    }
+
+    exchange.finished = true;
+}
+
+} // namespace
+
+
+TEST_CASE("operations are awaited in a coroutine", "[use_awaitable]") {
+    boost::asio::io_service io_service;
+    socket_t client(io_service);
+    socket_t server(io_service);
+    boost::asio::local::connect_pair(client, server);
+
+    boost::asio::write(client, boost::asio::buffer(std::string(
+        "POST /plain HTTP/1.1\r\nHost: a\r\nContent-Length: 11\r\n\r\n"
+        "hello world"
+        "PUT /chunked HTTP/1.1\r\nHost: a\r\nTransfer-Encoding: chunked\r\n\r\n"
+        "6\r\nchunk \r\n"
+        "4\r\nbody\r\n"
+        "0\r\n\r\n"
+    )));
+
+    client.shutdown(socket_t::shutdown_send);
+
+    exchange_t exchange;
+    echo(server, exchange);
+
+    // The coroutine is suspended on the first read.
+    REQUIRE(!exchange.finished);
+
+    io_service.run();
+
+    REQUIRE(exchange.finished);
+    REQUIRE(exchange.error == boost::asio::error::eof);
+    REQUIRE(exchange.targets == (std::vector<std::string> {"/plain", "/chunked"}));
+    REQUIRE(exchange.bodies == (std::vector<std::string> {"hello world", "chunk body"}));
+
+    server.close();
+
+    boost::system::error_code ec;
+    std::string responses(1024, '\0');
+    responses.resize(boost::asio::read(client, boost::asio::buffer(&responses[0], responses.size()), ec));
+
+    REQUIRE(ec == boost::asio::error::eof);
+    REQUIRE(responses.find("HTTP/1.1 200 OK\r\n") == 0);
+    REQUIRE(responses.find("\r\n\r\nhello world") != std::string::npos);
+    REQUIRE(responses.find("\r\n\r\nchunk body") != std::string::npos);
+    REQUIRE(responses.find("\r\n\r\nhello world") < responses.find("\r\n\r\nchunk body"));
+}
+
+#endif // HTTPLIB_HAS_COROUTINES
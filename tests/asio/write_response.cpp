@@ -0,0 +1,197 @@
+#include <catch.hpp>
+
+#include <httplib/asio/write_response.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+
+#include <string>
+#include <vector>
+
+
+namespace {
+
+using socket_t = boost::asio::local::stream_protocol::socket;
+
+
+struct connection_t {
+    boost::asio::io_service io_service;
+    socket_t client{io_service};
+    socket_t server{io_service};
+
+    connection_t() {
+        boost::asio::local::connect_pair(client, server);
+    }
+
+    // Reads exactly size bytes the server has sent.
+    std::string receive(std::size_t size) {
+        std::string result(size, '\0');
+        boost::asio::read(client, boost::asio::buffer(&result[0], result.size()));
+        return result;
+    }
+};
+
+
+httplib::http_response_t make_response(unsigned int code, const std::string &reason) {
+    httplib::http_response_t response;
+    response.code = code;
+    response.reason = reason;
+    response.version = {1, 1};
+    return response;
+}
+
+} // namespace
+
+
+TEST_CASE("write response sends the head and the body", "[write_response]") {
+    connection_t connection;
+
+    auto response = make_response(200, "OK");
+    response.headers.add_header_values("Content-Type", {"text/plain"});
+    response.headers.add_header_values("Set-Cookie", {"a=1", "b=2"});
+    response.headers.add_header_values("Home", {"elsewhere"});
+
+    const std::string hello = "hello, ";
+    const std::string world = "world!";
+    const std::vector<boost::asio::const_buffer> body = {
+        boost::asio::buffer(hello),
+        boost::asio::buffer(world, 0),
+        boost::asio::buffer(world)
+    };
+
+    // The Home header goes first, the values of a header go on separate lines.
+    const std::string expected = "HTTP/1.1 200 OK\r\n"
+                                 "Home: elsewhere\r\n"
+                                 "Content-Type: text/plain\r\n"
+                                 "Set-Cookie: a=1\r\n"
+                                 "Set-Cookie: b=2\r\n"
+                                 "\r\n"
+                                 "hello, world!";
+
+    SECTION("synchronously") {
+        REQUIRE(httplib::write_response(connection.server, response, body) == expected.size());
+    }
+
+    SECTION("asynchronously") {
+        boost::system::error_code error;
+        std::size_t written = 0;
+
+        httplib::async_write_response(connection.server, response, body, [&](auto ec, std::size_t transferred) {
+            error = ec;
+            written = transferred;
+        });
+
+        connection.io_service.run();
+
+        REQUIRE(!error);
+        REQUIRE(written == expected.size());
+    }
+
+    REQUIRE(connection.receive(expected.size()) == expected);
+    REQUIRE(connection.client.available() == 0);
+}
+
+
+TEST_CASE("write response renders a non-standard status line", "[write_response]") {
+    connection_t connection;
+
+    SECTION("without headers") {
+        auto response = make_response(299, "Fine");
+        const std::string expected = "HTTP/1.1 299 Fine\r\n\r\n";
+
+        REQUIRE(httplib::write_response(connection.server, response) == expected.size());
+        REQUIRE(connection.receive(expected.size()) == expected);
+    }
+
+    SECTION("with a header") {
+        auto response = make_response(200, "Alright");
+        response.version = {1, 0};
+        response.headers.add_header_values("Content-Length", {"0"});
+        const std::string expected = "HTTP/1.0 200 Alright\r\nContent-Length: 0\r\n\r\n";
+
+        boost::system::error_code ec;
+
+        REQUIRE(httplib::write_response(connection.server, response, ec) == expected.size());
+        REQUIRE(!ec);
+        REQUIRE(connection.receive(expected.size()) == expected);
+    }
+}
+
+
+TEST_CASE("write response sends more buffers than a single writev() takes", "[write_response]") {
+    connection_t connection;
+
+    // Two buffers per header value, more than 64 in total.
+    auto response = make_response(200, "OK");
+    std::string expected = "HTTP/1.1 200 OK\r\n";
+
+    for (int i = 0; i < 40; ++i) {
+        auto name = "X-Header-" + std::to_string(i);
+        auto value = std::string(i, 'v');
+        response.headers.add_header_values(name, {value});
+        expected += name + ": " + value + "\r\n";
+    }
+
+    std::vector<std::string> parts;
+    std::vector<boost::asio::const_buffer> body;
+
+    for (int i = 0; i < 20; ++i) {
+        parts.push_back("part " + std::to_string(i) + ";");
+    }
+
+    expected += "\r\n";
+
+    for (const auto &part: parts) {
+        body.push_back(boost::asio::buffer(part));
+        expected += part;
+    }
+
+    SECTION("synchronously") {
+        REQUIRE(httplib::write_response(connection.server, response, body) == expected.size());
+    }
+
+    SECTION("asynchronously") {
+        std::size_t written = 0;
+
+        httplib::async_write_response(connection.server, response, body, [&](auto ec, std::size_t transferred) {
+            REQUIRE(!ec);
+            written = transferred;
+        });
+
+        connection.io_service.run();
+
+        REQUIRE(written == expected.size());
+    }
+
+    REQUIRE(connection.receive(expected.size()) == expected);
+}
+
+
+TEST_CASE("write response reports write errors", "[write_response]") {
+    connection_t connection;
+    connection.client.close();
+
+    auto response = make_response(200, "OK");
+
+    SECTION("synchronously") {
+        boost::system::error_code ec;
+        httplib::write_response(connection.server, response, ec);
+
+        REQUIRE(ec == boost::asio::error::broken_pipe);
+        REQUIRE_THROWS_AS(httplib::write_response(connection.server, response), boost::system::system_error);
+    }
+
+    SECTION("asynchronously") {
+        boost::system::error_code error;
+
+        httplib::async_write_response(connection.server, response, [&](auto ec, std::size_t) {
+            error = ec;
+        });
+
+        connection.io_service.run();
+
+        REQUIRE(error == boost::asio::error::broken_pipe);
+    }
+}
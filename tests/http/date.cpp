@@ -0,0 +1,56 @@
+#include <catch.hpp>
+
+#include <httplib/http/date.hpp>
+#include <httplib/response_builder.hpp>
+
+#include <chrono>
+#include <string>
+
+
+TEST_CASE("format http date", "[http_date]") {
+    char output[httplib::http_date_size];
+
+    httplib::format_http_date(784111777, output);
+    REQUIRE(std::string(output, sizeof(output)) == "Sun, 06 Nov 1994 08:49:37 GMT");
+
+    httplib::format_http_date(0, output);
+    REQUIRE(std::string(output, sizeof(output)) == "Thu, 01 Jan 1970 00:00:00 GMT");
+
+    httplib::format_http_date(951782400, output);
+    REQUIRE(std::string(output, sizeof(output)) == "Tue, 29 Feb 2000 00:00:00 GMT");
+}
+
+
+TEST_CASE("current http date", "[http_date]") {
+    auto before = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    auto date = httplib::current_http_date();
+    auto after = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+
+    REQUIRE(date.size() == httplib::http_date_size);
+
+    char expected_before[httplib::http_date_size];
+    char expected_after[httplib::http_date_size];
+
+    httplib::format_http_date(before, expected_before);
+    httplib::format_http_date(after, expected_after);
+
+    REQUIRE((date == boost::string_view(expected_before, sizeof(expected_before)) ||
+             date == boost::string_view(expected_after, sizeof(expected_after))));
+
+    // Within the same second the cached string is returned.
+    auto again = httplib::current_http_date();
+
+    if (again == date) {
+        REQUIRE(again.data() == date.data());
+    }
+}
+
+
+TEST_CASE("response builder adds date on demand", "[http_date]") {
+    auto without_date = httplib::http_response_builder_t().build(httplib::STATUS_200_OK);
+    REQUIRE(!without_date.headers.has("Date"));
+
+    auto with_date = httplib::http_response_builder_t().date().build(httplib::STATUS_200_OK);
+    REQUIRE(with_date.headers.get_header("Date"));
+    REQUIRE(with_date.headers.get_header("Date")->size() == httplib::http_date_size);
+}
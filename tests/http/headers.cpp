@@ -601,7 +601,7 @@ TEST_CASE("http_headers_t::remove_header() removes", "[http_headers_t]") {
 }
 
 
-TEST_CASE("headers' output operator", "[http_headers_t]") {
+TEST_CASE("headers' output operator keeps insertion order", "[http_headers_t]") {
     httplib::http_headers_t headers = {
         {"xxx", {"1", "2", "3"}},
         {"yyy", {"1", "2"}},
@@ -612,14 +612,14 @@ TEST_CASE("headers' output operator", "[http_headers_t]") {
     };
 
     std::string expected =
-        "kkk: 2\r\n"
-        "lll: 1\r\n"
         "xxx: 1\r\n"
         "xxx: 2\r\n"
         "xxx: 3\r\n"
         "xxx: 1\r\n"
         "yyy: 1\r\n"
-        "yyy: 2\r\n";
+        "yyy: 2\r\n"
+        "lll: 1\r\n"
+        "kkk: 2\r\n";
 
     REQUIRE(headers_to_string(headers) == expected);
 }
@@ -645,14 +645,14 @@ TEST_CASE("headers' output operator accepts empty headers", "[http_headers_t]")
     };
 
     std::string expected =
-        "kkk: 2\r\n"
-        "lll: \r\n"
         "xxx: 1\r\n"
         "xxx: 2\r\n"
         "xxx: 3\r\n"
         "xxx: 1\r\n"
         "yyy: 1\r\n"
-        "yyy: 2\r\n";
+        "yyy: 2\r\n"
+        "lll: \r\n"
+        "kkk: 2\r\n";
 
     REQUIRE(headers_to_string(headers) == expected);
 }
@@ -678,10 +678,69 @@ TEST_CASE("headers' output operator puts Home first", "[http_headers_t]") {
         "aaa: 2\r\n"
         "aaa: 3\r\n"
         "aaa: 1\r\n"
-        "kkk: 2\r\n"
-        "lll: \r\n"
         "yyy: 1\r\n"
-        "yyy: 2\r\n";
+        "yyy: 2\r\n"
+        "lll: \r\n"
+        "kkk: 2\r\n";
 
     REQUIRE(headers_to_string(headers) == expected);
 }
+
+
+TEST_CASE("http_headers_t with many headers", "[http_headers_t]") {
+    const std::size_t count = 3 * httplib::http_headers_t::index_threshold;
+
+    httplib::http_headers_t headers;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        headers.add_header_values("Header-" + std::to_string(i), {std::to_string(i)});
+    }
+
+    headers.add_header_values("HEADER-7", {"again"});
+
+    REQUIRE(headers.size() == count + 1);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        REQUIRE(headers.has("header-" + std::to_string(i)));
+    }
+
+    REQUIRE(!headers.has("header-" + std::to_string(count)));
+    REQUIRE(*headers.get_header_values("header-7") == httplib::http_headers_t::header_values_t({"7", "again"}));
+    REQUIRE(std::next(headers.begin(), 7) == headers.find("Header-7"));
+
+    for (std::size_t i = 0; i < count; i += 2) {
+        headers.remove_header("HEADER-" + std::to_string(i));
+    }
+
+    REQUIRE(headers.size() == count / 2 + 1);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        REQUIRE(headers.has("header-" + std::to_string(i)) == (i % 2 == 1));
+    }
+
+    REQUIRE(headers.begin()->first == "Header-1");
+    REQUIRE(std::prev(headers.end())->first == "Header-" + std::to_string(count - 1));
+}
+
+
+TEST_CASE("headers can be cleared", "[http_headers_t]") {
+    httplib::http_headers_t headers;
+
+    for (std::size_t i = 0; i < 2 * httplib::http_headers_t::index_threshold; ++i) {
+        headers.add_header_values("Header-" + std::to_string(i), {"value"});
+    }
+
+    headers.add_header_values("Content-Length", {"10"});
+    headers.clear();
+
+    REQUIRE(headers.empty());
+    REQUIRE(headers.begin() == headers.end());
+    REQUIRE(!headers.has("Header-1"));
+    REQUIRE(!headers.has(httplib::known_header_t::content_length));
+
+    headers.add_header_values("Header-1", {"again"});
+
+    REQUIRE(headers.size() == 1);
+    REQUIRE(*headers.get_header("header-1") == "again");
+    REQUIRE(!headers.has("Header-2"));
+}
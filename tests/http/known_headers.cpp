@@ -0,0 +1,64 @@
+#include <catch.hpp>
+
+#include <httplib/http/headers.hpp>
+#include <httplib/http/known_headers.hpp>
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+
+TEST_CASE("known headers are found by their names", "[known_header_t]") {
+    for (std::size_t i = 0; i < httplib::known_headers_count; ++i) {
+        auto header = static_cast<httplib::known_header_t>(i);
+        std::string name = httplib::known_header_name(header).to_string();
+
+        for (const auto &spelling: {name, boost::algorithm::to_lower_copy(name), boost::algorithm::to_upper_copy(name)}) {
+            auto found = httplib::find_known_header(spelling);
+
+            REQUIRE(found);
+            REQUIRE(*found == header);
+        }
+    }
+}
+
+
+TEST_CASE("unknown headers are not found", "[known_header_t]") {
+    REQUIRE(!httplib::find_known_header(""));
+    REQUIRE(!httplib::find_known_header("X"));
+    REQUIRE(!httplib::find_known_header("Content-Lengths"));
+    REQUIRE(!httplib::find_known_header("Content-Lenght"));
+    REQUIRE(!httplib::find_known_header("Xontent-Length"));
+    REQUIRE(!httplib::find_known_header("X-Custom-Header"));
+}
+
+
+TEST_CASE("http_headers_t looks up known headers", "[known_header_t]") {
+    httplib::http_headers_t headers = {
+        {"X-Something", {"1"}},
+        {"content-length", {"10"}},
+        {"Connection", {"keep-alive", "upgrade"}}
+    };
+
+    REQUIRE(headers.has(httplib::known_header_t::content_length));
+    REQUIRE(!headers.has(httplib::known_header_t::transfer_encoding));
+    REQUIRE(headers.find(httplib::known_header_t::content_length) == headers.find("Content-Length"));
+    REQUIRE(*headers.get_header(httplib::known_header_t::content_length) == "10");
+    REQUIRE(!headers.get_header(httplib::known_header_t::connection));
+    REQUIRE(headers.get_header_values(httplib::known_header_t::connection)->size() == 2);
+
+    headers.remove_header("X-SOMETHING");
+
+    REQUIRE(headers.find(httplib::known_header_t::content_length) == headers.begin());
+    REQUIRE(*headers.get_header(httplib::known_header_t::content_length) == "10");
+
+    headers.set_header(httplib::known_header_t::content_length, {"20"});
+    headers.add_header_values(httplib::known_header_t::transfer_encoding, {"chunked"});
+
+    REQUIRE(headers.size() == 4);
+    REQUIRE(*headers.get_header("CONTENT-LENGTH") == "20");
+    REQUIRE(std::prev(headers.end())->first == "Transfer-Encoding");
+
+    headers.remove_header(httplib::known_header_t::connection);
+
+    REQUIRE(!headers.has("Connection"));
+    REQUIRE(*headers.get_header(httplib::known_header_t::transfer_encoding) == "chunked");
+}
@@ -0,0 +1,168 @@
+#include <catch.hpp>
+
+#include <httplib/asio/serialize_head.hpp>
+#include <httplib/http/serialize.hpp>
+#include <httplib/parser/chunked_body_parser.hpp>
+
+#include <boost/asio/buffers_iterator.hpp>
+#include <boost/asio/streambuf.hpp>
+
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+
+
+namespace {
+
+const httplib::http_response_t response {
+    200,
+    "OK",
+    {1, 1},
+    {
+        {"Content-Length", {"10"}},
+        {"Home", {"x"}},
+        {"xxx", {"yyy", "zzz"}}
+    }
+};
+
+const httplib::http_request_t request {
+    "GET",
+    "/path?query",
+    {10, 0},
+    {
+        {"Host", {"localhost"}},
+        {"Accept", {"*/*"}}
+    }
+};
+
+template<class Message>
+std::string to_string(const Message &message) {
+    std::ostringstream stream;
+    stream << message;
+    return stream.str();
+}
+
+} // namespace
+
+
+TEST_CASE("response head serialization matches the output operator", "[serialize_head]") {
+    const std::string expected = to_string(response);
+
+    REQUIRE(httplib::serialized_size(response) == expected.size());
+
+    std::string output(expected.size(), '\0');
+    REQUIRE(httplib::serialize_head(response, &output[0]) == output.data() + output.size());
+    REQUIRE(output == expected);
+
+    output = "prefix";
+    httplib::serialize_head(response, output);
+    REQUIRE(output == "prefix" + expected);
+}
+
+
+TEST_CASE("request head serialization matches the output operator", "[serialize_head]") {
+    const std::string expected = to_string(request);
+
+    REQUIRE(expected == "GET /path?query HTTP/10.0\r\nHost: localhost\r\nAccept: */*\r\n\r\n");
+    REQUIRE(httplib::serialized_size(request) == expected.size());
+
+    std::string output;
+    httplib::serialize_head(request, output);
+    REQUIRE(output == expected);
+}
+
+
+TEST_CASE("empty response head serialization", "[serialize_head]") {
+    const httplib::http_response_t empty;
+
+    std::string output;
+    httplib::serialize_head(empty, output);
+    REQUIRE(output == "HTTP/0.0 0 \r\n\r\n");
+    REQUIRE(output == to_string(empty));
+}
+
+
+TEST_CASE("head serialization into a streambuf", "[serialize_head]") {
+    boost::asio::streambuf buffer;
+    httplib::serialize_head(response, buffer);
+    httplib::serialize_head(request, buffer);
+
+    std::string output(boost::asio::buffers_begin(buffer.data()), boost::asio::buffers_end(buffer.data()));
+    REQUIRE(output == to_string(response) + to_string(request));
+}
+
+
+TEST_CASE("chunk size line serialization", "[serialize_chunk]") {
+    const std::pair<std::size_t, std::string> cases[] = {
+        {0, "0\r\n"},
+        {1, "1\r\n"},
+        {0xf, "f\r\n"},
+        {0x10, "10\r\n"},
+        {0xff, "ff\r\n"},
+        {0x100, "100\r\n"},
+        {0x1f40, "1f40\r\n"},
+        {0xabcdef, "abcdef\r\n"},
+        {0x10000000, "10000000\r\n"}
+    };
+
+    for (const auto &test: cases) {
+        char buffer[httplib::max_chunk_size_line_size];
+        char *end = httplib::serialize_chunk_size_line(test.first, buffer);
+
+        REQUIRE(std::string(buffer, end) == test.second);
+    }
+
+    char buffer[httplib::max_chunk_size_line_size];
+    char *end = httplib::serialize_chunk_size_line(std::numeric_limits<std::size_t>::max(), buffer);
+
+    REQUIRE(std::string(buffer, end) == std::string(2 * sizeof(std::size_t), 'f') + "\r\n");
+}
+
+
+TEST_CASE("chunked body serialization is parsed back", "[serialize_chunk]") {
+    const std::string chunks[] = {"hello", std::string(300, 'x'), "!"};
+
+    std::string body;
+
+    for (const auto &chunk: chunks) {
+        char line[httplib::max_chunk_size_line_size];
+        body.append(line, httplib::serialize_chunk_size_line(chunk.size(), line));
+        body.append(chunk);
+        body.append("\r\n");
+    }
+
+    httplib::serialize_last_chunk({{"X-Checksum", {"abc"}}}, body);
+
+    const std::string last_chunk = "0\r\nX-Checksum: abc\r\n\r\n";
+    REQUIRE(body.substr(body.size() - last_chunk.size()) == last_chunk);
+
+    httplib::chunked_body_parser_t parser;
+    std::string decoded;
+    std::size_t offset = 0;
+
+    while (!parser.done() && offset < body.size()) {
+        auto result = parser.parse(body.data() + offset, body.size() - offset);
+        offset += result.parsed;
+
+        REQUIRE(!boost::get<httplib::chunked_body_parser_t::error_t>(&result.action));
+
+        if (auto data = boost::get<httplib::chunked_body_parser_t::data_t>(&result.action)) {
+            decoded.append(data->data, data->size);
+        }
+    }
+
+    REQUIRE(parser.done());
+    REQUIRE(offset == body.size());
+    REQUIRE(decoded == chunks[0] + chunks[1] + chunks[2]);
+    REQUIRE(parser.headers().get_header("X-Checksum"));
+    REQUIRE(*parser.headers().get_header("X-Checksum") == "abc");
+}
+
+
+TEST_CASE("last chunk without trailers", "[serialize_chunk]") {
+    std::string output = "x";
+    httplib::serialize_last_chunk({}, output);
+
+    REQUIRE(output == "x0\r\n\r\n");
+}
@@ -2,6 +2,9 @@
 
 #include <httplib/http/status_code.hpp>
 
+#include <string>
+#include <type_traits>
+
 
 TEST_CASE("status_code constructor", "[status_code_t]") {
     const httplib::status_code_t status(123, "ololo lo lo");
@@ -11,6 +14,30 @@ TEST_CASE("status_code constructor", "[status_code_t]") {
 }
 
 
+TEST_CASE("status_code takes the length of a literal without the terminating zero", "[status_code_t]") {
+    constexpr httplib::status_code_t status(200, "OK");
+
+    static_assert(status.description().size() == 2, "the terminating zero must not be a part of the description");
+
+    REQUIRE(status.description().size() == 2);
+    REQUIRE(httplib::STATUS_404_NOT_FOUND.description().size() == 9);
+}
+
+
+TEST_CASE("status_code doesn't keep a view of a temporary string", "[status_code_t]") {
+    static_assert(!std::is_constructible<httplib::status_code_t, unsigned int, std::string>::value,
+                  "a temporary string must be rejected");
+    static_assert(!std::is_constructible<httplib::status_code_t, unsigned int, std::string &&>::value,
+                  "a temporary string must be rejected");
+
+    const std::string description = "Fine";
+    const httplib::status_code_t status(200, boost::string_view(description));
+
+    REQUIRE(status.description().data() == description.data());
+    REQUIRE(status.description() == "Fine");
+}
+
+
 TEST_CASE("status_code is copyable", "[status_code_t]") {
     const httplib::status_code_t status1(123, "ololo lo lo");
     const httplib::status_code_t status2 = status1;
@@ -39,3 +66,35 @@ TEST_CASE("status_code is assignable", "[status_code_t]") {
     REQUIRE(status2.code() == 456);
     REQUIRE(status2.description() == "qwerty asdf");
 }
+
+
+TEST_CASE("status_code is a literal type", "[status_code_t]") {
+    constexpr httplib::status_code_t status(123, "ololo lo lo");
+
+    static_assert(status.code() == 123, "status code must be usable in constant expressions");
+    static_assert(httplib::STATUS_404_NOT_FOUND.code() == 404, "status code must be usable in constant expressions");
+
+    REQUIRE(status.description() == "ololo lo lo");
+    REQUIRE(httplib::STATUS_404_NOT_FOUND.description() == "Not Found");
+}
+
+
+TEST_CASE("pre-rendered status lines", "[status_code_t]") {
+    auto line = httplib::find_status_line(200, "OK", {1, 1});
+    REQUIRE(line);
+    REQUIRE(*line == "HTTP/1.1 200 OK\r\n");
+
+    line = httplib::find_status_line(
+        httplib::STATUS_505_HTTP_VERSION_NOT_SUPPORTED.code(),
+        httplib::STATUS_505_HTTP_VERSION_NOT_SUPPORTED.description(),
+        {1, 0}
+    );
+
+    REQUIRE(line);
+    REQUIRE(*line == "HTTP/1.0 505 HTTP Version Not Supported\r\n");
+
+    REQUIRE(!httplib::find_status_line(200, "Fine", {1, 1}));
+    REQUIRE(!httplib::find_status_line(299, "OK", {1, 1}));
+    REQUIRE(!httplib::find_status_line(200, "OK", {2, 0}));
+    REQUIRE(!httplib::find_status_line(200, "OK", {1, 2}));
+}
@@ -0,0 +1,117 @@
+#include <catch.hpp>
+
+#include <httplib/error.hpp>
+#include <httplib/parser/request_view_parser.hpp>
+
+#include <string>
+
+
+namespace {
+
+const std::string request_head =
+    "GET /path?query HTTP/1.1\r\n"
+    "Host: localhost\r\n"
+    "Accept: */*  \r\n"
+    "X-Multi: 1\r\n"
+    "x-multi: 2\r\n"
+    "\r\n";
+
+
+bool points_into(boost::string_view view, const std::string &data) {
+    return view.data() >= data.data() && view.data() + view.size() <= data.data() + data.size();
+}
+
+
+void validate_request(const httplib::http_request_view_t &request) {
+    REQUIRE(request.method == "GET");
+    REQUIRE(request.target == "/path?query");
+    REQUIRE(request.version == httplib::http_version_t(1, 1));
+    REQUIRE(request.headers.size() == 4);
+    REQUIRE(request.headers.get_header("host"));
+    REQUIRE(*request.headers.get_header("host") == "localhost");
+    REQUIRE(request.headers.get_header("Accept"));
+    REQUIRE(*request.headers.get_header("Accept") == "*/*");
+    REQUIRE(request.headers.has("X-MULTI"));
+    REQUIRE(!request.headers.get_header("X-Multi"));
+    REQUIRE(!request.headers.has("Content-Length"));
+}
+
+} // namespace
+
+
+TEST_CASE("view parser doesn't copy a head passed at once", "[http_request_view_parser_t]") {
+    std::string data = request_head + "body";
+
+    httplib::http_request_view_parser_t parser;
+
+    REQUIRE(parser.parse(data.data(), data.size()) == request_head.size());
+    REQUIRE(parser.done());
+    REQUIRE(!parser.error());
+
+    const auto &request = parser.request();
+
+    validate_request(request);
+
+    REQUIRE(points_into(request.method, data));
+    REQUIRE(points_into(request.target, data));
+
+    for (const auto &header: request.headers) {
+        REQUIRE(points_into(header.name, data));
+        REQUIRE(points_into(header.value, data));
+    }
+}
+
+
+TEST_CASE("view parser copies a head split into parts", "[http_request_view_parser_t]") {
+    for (std::size_t part_size = 1; part_size < request_head.size(); ++part_size) {
+        httplib::http_request_view_parser_t parser;
+
+        std::string part;
+        std::size_t offset = 0;
+
+        while (offset < request_head.size() && !parser.done()) {
+            // Overwrite the previous part the way a read buffer would.
+            part.assign(part.size(), 'x');
+            part = request_head.substr(offset, part_size);
+            offset += parser.parse(part.data(), part.size());
+        }
+
+        REQUIRE(parser.done());
+        REQUIRE(!parser.error());
+        REQUIRE(offset == request_head.size());
+
+        validate_request(parser.request());
+    }
+}
+
+
+TEST_CASE("view parser converts to request", "[http_request_view_parser_t]") {
+    httplib::http_request_view_parser_t parser;
+    parser.parse(request_head.data(), request_head.size());
+
+    REQUIRE(parser.done());
+
+    auto request = httplib::to_request(parser.request());
+
+    REQUIRE(request.method == "GET");
+    REQUIRE(request.target == "/path?query");
+    REQUIRE(request.version == httplib::http_version_t(1, 1));
+    REQUIRE(request.headers.size() == 4);
+    REQUIRE(request.headers.get_header("Host"));
+    REQUIRE(*request.headers.get_header("Host") == "localhost");
+    REQUIRE(request.headers.get_header_values("x-multi"));
+    REQUIRE(*request.headers.get_header_values("x-multi") == httplib::http_headers_t::header_values_t({"1", "2"}));
+}
+
+
+TEST_CASE("view parser respects limits", "[http_request_view_parser_t]") {
+    httplib::http_parsing_options_t options;
+    options.max_headers_number = 2;
+
+    httplib::http_request_view_parser_t parser;
+    parser.set_options(options);
+    parser.parse(request_head.data(), request_head.size());
+
+    REQUIRE(parser.done());
+    REQUIRE(parser.error() == httplib::parser_errc_t::too_many_headers);
+}
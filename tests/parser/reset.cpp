@@ -0,0 +1,107 @@
+#include <catch.hpp>
+
+#include <httplib/parser/chunked_body_parser.hpp>
+#include <httplib/parser/request_parser.hpp>
+#include <httplib/parser/request_view_parser.hpp>
+#include <httplib/parser/response_parser.hpp>
+
+#include <string>
+
+
+TEST_CASE("request parser can be reused after reset", "[parser_reset]") {
+    const std::string first = "POST /first HTTP/1.0\r\nHost: a\r\nX-First: 1\r\n\r\n";
+    const std::string second = "GET /second HTTP/1.1\r\nHost: b\r\n\r\n";
+
+    httplib::http_request_parser_t parser;
+
+    REQUIRE(parser.parse(first.data(), first.size()) == first.size());
+    REQUIRE(parser.done());
+    REQUIRE(parser.request().headers.size() == 2);
+
+    REQUIRE(parser.parse(second.data(), second.size()) == 0);
+    REQUIRE(parser.error());
+
+    parser.reset();
+
+    REQUIRE(!parser.done());
+    REQUIRE(!parser.error());
+
+    REQUIRE(parser.parse(second.data(), second.size()) == second.size());
+    REQUIRE(parser.done());
+    REQUIRE(!parser.error());
+    REQUIRE(parser.request().method == "GET");
+    REQUIRE(parser.request().target == "/second");
+    REQUIRE(parser.request().version == httplib::http_version_t(1, 1));
+    REQUIRE(parser.request().headers.size() == 1);
+    REQUIRE(*parser.request().headers.get_header("Host") == "b");
+}
+
+
+TEST_CASE("request view parser can be reused after reset", "[parser_reset]") {
+    const std::string first = "POST /first HTTP/1.0\r\nHost: a\r\nX-First: 1\r\n\r\n";
+    const std::string second = "GET /second HTTP/1.1\r\nHost: b\r\n\r\n";
+
+    httplib::http_request_view_parser_t parser;
+
+    // Split the first request to fill the parser's own storage.
+    REQUIRE(parser.parse(first.data(), 10) == 10);
+    REQUIRE(parser.parse(first.data() + 10, first.size() - 10) == first.size() - 10);
+    REQUIRE(parser.done());
+
+    parser.reset();
+
+    REQUIRE(parser.parse(second.data(), second.size()) == second.size());
+    REQUIRE(parser.done());
+    REQUIRE(!parser.error());
+    REQUIRE(parser.request().target == "/second");
+    REQUIRE(parser.request().headers.size() == 1);
+    REQUIRE(*parser.request().headers.get_header("Host") == "b");
+}
+
+
+TEST_CASE("response parser can be reused after reset", "[parser_reset]") {
+    const std::string first = "HTTP/1.1 404 Not Found\r\nX-First: 1\r\n\r\n";
+    const std::string second = "HTTP/1.0 200 OK\r\n\r\n";
+
+    httplib::http_response_parser_t parser;
+
+    REQUIRE(parser.parse(first.data(), first.size()) == first.size());
+    REQUIRE(parser.done());
+
+    parser.reset();
+
+    REQUIRE(parser.parse(second.data(), second.size()) == second.size());
+    REQUIRE(parser.done());
+    REQUIRE(!parser.error());
+    REQUIRE(parser.response().code == 200);
+    REQUIRE(parser.response().reason == "OK");
+    REQUIRE(parser.response().version == httplib::http_version_t(1, 0));
+    REQUIRE(parser.response().headers.empty());
+}
+
+
+TEST_CASE("chunked body parser can be reused after reset", "[parser_reset]") {
+    const std::string first = "3\r\nabc\r\n0\r\nX-Trailer: 1\r\n\r\n";
+    const std::string second = "0\r\n\r\n";
+
+    httplib::chunked_body_parser_t parser;
+
+    std::size_t offset = 0;
+
+    while (!parser.done()) {
+        offset += parser.parse(first.data() + offset, first.size() - offset).parsed;
+    }
+
+    REQUIRE(offset == first.size());
+    REQUIRE(parser.headers().size() == 1);
+
+    parser.reset();
+
+    REQUIRE(!parser.done());
+
+    auto result = parser.parse(second.data(), second.size());
+
+    REQUIRE(result.parsed == second.size());
+    REQUIRE(parser.done());
+    REQUIRE(parser.headers().empty());
+}
@@ -0,0 +1,92 @@
+#include <catch.hpp>
+
+#include <httplib/parser/detail/utility.hpp>
+
+#include <cstring>
+#include <string>
+
+
+namespace {
+
+bool reference_tchar(unsigned char ch) {
+    return (ch >= '0' && ch <= '9') ||
+           (ch >= 'a' && ch <= 'z') ||
+           (ch >= 'A' && ch <= 'Z') ||
+           (ch != 0 && std::strchr("!#$%&'*+-.^_`|~", ch) != nullptr);
+}
+
+bool reference_qdtext(unsigned char ch) {
+    return ch == '\t' || ch == ' ' || ch == 0x21 || (ch >= 0x23 && ch <= 0x5b) || (ch >= 0x5d && ch <= 0x7e) || ch >= 0x80;
+}
+
+} // namespace
+
+
+TEST_CASE("character classes", "[parser_utility]") {
+    for (unsigned int i = 0; i < 256; ++i) {
+        char ch = static_cast<char>(i);
+
+        REQUIRE(httplib::detail::is_tchar(ch) == reference_tchar(i));
+        REQUIRE(httplib::detail::is_qdtext(ch) == reference_qdtext(i));
+        REQUIRE(httplib::detail::is_quoted_pair_char(ch) == (i == '\t' || i == ' ' || (i >= 0x21 && i <= 0x7e) || i >= 0x80));
+        REQUIRE(httplib::detail::is_whitespace(ch) == (i == '\t' || i == ' '));
+        REQUIRE(httplib::detail::is_alpha(ch) == ((i >= 'a' && i <= 'z') || (i >= 'A' && i <= 'Z')));
+        REQUIRE(httplib::detail::is_digit(ch) == (i >= '0' && i <= '9'));
+    }
+}
+
+
+TEST_CASE("scanning stops at the first character outside the class", "[parser_utility]") {
+    // Long enough for the vectorized paths and their scalar tails.
+    const std::string tchars(70, 'a');
+    const std::string qdtext(70, ' ');
+
+    REQUIRE(httplib::detail::count_tchars(tchars) == tchars.size());
+    REQUIRE(httplib::detail::count_qdtext(qdtext) == qdtext.size());
+
+    for (unsigned int i = 0; i < 256; ++i) {
+        char ch = static_cast<char>(i);
+
+        for (std::size_t position = 0; position < tchars.size(); position += 7) {
+            std::string data = tchars;
+            data[position] = ch;
+
+            std::size_t expected = reference_tchar(i) ? data.size() : position;
+            REQUIRE(httplib::detail::count_tchars(data) == expected);
+
+            data = qdtext;
+            data[position] = ch;
+
+            expected = reference_qdtext(i) ? data.size() : position;
+            REQUIRE(httplib::detail::count_qdtext(data) == expected);
+        }
+    }
+}
+
+
+TEST_CASE("parse tokens and quoted strings", "[parser_utility]") {
+    boost::string_view data = "keep-alive, close";
+
+    auto token = httplib::detail::parse_token(data);
+    REQUIRE(token);
+    REQUIRE(*token == "keep-alive");
+    REQUIRE(data == ", close");
+
+    REQUIRE(!httplib::detail::parse_token(data));
+
+    data = "\"a \\\"quoted\\\" string with a long enough text\";rest";
+
+    auto quoted = httplib::detail::parse_quoted_string(data);
+    REQUIRE(quoted);
+    REQUIRE(*quoted == "a \"quoted\" string with a long enough text");
+    REQUIRE(data == ";rest");
+
+    data = "\"unterminated";
+    REQUIRE(!httplib::detail::parse_quoted_string(data));
+
+    data = "\"backslash at the end\\";
+    REQUIRE(!httplib::detail::parse_quoted_string(data));
+
+    data = "\"bad\x7f\"";
+    REQUIRE(!httplib::detail::parse_quoted_string(data));
+}